@@ -0,0 +1,606 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "context/BatchExpression.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+
+namespace nebula {
+namespace graph {
+
+Value BatchVector::value(size_t i) const {
+    auto idx = constant ? 0 : i;
+    switch (kind) {
+        case Column::Kind::kBool:
+            return Value(static_cast<bool>(bools[idx]));
+        case Column::Kind::kInt:
+            return Value(ints[idx]);
+        case Column::Kind::kFloat:
+            return Value(floats[idx]);
+        case Column::Kind::kString:
+            return Value(strs[idx].str());
+        case Column::Kind::kNull:
+        case Column::Kind::kValue:
+            break;
+    }
+    DLOG(FATAL) << "No typed result of kind " << kind;
+    return Value::kNullValue;
+}
+
+class BatchExprNode {
+public:
+    virtual ~BatchExprNode() = default;
+
+    virtual void eval(const ColumnBatch& batch, BatchVector* out) const = 0;
+};
+
+namespace {
+
+void fallbackAll(size_t numRows, BatchVector* out) {
+    out->kind = Column::Kind::kNull;
+    out->constant = false;
+    out->fallback.clear();
+    out->fallback.resize(numRows, true);
+}
+
+// The fallback rows of the result are the union of the ones of the operands
+void mergeFallback(const BatchVector& lhs,
+                   const BatchVector& rhs,
+                   size_t numRows,
+                   BatchVector* out) {
+    out->constant = false;
+    if (!lhs.constant && !rhs.constant) {
+        out->fallback = lhs.fallback | rhs.fallback;
+    } else if (!lhs.constant) {
+        out->fallback = lhs.fallback;
+    } else if (!rhs.constant) {
+        out->fallback = rhs.fallback;
+    } else {
+        out->fallback.clear();
+        out->fallback.resize(numRows, false);
+    }
+}
+
+// Run `op(i, l, r)' for each row, hoisting the constant operand out of the loop
+template <typename L, typename R, typename Op>
+void binaryLoop(const BatchVector& lv,
+                const std::vector<L>& l,
+                const BatchVector& rv,
+                const std::vector<R>& r,
+                size_t numRows,
+                Op op) {
+    if (lv.constant) {
+        const L a = l[0];
+        for (size_t i = 0; i < numRows; ++i) {
+            op(i, a, r[i]);
+        }
+    } else if (rv.constant) {
+        const R b = r[0];
+        for (size_t i = 0; i < numRows; ++i) {
+            op(i, l[i], b);
+        }
+    } else {
+        for (size_t i = 0; i < numRows; ++i) {
+            op(i, l[i], r[i]);
+        }
+    }
+}
+
+template <typename L, typename R>
+void compare(Expression::Kind kind,
+             const BatchVector& lv,
+             const std::vector<L>& l,
+             const BatchVector& rv,
+             const std::vector<R>& r,
+             size_t numRows,
+             uint8_t* res) {
+    switch (kind) {
+        case Expression::Kind::kRelEQ:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) { res[i] = a == b; });
+            break;
+        case Expression::Kind::kRelNE:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) { res[i] = a != b; });
+            break;
+        case Expression::Kind::kRelLT:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) { res[i] = a < b; });
+            break;
+        case Expression::Kind::kRelLE:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) { res[i] = a <= b; });
+            break;
+        case Expression::Kind::kRelGT:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) { res[i] = a > b; });
+            break;
+        case Expression::Kind::kRelGE:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) { res[i] = a >= b; });
+            break;
+        default:
+            LOG(FATAL) << "Unsupported relational kind " << static_cast<int>(kind);
+    }
+}
+
+// Compare numbers as double, only for the operators that have no
+// epsilon semantics in `Value', the others are left to the row-based path.
+template <typename L, typename R>
+bool compareAsDouble(Expression::Kind kind,
+                     const BatchVector& lv,
+                     const std::vector<L>& l,
+                     const BatchVector& rv,
+                     const std::vector<R>& r,
+                     size_t numRows,
+                     uint8_t* res) {
+    switch (kind) {
+        case Expression::Kind::kRelLT:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) {
+                res[i] = static_cast<double>(a) < static_cast<double>(b);
+            });
+            return true;
+        case Expression::Kind::kRelGT:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) {
+                res[i] = static_cast<double>(a) > static_cast<double>(b);
+            });
+            return true;
+        default:
+            return false;
+    }
+}
+
+template <typename L, typename R>
+void arithmeticAsDouble(Expression::Kind kind,
+                        const BatchVector& lv,
+                        const std::vector<L>& l,
+                        const BatchVector& rv,
+                        const std::vector<R>& r,
+                        size_t numRows,
+                        BatchVector* out) {
+    out->kind = Column::Kind::kFloat;
+    out->floats.resize(numRows);
+    auto* res = out->floats.data();
+    switch (kind) {
+        case Expression::Kind::kAdd:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) {
+                res[i] = static_cast<double>(a) + static_cast<double>(b);
+            });
+            break;
+        case Expression::Kind::kMinus:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) {
+                res[i] = static_cast<double>(a) - static_cast<double>(b);
+            });
+            break;
+        case Expression::Kind::kMultiply:
+            binaryLoop(lv, l, rv, r, numRows, [res](size_t i, L a, R b) {
+                res[i] = static_cast<double>(a) * static_cast<double>(b);
+            });
+            break;
+        default:
+            LOG(FATAL) << "Unsupported arithmetic kind " << static_cast<int>(kind);
+    }
+    // Leave inf/nan to the row-based path
+    for (size_t i = 0; i < numRows; ++i) {
+        if (UNLIKELY(!std::isfinite(res[i]))) {
+            out->fallback[i] = true;
+        }
+    }
+}
+
+void arithmeticOfInt(Expression::Kind kind,
+                     const BatchVector& lv,
+                     const BatchVector& rv,
+                     size_t numRows,
+                     BatchVector* out) {
+    out->kind = Column::Kind::kInt;
+    out->ints.resize(numRows);
+    auto* res = out->ints.data();
+    // Collect the overflowed rows apart to keep the loops free of bitset writes
+    std::vector<uint8_t> overflow(numRows, 0);
+    auto* of = overflow.data();
+    switch (kind) {
+        case Expression::Kind::kAdd:
+            binaryLoop(lv, lv.ints, rv, rv.ints, numRows,
+                       [res, of](size_t i, int64_t a, int64_t b) {
+                of[i] = __builtin_add_overflow(a, b, &res[i]);
+            });
+            break;
+        case Expression::Kind::kMinus:
+            binaryLoop(lv, lv.ints, rv, rv.ints, numRows,
+                       [res, of](size_t i, int64_t a, int64_t b) {
+                of[i] = __builtin_sub_overflow(a, b, &res[i]);
+            });
+            break;
+        case Expression::Kind::kMultiply:
+            binaryLoop(lv, lv.ints, rv, rv.ints, numRows,
+                       [res, of](size_t i, int64_t a, int64_t b) {
+                of[i] = __builtin_mul_overflow(a, b, &res[i]);
+            });
+            break;
+        default:
+            LOG(FATAL) << "Unsupported arithmetic kind " << static_cast<int>(kind);
+    }
+    for (size_t i = 0; i < numRows; ++i) {
+        if (UNLIKELY(of[i])) {
+            out->fallback[i] = true;
+        }
+    }
+}
+
+class ColumnNode final : public BatchExprNode {
+public:
+    explicit ColumnNode(size_t pos) : pos_(pos) {}
+
+    void eval(const ColumnBatch& batch, BatchVector* out) const override {
+        const auto& col = batch.column(pos_);
+        switch (col.kind()) {
+            case Column::Kind::kBool:
+                out->bools = col.bools();
+                break;
+            case Column::Kind::kInt:
+                out->ints = col.ints();
+                break;
+            case Column::Kind::kFloat:
+                out->floats = col.floats();
+                break;
+            case Column::Kind::kString:
+                out->strs = col.strs();
+                break;
+            case Column::Kind::kNull:
+            case Column::Kind::kValue:
+                fallbackAll(batch.numRows(), out);
+                return;
+        }
+        out->kind = col.kind();
+        out->constant = false;
+        out->fallback = col.nulls();
+    }
+
+private:
+    size_t pos_;
+};
+
+class ConstantNode final : public BatchExprNode {
+public:
+    explicit ConstantNode(const Value& val) : val_(val) {}
+
+    void eval(const ColumnBatch&, BatchVector* out) const override {
+        out->constant = true;
+        switch (val_.type()) {
+            case Value::Type::BOOL:
+                out->kind = Column::Kind::kBool;
+                out->bools.assign(1, val_.getBool());
+                break;
+            case Value::Type::INT:
+                out->kind = Column::Kind::kInt;
+                out->ints.assign(1, val_.getInt());
+                break;
+            case Value::Type::FLOAT:
+                out->kind = Column::Kind::kFloat;
+                out->floats.assign(1, val_.getFloat());
+                break;
+            case Value::Type::STRING: {
+                // Reference the string owned by this node
+                const auto& str = val_.getStr();
+                out->kind = Column::Kind::kString;
+                out->strs.assign(1, folly::StringPiece(str.data(), str.size()));
+                break;
+            }
+            default:
+                LOG(FATAL) << "Unsupported constant type " << val_.type();
+        }
+    }
+
+    static bool supported(const Value& val) {
+        return val.isBool() || val.isInt() || val.isFloat() || val.isStr();
+    }
+
+private:
+    Value val_;
+};
+
+class RelationalNode final : public BatchExprNode {
+public:
+    RelationalNode(Expression::Kind kind,
+                   std::unique_ptr<BatchExprNode> lhs,
+                   std::unique_ptr<BatchExprNode> rhs)
+        : kind_(kind), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    void eval(const ColumnBatch& batch, BatchVector* out) const override {
+        auto numRows = batch.numRows();
+        BatchVector lv, rv;
+        lhs_->eval(batch, &lv);
+        rhs_->eval(batch, &rv);
+        mergeFallback(lv, rv, numRows, out);
+        out->kind = Column::Kind::kBool;
+        out->bools.resize(numRows);
+        auto* res = out->bools.data();
+
+        using K = Column::Kind;
+        auto lk = lv.kind, rk = rv.kind;
+        bool done = true;
+        if (lk == K::kInt && rk == K::kInt) {
+            compare(kind_, lv, lv.ints, rv, rv.ints, numRows, res);
+        } else if (lk == K::kString && rk == K::kString) {
+            compare(kind_, lv, lv.strs, rv, rv.strs, numRows, res);
+        } else if (lk == K::kBool && rk == K::kBool &&
+                   (kind_ == Expression::Kind::kRelEQ || kind_ == Expression::Kind::kRelNE)) {
+            compare(kind_, lv, lv.bools, rv, rv.bools, numRows, res);
+        } else if (lk == K::kFloat && rk == K::kFloat) {
+            done = compareAsDouble(kind_, lv, lv.floats, rv, rv.floats, numRows, res);
+        } else if (lk == K::kInt && rk == K::kFloat) {
+            done = compareAsDouble(kind_, lv, lv.ints, rv, rv.floats, numRows, res);
+        } else if (lk == K::kFloat && rk == K::kInt) {
+            done = compareAsDouble(kind_, lv, lv.floats, rv, rv.ints, numRows, res);
+        } else {
+            done = false;
+        }
+        if (!done) {
+            fallbackAll(numRows, out);
+        }
+    }
+
+private:
+    Expression::Kind                    kind_;
+    std::unique_ptr<BatchExprNode>      lhs_;
+    std::unique_ptr<BatchExprNode>      rhs_;
+};
+
+class ArithmeticNode final : public BatchExprNode {
+public:
+    ArithmeticNode(Expression::Kind kind,
+                   std::unique_ptr<BatchExprNode> lhs,
+                   std::unique_ptr<BatchExprNode> rhs)
+        : kind_(kind), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    void eval(const ColumnBatch& batch, BatchVector* out) const override {
+        auto numRows = batch.numRows();
+        BatchVector lv, rv;
+        lhs_->eval(batch, &lv);
+        rhs_->eval(batch, &rv);
+        mergeFallback(lv, rv, numRows, out);
+
+        using K = Column::Kind;
+        auto lk = lv.kind, rk = rv.kind;
+        if (lk == K::kInt && rk == K::kInt) {
+            arithmeticOfInt(kind_, lv, rv, numRows, out);
+        } else if (lk == K::kFloat && rk == K::kFloat) {
+            arithmeticAsDouble(kind_, lv, lv.floats, rv, rv.floats, numRows, out);
+        } else if (lk == K::kInt && rk == K::kFloat) {
+            arithmeticAsDouble(kind_, lv, lv.ints, rv, rv.floats, numRows, out);
+        } else if (lk == K::kFloat && rk == K::kInt) {
+            arithmeticAsDouble(kind_, lv, lv.floats, rv, rv.ints, numRows, out);
+        } else {
+            fallbackAll(numRows, out);
+        }
+    }
+
+private:
+    Expression::Kind                    kind_;
+    std::unique_ptr<BatchExprNode>      lhs_;
+    std::unique_ptr<BatchExprNode>      rhs_;
+};
+
+class LogicalNode final : public BatchExprNode {
+public:
+    LogicalNode(Expression::Kind kind, std::vector<std::unique_ptr<BatchExprNode>> operands)
+        : kind_(kind), operands_(std::move(operands)) {}
+
+    void eval(const ColumnBatch& batch, BatchVector* out) const override {
+        auto numRows = batch.numRows();
+        out->kind = Column::Kind::kBool;
+        out->constant = false;
+        out->bools.assign(numRows, kind_ == Expression::Kind::kLogicalAnd ? 1 : 0);
+        out->fallback.clear();
+        out->fallback.resize(numRows, false);
+        auto* res = out->bools.data();
+        for (auto& operand : operands_) {
+            BatchVector v;
+            operand->eval(batch, &v);
+            if (v.kind != Column::Kind::kBool) {
+                fallbackAll(numRows, out);
+                return;
+            }
+            if (v.constant) {
+                uint8_t b = v.bools[0];
+                for (size_t i = 0; i < numRows; ++i) {
+                    res[i] = apply(res[i], b);
+                }
+                continue;
+            }
+            const auto* vals = v.bools.data();
+            for (size_t i = 0; i < numRows; ++i) {
+                res[i] = apply(res[i], vals[i]);
+            }
+            out->fallback |= v.fallback;
+        }
+    }
+
+private:
+    uint8_t apply(uint8_t acc, uint8_t b) const {
+        switch (kind_) {
+            case Expression::Kind::kLogicalAnd:
+                return acc & b;
+            case Expression::Kind::kLogicalOr:
+                return acc | b;
+            default:
+                return acc ^ b;
+        }
+    }
+
+    Expression::Kind                                kind_;
+    std::vector<std::unique_ptr<BatchExprNode>>     operands_;
+};
+
+class NotNode final : public BatchExprNode {
+public:
+    explicit NotNode(std::unique_ptr<BatchExprNode> operand) : operand_(std::move(operand)) {}
+
+    void eval(const ColumnBatch& batch, BatchVector* out) const override {
+        operand_->eval(batch, out);
+        if (out->kind != Column::Kind::kBool) {
+            fallbackAll(batch.numRows(), out);
+            return;
+        }
+        for (auto& b : out->bools) {
+            b = !b;
+        }
+    }
+
+private:
+    std::unique_ptr<BatchExprNode>      operand_;
+};
+
+class Compiler final {
+public:
+    Compiler(const std::unordered_map<std::string, size_t>& colIndices,
+             std::vector<size_t>* inputCols)
+        : colIndices_(colIndices), inputCols_(inputCols) {}
+
+    std::unique_ptr<BatchExprNode> compile(const Expression* expr) {
+        switch (expr->kind()) {
+            case Expression::Kind::kInputProperty:
+            case Expression::Kind::kVarProperty: {
+                auto* propExpr = static_cast<const PropertyExpression*>(expr);
+                auto found = colIndices_.find(propExpr->prop());
+                if (found == colIndices_.end()) {
+                    return nullptr;
+                }
+                return std::make_unique<ColumnNode>(inputColumn(found->second));
+            }
+            case Expression::Kind::kConstant: {
+                auto& val = static_cast<const ConstantExpression*>(expr)->value();
+                if (!ConstantNode::supported(val)) {
+                    return nullptr;
+                }
+                return std::make_unique<ConstantNode>(val);
+            }
+            case Expression::Kind::kRelEQ:
+            case Expression::Kind::kRelNE:
+            case Expression::Kind::kRelLT:
+            case Expression::Kind::kRelLE:
+            case Expression::Kind::kRelGT:
+            case Expression::Kind::kRelGE: {
+                auto* relExpr = static_cast<const RelationalExpression*>(expr);
+                auto operands = compileOperands(relExpr->left(), relExpr->right());
+                if (operands.empty()) {
+                    return nullptr;
+                }
+                return std::make_unique<RelationalNode>(
+                    expr->kind(), std::move(operands[0]), std::move(operands[1]));
+            }
+            case Expression::Kind::kAdd:
+            case Expression::Kind::kMinus:
+            case Expression::Kind::kMultiply: {
+                auto* arithExpr = static_cast<const ArithmeticExpression*>(expr);
+                auto operands = compileOperands(arithExpr->left(), arithExpr->right());
+                if (operands.empty()) {
+                    return nullptr;
+                }
+                return std::make_unique<ArithmeticNode>(
+                    expr->kind(), std::move(operands[0]), std::move(operands[1]));
+            }
+            case Expression::Kind::kLogicalAnd:
+            case Expression::Kind::kLogicalOr:
+            case Expression::Kind::kLogicalXor: {
+                auto* logicExpr = static_cast<const LogicalExpression*>(expr);
+                std::vector<std::unique_ptr<BatchExprNode>> operands;
+                for (auto* operand : logicExpr->operands()) {
+                    auto node = compile(operand);
+                    if (node == nullptr) {
+                        return nullptr;
+                    }
+                    operands.emplace_back(std::move(node));
+                }
+                return std::make_unique<LogicalNode>(expr->kind(), std::move(operands));
+            }
+            case Expression::Kind::kUnaryNot: {
+                auto node = compile(static_cast<const UnaryExpression*>(expr)->operand());
+                if (node == nullptr) {
+                    return nullptr;
+                }
+                return std::make_unique<NotNode>(std::move(node));
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+private:
+    // The binary kernels hoist at most one constant operand, the constant
+    // binary expressions should have been folded by the validator.
+    std::vector<std::unique_ptr<BatchExprNode>> compileOperands(const Expression* lhs,
+                                                                const Expression* rhs) {
+        std::vector<std::unique_ptr<BatchExprNode>> operands;
+        if (lhs->kind() == Expression::Kind::kConstant &&
+            rhs->kind() == Expression::Kind::kConstant) {
+            return operands;
+        }
+        auto l = compile(lhs);
+        auto r = compile(rhs);
+        if (l == nullptr || r == nullptr) {
+            return operands;
+        }
+        operands.emplace_back(std::move(l));
+        operands.emplace_back(std::move(r));
+        return operands;
+    }
+
+    size_t inputColumn(size_t colIdx) {
+        auto found = std::find(inputCols_->begin(), inputCols_->end(), colIdx);
+        if (found != inputCols_->end()) {
+            return std::distance(inputCols_->begin(), found);
+        }
+        inputCols_->emplace_back(colIdx);
+        return inputCols_->size() - 1;
+    }
+
+    const std::unordered_map<std::string, size_t>&  colIndices_;
+    std::vector<size_t>*                            inputCols_;
+};
+
+}   // namespace
+
+BatchExpression::~BatchExpression() = default;
+
+// static
+std::unique_ptr<BatchExpression> BatchExpression::compile(
+    const Expression* expr,
+    const std::unordered_map<std::string, size_t>& colIndices) {
+    std::unique_ptr<BatchExpression> batchExpr(new BatchExpression());
+    Compiler compiler(colIndices, &batchExpr->colIndices_);
+    batchExpr->root_ = compiler.compile(expr);
+    if (batchExpr->root_ == nullptr) {
+        return nullptr;
+    }
+    return batchExpr;
+}
+
+void BatchExpression::eval(const ColumnBatch& batch, BatchVector* result) const {
+    root_->eval(batch, result);
+    if (result->constant) {
+        // Broadcast the constant result, so callers could read it by row
+        auto numRows = batch.numRows();
+        result->constant = false;
+        result->bools.resize(result->kind == Column::Kind::kBool ? numRows : 0,
+                             result->bools.empty() ? 0 : result->bools[0]);
+        result->ints.resize(result->kind == Column::Kind::kInt ? numRows : 0,
+                            result->ints.empty() ? 0 : result->ints[0]);
+        result->floats.resize(result->kind == Column::Kind::kFloat ? numRows : 0,
+                              result->floats.empty() ? 0.0 : result->floats[0]);
+        if (result->kind == Column::Kind::kString) {
+            result->strs.resize(numRows, result->strs[0]);
+        }
+        result->fallback.clear();
+        result->fallback.resize(numRows, false);
+    }
+}
+
+}  // namespace graph
+}  // namespace nebula
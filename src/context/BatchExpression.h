@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef CONTEXT_BATCHEXPRESSION_H_
+#define CONTEXT_BATCHEXPRESSION_H_
+
+#include "common/expression/Expression.h"
+#include "context/ColumnBatch.h"
+
+namespace nebula {
+namespace graph {
+
+// The result of evaluating an expression over a ColumnBatch. Only the typed
+// vector matching `kind' is filled. A constant is kept as a single slot.
+// The rows marked in `fallback' have no typed result, e.g. the operands are null
+// or the arithmetic overflows, and they should be evaluated by `Expression::eval'
+// to keep the exact semantics of the row-based path.
+struct BatchVector {
+    Column::Kind                        kind{Column::Kind::kNull};
+    bool                                constant{false};
+    std::vector<uint8_t>                bools;
+    std::vector<int64_t>                ints;
+    std::vector<double>                 floats;
+    std::vector<folly::StringPiece>     strs;
+    boost::dynamic_bitset<>             fallback;
+
+    bool isFallback(size_t i) const {
+        return !constant && fallback[i];
+    }
+
+    // Convert the typed result of the i-th row to a value
+    Value value(size_t i) const;
+};
+
+class BatchExprNode;
+
+// Expression compiled to type-specialized kernels over the columns of a batch,
+// which replaces the virtual `eval' of every row by a few tight loops.
+//
+// Supported are the input and variable properties, scalar constants, relational
+// expressions (==, !=, <, <=, >, >=), arithmetic expressions (+, -, *) and the
+// logical expressions (AND, OR, XOR, NOT). Types are dispatched once per batch.
+class BatchExpression final {
+public:
+    ~BatchExpression();
+
+    // Return nullptr if any sub-expression is not supported, and then the caller
+    // should evaluate the expression row by row.
+    // `colIndices' maps the column name of the input rows to its index.
+    static std::unique_ptr<BatchExpression> compile(
+        const Expression* expr,
+        const std::unordered_map<std::string, size_t>& colIndices);
+
+    // The input columns the batch should be built on
+    const std::vector<size_t>& colIndices() const {
+        return colIndices_;
+    }
+
+    void eval(const ColumnBatch& batch, BatchVector* result) const;
+
+private:
+    BatchExpression() = default;
+
+    std::unique_ptr<BatchExprNode>      root_;
+    std::vector<size_t>                 colIndices_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // CONTEXT_BATCHEXPRESSION_H_
@@ -0,0 +1,171 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "context/ColumnBatch.h"
+
+namespace nebula {
+namespace graph {
+
+void Column::build(size_t end) {
+    DCHECK_LE(begin_, end);
+    auto num = end - begin_;
+    nulls_.reserve(num);
+    for (size_t i = begin_; i < end; ++i) {
+        const auto& row = rowAt(i);
+        DCHECK_LT(colIdx_, row.values.size());
+        append(row.values[colIdx_]);
+    }
+}
+
+void Column::append(const Value& val) {
+    if (kind_ == Kind::kValue) {
+        nulls_.push_back(val.isNull() || val.empty());
+        return;
+    }
+    if (val.isNull() || val.empty()) {
+        nulls_.push_back(true);
+        // Keep the typed slot aligned with the row position
+        switch (kind_) {
+            case Kind::kBool:
+                bools_.emplace_back(0);
+                break;
+            case Kind::kInt:
+                ints_.emplace_back(0);
+                break;
+            case Kind::kFloat:
+                floats_.emplace_back(0.0);
+                break;
+            case Kind::kString:
+                strs_.emplace_back();
+                break;
+            case Kind::kNull:
+            case Kind::kValue:
+                break;
+        }
+        return;
+    }
+
+    Kind kind = Kind::kValue;
+    switch (val.type()) {
+        case Value::Type::BOOL:
+            kind = Kind::kBool;
+            break;
+        case Value::Type::INT:
+            kind = Kind::kInt;
+            break;
+        case Value::Type::FLOAT:
+            kind = Kind::kFloat;
+            break;
+        case Value::Type::STRING:
+            kind = Kind::kString;
+            break;
+        default:
+            break;
+    }
+    if (kind_ == Kind::kNull && kind != Kind::kValue) {
+        // The first typed cell decides the kind, fill the slots of the leading nulls
+        kind_ = kind;
+        auto numNulls = nulls_.size();
+        switch (kind_) {
+            case Kind::kBool:
+                bools_.resize(numNulls, 0);
+                break;
+            case Kind::kInt:
+                ints_.resize(numNulls, 0);
+                break;
+            case Kind::kFloat:
+                floats_.resize(numNulls, 0.0);
+                break;
+            case Kind::kString:
+                strs_.resize(numNulls);
+                break;
+            case Kind::kNull:
+            case Kind::kValue:
+                break;
+        }
+    }
+    if (kind != kind_) {
+        fallbackToValue();
+        nulls_.push_back(false);
+        return;
+    }
+
+    nulls_.push_back(false);
+    switch (kind_) {
+        case Kind::kBool:
+            bools_.emplace_back(val.getBool());
+            break;
+        case Kind::kInt:
+            ints_.emplace_back(val.getInt());
+            break;
+        case Kind::kFloat:
+            floats_.emplace_back(val.getFloat());
+            break;
+        case Kind::kString: {
+            const auto& str = val.getStr();
+            strs_.emplace_back(str.data(), str.size());
+            break;
+        }
+        case Kind::kNull:
+        case Kind::kValue:
+            break;
+    }
+}
+
+void Column::fallbackToValue() {
+    kind_ = Kind::kValue;
+    std::vector<uint8_t>().swap(bools_);
+    std::vector<int64_t>().swap(ints_);
+    std::vector<double>().swap(floats_);
+    std::vector<folly::StringPiece>().swap(strs_);
+}
+
+// static
+ColumnBatch ColumnBatch::make(const std::vector<Row>& rows,
+                              const std::vector<size_t>* sel,
+                              size_t begin,
+                              size_t end,
+                              const std::vector<size_t>& colIndices) {
+    DCHECK_LE(begin, end);
+    DCHECK_LE(end, sel != nullptr ? sel->size() : rows.size());
+    ColumnBatch batch;
+    batch.begin_ = begin;
+    batch.numRows_ = end - begin;
+    batch.columns_.reserve(colIndices.size());
+    for (auto colIdx : colIndices) {
+        Column col(&rows, sel, begin, colIdx);
+        col.build(end);
+        batch.columns_.emplace_back(std::move(col));
+    }
+    return batch;
+}
+
+std::ostream& operator<<(std::ostream& os, Column::Kind kind) {
+    switch (kind) {
+        case Column::Kind::kNull:
+            os << "null";
+            break;
+        case Column::Kind::kBool:
+            os << "bool";
+            break;
+        case Column::Kind::kInt:
+            os << "int";
+            break;
+        case Column::Kind::kFloat:
+            os << "float";
+            break;
+        case Column::Kind::kString:
+            os << "string";
+            break;
+        case Column::Kind::kValue:
+            os << "value";
+            break;
+    }
+    return os;
+}
+
+}  // namespace graph
+}  // namespace nebula
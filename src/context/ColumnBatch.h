@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef CONTEXT_COLUMNBATCH_H_
+#define CONTEXT_COLUMNBATCH_H_
+
+#include <boost/dynamic_bitset.hpp>
+#include <folly/Range.h>
+
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// One column of a ColumnBatch.
+//
+// All the non-null cells of the column are kept in one contiguous typed vector
+// if they share the same scalar type. The null bitmap marks the cells which have
+// no typed representation (NULL or EMPTY), the typed slot of these cells is
+// zero-filled and should not be read. The column whose cells have mixed types or
+// non-scalar types is of kind kValue, and it could only be read by `value(i)'.
+class Column final {
+public:
+    enum class Kind : uint8_t {
+        kNull,      // All the cells are NULL or EMPTY
+        kBool,
+        kInt,
+        kFloat,
+        kString,
+        kValue,     // Mixed or non-scalar types
+    };
+
+    Kind kind() const {
+        return kind_;
+    }
+
+    size_t size() const {
+        return nulls_.size();
+    }
+
+    bool isNull(size_t i) const {
+        return nulls_[i];
+    }
+
+    bool hasNull() const {
+        return nulls_.any();
+    }
+
+    const boost::dynamic_bitset<>& nulls() const {
+        return nulls_;
+    }
+
+    const std::vector<uint8_t>& bools() const {
+        DCHECK(kind_ == Kind::kBool);
+        return bools_;
+    }
+
+    const std::vector<int64_t>& ints() const {
+        DCHECK(kind_ == Kind::kInt);
+        return ints_;
+    }
+
+    const std::vector<double>& floats() const {
+        DCHECK(kind_ == Kind::kFloat);
+        return floats_;
+    }
+
+    // The string pieces reference the strings owned by the input rows
+    const std::vector<folly::StringPiece>& strs() const {
+        DCHECK(kind_ == Kind::kString);
+        return strs_;
+    }
+
+    // The original cell in the row view
+    const Value& value(size_t i) const {
+        return rowAt(begin_ + i).values[colIdx_];
+    }
+
+private:
+    friend class ColumnBatch;
+
+    Column(const std::vector<Row>* rows,
+           const std::vector<size_t>* sel,
+           size_t begin,
+           size_t colIdx)
+        : rows_(rows), sel_(sel), begin_(begin), colIdx_(colIdx) {}
+
+    const Row& rowAt(size_t pos) const {
+        if (sel_ != nullptr) {
+            DCHECK_LT(pos, sel_->size());
+            pos = (*sel_)[pos];
+        }
+        DCHECK_LT(pos, rows_->size());
+        return (*rows_)[pos];
+    }
+
+    void build(size_t end);
+
+    void append(const Value& val);
+
+    void fallbackToValue();
+
+    Kind                                kind_{Kind::kNull};
+    const std::vector<Row>*             rows_{nullptr};
+    // The positions of the selected rows, nullptr if all the rows are selected
+    const std::vector<size_t>*          sel_{nullptr};
+    size_t                              begin_{0};
+    size_t                              colIdx_{0};
+    boost::dynamic_bitset<>             nulls_;
+    std::vector<uint8_t>                bools_;
+    std::vector<int64_t>                ints_;
+    std::vector<double>                 floats_;
+    std::vector<folly::StringPiece>     strs_;
+};
+
+// A column-oriented view over the rows [begin, end) of a DataSet, which lets
+// the executors run tight loops over contiguous int/float/string columns instead
+// of dispatching on each `Value' of the row view.
+//
+// The batch does not own the cells, so it must not outlive the rows it was built
+// from, and it is invalidated by any mutation of these rows.
+class ColumnBatch final {
+public:
+    static constexpr size_t kDefaultSize = 1024;
+
+    ColumnBatch() = default;
+    ColumnBatch(ColumnBatch&&) = default;
+    ColumnBatch& operator=(ColumnBatch&&) = default;
+
+    // Build the batch of the given columns, the i-th column in the batch is
+    // the `colIndices[i]'-th column of the rows. If `sel' is given, the rows of
+    // the batch are the rows at the positions of `sel' in [begin, end), and the
+    // batch must not outlive `sel' either.
+    static ColumnBatch make(const std::vector<Row>& rows,
+                            const std::vector<size_t>* sel,
+                            size_t begin,
+                            size_t end,
+                            const std::vector<size_t>& colIndices);
+
+    // The position of the first row of the batch in the input rows, or in the
+    // selection if there is one
+    size_t begin() const {
+        return begin_;
+    }
+
+    size_t numRows() const {
+        return numRows_;
+    }
+
+    size_t numCols() const {
+        return columns_.size();
+    }
+
+    const Column& column(size_t i) const {
+        DCHECK_LT(i, columns_.size());
+        return columns_[i];
+    }
+
+private:
+    size_t                  begin_{0};
+    size_t                  numRows_{0};
+    std::vector<Column>     columns_;
+};
+
+std::ostream& operator<<(std::ostream& os, Column::Kind kind);
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // CONTEXT_COLUMNBATCH_H_
@@ -6,8 +6,111 @@
 
 #include "context/ExecutionContext.h"
 
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+
 namespace nebula {
 namespace graph {
+
+namespace {
+
+// The number of the elements sampled to estimate a big container
+constexpr size_t kSampleSize = 64;
+
+int64_t heapBytes(const Value& value);
+
+// Estimate the heap bytes of the elements, sampling at most kSampleSize of them
+template <typename Container, typename Bytes>
+int64_t sampledBytes(const Container& container, Bytes&& bytes) {
+    auto size = container.size();
+    if (size == 0) {
+        return 0;
+    }
+    size_t stride = std::max<size_t>(size / kSampleSize, 1);
+    size_t sampled = 0;
+    int64_t total = 0;
+    size_t i = 0;
+    for (auto& elem : container) {
+        if (i++ % stride == 0) {
+            total += bytes(elem);
+            ++sampled;
+        }
+    }
+    return total * static_cast<int64_t>(size) / static_cast<int64_t>(sampled);
+}
+
+int64_t valuesBytes(const std::vector<Value>& values) {
+    return values.capacity() * sizeof(Value) +
+           sampledBytes(values, [](const Value& v) { return heapBytes(v); });
+}
+
+int64_t propsBytes(const std::unordered_map<std::string, Value>& props) {
+    // Assume each node of the hash map costs two more pointers
+    return sampledBytes(props, [](const auto& kv) -> int64_t {
+        return sizeof(kv) + 2 * sizeof(void*) + kv.first.size() + heapBytes(kv.second);
+    });
+}
+
+int64_t vertexBytes(const Vertex& vertex) {
+    int64_t bytes = heapBytes(vertex.vid) + vertex.tags.capacity() * sizeof(Tag);
+    for (auto& tag : vertex.tags) {
+        bytes += tag.name.size() + propsBytes(tag.props);
+    }
+    return bytes;
+}
+
+// The bytes out of the Value itself
+int64_t heapBytes(const Value& value) {
+    switch (value.type()) {
+        case Value::Type::STRING:
+            return value.getStr().size();
+        case Value::Type::LIST:
+            return sizeof(List) + valuesBytes(value.getList().values);
+        case Value::Type::SET: {
+            const auto& values = value.getSet().values;
+            return sizeof(Set) + sampledBytes(values, [](const Value& v) -> int64_t {
+                       return sizeof(Value) + 2 * sizeof(void*) + heapBytes(v);
+                   });
+        }
+        case Value::Type::MAP:
+            return sizeof(Map) + propsBytes(value.getMap().kvs);
+        case Value::Type::DATASET: {
+            const auto& ds = value.getDataSet();
+            int64_t bytes = sizeof(DataSet) + ds.rows.capacity() * sizeof(Row);
+            for (auto& col : ds.colNames) {
+                bytes += sizeof(col) + col.size();
+            }
+            return bytes + sampledBytes(ds.rows, [](const Row& row) {
+                       return valuesBytes(row.values);
+                   });
+        }
+        case Value::Type::VERTEX:
+            return sizeof(Vertex) + vertexBytes(value.getVertex());
+        case Value::Type::EDGE: {
+            const auto& edge = value.getEdge();
+            return sizeof(Edge) + heapBytes(edge.src) + heapBytes(edge.dst) + edge.name.size() +
+                   propsBytes(edge.props);
+        }
+        case Value::Type::PATH: {
+            const auto& path = value.getPath();
+            int64_t bytes = sizeof(Path) + vertexBytes(path.src) +
+                            path.steps.capacity() * sizeof(Step);
+            return bytes + sampledBytes(path.steps, [](const Step& step) -> int64_t {
+                       return vertexBytes(step.dst) + step.name.size() + propsBytes(step.props);
+                   });
+        }
+        default:
+            return 0;
+    }
+}
+
+}   // namespace
+
 constexpr int64_t ExecutionContext::kLatestVersion;
 constexpr int64_t ExecutionContext::kOldestVersion;
 constexpr int64_t ExecutionContext::kPreviousOneVersion;
@@ -19,12 +122,18 @@ void ExecutionContext::setValue(const std::string& name, Value&& val) {
 }
 
 void ExecutionContext::setResult(const std::string& name, Result&& result) {
+    result.resetView(this);
+    track(result.valuePtr());
     auto& hist = valueMap_[name];
     hist.emplace_back(std::move(result));
 }
 
 void ExecutionContext::dropResult(const std::string& name) {
-    valueMap_[name].clear();
+    auto& hist = valueMap_[name];
+    for (auto& result : hist) {
+        untrack(result);
+    }
+    hist.clear();
 }
 
 size_t ExecutionContext::numVersions(const std::string& name) const {
@@ -41,7 +150,11 @@ void ExecutionContext::truncHistory(const std::string& name, size_t numVersionsT
             return;
         }
         // Only keep the latest N values
-        it->second.erase(it->second.begin(), it->second.end() - numVersionsToKeep);
+        auto end = it->second.end() - numVersionsToKeep;
+        for (auto iter = it->second.begin(); iter != end; ++iter) {
+            untrack(*iter);
+        }
+        it->second.erase(it->second.begin(), end);
     }
 }
 
@@ -87,5 +200,57 @@ const std::vector<Result>& ExecutionContext::getHistory(const std::string& name)
     }
 }
 
+// static
+int64_t ExecutionContext::estimateMemory(const Value& value) {
+    return sizeof(Value) + heapBytes(value);
+}
+
+void ExecutionContext::track(const std::shared_ptr<Value>& value) {
+    if (value == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(memoryLock_);
+        auto iter = tracked_.find(value.get());
+        if (iter != tracked_.end()) {
+            ++iter->second.refs;
+            return;
+        }
+    }
+    // Estimate out of the lock, which takes a while for the big values
+    auto bytes = estimateMemory(*value);
+    std::lock_guard<std::mutex> guard(memoryLock_);
+    auto& tracked = tracked_[value.get()];
+    ++tracked.refs;
+    if (tracked.refs > 1) {
+        return;
+    }
+    tracked.bytes = bytes;
+    auto memory = memory_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (memory > peakMemory_.load(std::memory_order_relaxed)) {
+        peakMemory_.store(memory, std::memory_order_relaxed);
+    }
+}
+
+void ExecutionContext::untrack(const std::shared_ptr<Value>& value) {
+    if (value == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(memoryLock_);
+    auto iter = tracked_.find(value.get());
+    if (iter == tracked_.end()) {
+        return;
+    }
+    if (--iter->second.refs == 0) {
+        memory_.fetch_sub(iter->second.bytes, std::memory_order_relaxed);
+        tracked_.erase(iter);
+    }
+}
+
+void ExecutionContext::untrack(const Result& result) {
+    untrack(result.valuePtr());
+    untrack(result.viewValuePtr());
+}
+
 }   // namespace graph
 }   // namespace nebula
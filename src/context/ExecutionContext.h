@@ -7,12 +7,15 @@
 #ifndef CONTEXT_EXECUTIONCONTEXT_H_
 #define CONTEXT_EXECUTIONCONTEXT_H_
 
+#include <mutex>
+
 #include "common/datatypes/Value.h"
 #include "context/Result.h"
 
 namespace nebula {
 namespace graph {
 
+class PlanCache;
 class QueryInstance;
 
 /***************************************************************************
@@ -71,12 +74,46 @@ public:
         return valueMap_.find(name) != valueMap_.end();
     }
 
+    // The estimated bytes of the values held by the context. The values shared
+    // by several results are counted once.
+    int64_t memory() const {
+        return memory_.load(std::memory_order_relaxed);
+    }
+
+    int64_t peakMemory() const {
+        return peakMemory_.load(std::memory_order_relaxed);
+    }
+
+    // Estimate the bytes of the value, by sampling the rows of the big ones
+    static int64_t estimateMemory(const Value& value);
+
 private:
+    friend class PlanCache;
     friend class QueryInstance;
+    // Result tracks the rows materialized from its view
+    friend class Result;
     Value moveValue(const std::string& name);
 
+    void track(const std::shared_ptr<Value>& value);
+
+    void untrack(const std::shared_ptr<Value>& value);
+
+    // Untrack the value of the result and the rows materialized from its view
+    void untrack(const Result& result);
+
+    struct Tracked {
+        int64_t     bytes{0};
+        size_t      refs{0};
+    };
+
     // name -> Value with multiple versions
     std::unordered_map<std::string, std::vector<Result>>     valueMap_;
+
+    // The results are set by the executors concurrently
+    std::mutex                                              memoryLock_;
+    std::unordered_map<const Value*, Tracked>               tracked_;
+    std::atomic<int64_t>                                    memory_{0};
+    std::atomic<int64_t>                                    peakMemory_{0};
 };
 
 }  // namespace graph
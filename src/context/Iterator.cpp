@@ -6,6 +6,8 @@
 
 #include "context/Iterator.h"
 
+#include <numeric>
+
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/Vertex.h"
 #include "common/interface/gen-cpp2/common_types.h"
@@ -37,8 +39,8 @@ void GetNeighborsIter::goToFirstEdge() {
         }
         for (currentRow_ = currentDs_->ds->rows.begin();
             currentRow_ < currentDs_->ds->rows.end(); ++currentRow_) {
-            colIdx_ = currentDs_->colLowerBound + 1;
-            while (colIdx_ < currentDs_->colUpperBound && !valid_) {
+            colIdx_ = currentDs_->index->colLowerBound + 1;
+            while (colIdx_ < currentDs_->index->colUpperBound && !valid_) {
                 const auto& currentCol = currentRow_->operator[](colIdx_);
                 if (!currentCol.isList() || currentCol.getList().empty()) {
                     ++colIdx_;
@@ -87,43 +89,50 @@ Status GetNeighborsIter::processList(std::shared_ptr<Value> value) {
         ss << "Value type is not list, type: " << value->type();
         return Status::Error(ss.str());
     }
-    for (auto& val : value->getList().values) {
+    // The responses of a request usually have the same columns, so the index of each
+    // distinct column names is built only once
+    std::vector<const std::vector<std::string>*> layoutColNames;
+    auto& values = value->getList().values;
+    dsIndices_.reserve(values.size());
+    for (auto& val : values) {
         if (UNLIKELY(!val.isDataSet())) {
             return Status::Error("There is a value in list which is not a data set.");
         }
-        auto status = makeDataSetIndex(val.getDataSet());
-        NG_RETURN_IF_ERROR(status);
-        dsIndices_.emplace_back(std::move(status).value());
+        const auto& ds = val.getDataSet();
+        size_t layout = 0;
+        while (layout < layouts_.size() && *layoutColNames[layout] != ds.colNames) {
+            ++layout;
+        }
+        if (layout == layouts_.size()) {
+            auto index = std::make_shared<ColumnIndex>();
+            NG_RETURN_IF_ERROR(buildIndex(ds.colNames, index.get()));
+            layouts_.emplace_back(std::move(index));
+            layoutColNames.emplace_back(&ds.colNames);
+        }
+        dsIndices_.emplace_back(DataSetIndex{&ds, layouts_[layout], layout});
     }
     return Status::OK();
 }
 
-StatusOr<GetNeighborsIter::DataSetIndex> GetNeighborsIter::makeDataSetIndex(const DataSet& ds) {
-    DataSetIndex dsIndex;
-    dsIndex.ds = &ds;
-    auto buildResult = buildIndex(&dsIndex);
-    NG_RETURN_IF_ERROR(buildResult);
-    return dsIndex;
-}
-
 bool checkColumnNames(const std::vector<std::string>& colNames) {
     return colNames.size() < 3 || colNames[0] != nebula::kVid || colNames[1].find("_stats") != 0 ||
            colNames.back().find("_expr") != 0;
 }
 
-StatusOr<int64_t> GetNeighborsIter::buildIndex(DataSetIndex* dsIndex) {
-    auto& colNames = dsIndex->ds->colNames;
+StatusOr<int64_t> GetNeighborsIter::buildIndex(const std::vector<std::string>& colNames,
+                                               ColumnIndex* index) {
     if (UNLIKELY(checkColumnNames(colNames))) {
         return Status::Error("Bad column names.");
     }
     int64_t edgeStartIndex = -1;
+    index->tagEdgeNames.resize(colNames.size());
     for (size_t i = 0; i < colNames.size(); ++i) {
-        dsIndex->colIndices.emplace(colNames[i], i);
+        index->colIndices.emplace(colNames[i], i);
         auto& colName = colNames[i];
         if (colName.find(nebula::kTag) == 0) {  // "_tag"
-            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, false, dsIndex));
+            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, false, index));
         } else if (colName.find("_edge") == 0) {
-            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, true, dsIndex));
+            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, true, index));
             if (edgeStartIndex < 0) {
                 edgeStartIndex = i;
             }
@@ -134,15 +143,15 @@ StatusOr<int64_t> GetNeighborsIter::buildIndex(DataSetIndex* dsIndex) {
     if (edgeStartIndex == -1) {
         noEdge_ = true;
     }
-    dsIndex->colLowerBound = edgeStartIndex - 1;
-    dsIndex->colUpperBound = colNames.size() - 1;
+    index->colLowerBound = edgeStartIndex - 1;
+    index->colUpperBound = colNames.size() - 1;
     return edgeStartIndex;
 }
 
 Status GetNeighborsIter::buildPropIndex(const std::string& props,
                                         size_t columnId,
                                         bool isEdge,
-                                        DataSetIndex* dsIndex) {
+                                        ColumnIndex* index) {
     std::vector<std::string> pieces;
     folly::split(":", props, pieces);
     if (UNLIKELY(pieces.size() < 2)) {
@@ -166,11 +175,11 @@ Status GetNeighborsIter::buildPropIndex(const std::string& props,
         if (UNLIKELY(name.empty() || (name[0] != '+' && name[0] != '-'))) {
             return Status::Error("Bad edge name: %s", name.c_str());
         }
-        dsIndex->tagEdgeNameIndices.emplace(columnId, name);
-        dsIndex->edgePropsMap.emplace(name, std::move(propIdx));
+        index->tagEdgeNames[columnId] = name;
+        index->edgePropsMap.emplace(name, std::move(propIdx));
     } else {
-        dsIndex->tagEdgeNameIndices.emplace(columnId, name);
-        dsIndex->tagPropsMap.emplace(name, std::move(propIdx));
+        index->tagEdgeNames[columnId] = name;
+        index->tagPropsMap.emplace(name, std::move(propIdx));
     }
 
     return Status::OK();
@@ -180,7 +189,7 @@ bool GetNeighborsIter::valid() const {
     return valid_
             && currentDs_ < dsIndices_.end()
             && currentRow_ < rowsUpperBound_
-            && colIdx_ < currentDs_->colUpperBound;
+            && colIdx_ < currentDs_->index->colUpperBound;
 }
 
 void GetNeighborsIter::next() {
@@ -222,7 +231,7 @@ void GetNeighborsIter::next() {
 
         // go to next column
         while (++colIdx_) {
-            if (colIdx_ < currentDs_->colUpperBound) {
+            if (colIdx_ < currentDs_->index->colUpperBound) {
                 const auto& currentCol = currentRow_->operator[](colIdx_);
                 if (!currentCol.isList() || currentCol.getList().empty()) {
                     continue;
@@ -236,13 +245,13 @@ void GetNeighborsIter::next() {
             }
             // go to next row
             if (++currentRow_ < rowsUpperBound_) {
-                colIdx_ = currentDs_->colLowerBound;
+                colIdx_ = currentDs_->index->colLowerBound;
                 continue;
             }
 
             // go to next dataset
             if (++currentDs_ < dsIndices_.end()) {
-                colIdx_ = currentDs_->colLowerBound;
+                colIdx_ = currentDs_->index->colLowerBound;
                 currentRow_ = currentDs_->ds->begin();
                 rowsUpperBound_ = currentDs_->ds->end();
                 continue;
@@ -266,7 +275,7 @@ const Value& GetNeighborsIter::getColumn(const std::string& col) const {
     if (!valid()) {
         return Value::kNullValue;
     }
-    auto& index = currentDs_->colIndices;
+    auto& index = currentDs_->index->colIndices;
     auto found = index.find(col);
     if (found == index.end()) {
         return Value::kEmpty;
@@ -286,18 +295,13 @@ const Value& GetNeighborsIter::getTagProp(const std::string& tag,
         return Value::kNullValue;
     }
 
-    auto &tagPropIndices = currentDs_->tagPropsMap;
-    auto index = tagPropIndices.find(tag);
-    if (index == tagPropIndices.end()) {
+    const auto& position = tagPropSlot(tag, prop).positions[currentDs_->layout];
+    if (position.first < 0) {
         return Value::kEmpty;
     }
-    auto propIndex = index->second.propIndices.find(prop);
-    if (propIndex == index->second.propIndices.end()) {
-        return Value::kEmpty;
-    }
-    auto colId = index->second.colIdx;
+    auto colId = position.first;
     auto& row = *currentRow_;
-    DCHECK_GT(row.size(), colId);
+    DCHECK_GT(row.size(), static_cast<size_t>(colId));
     if (row[colId].empty()) {
         return Value::kEmpty;
     }
@@ -305,7 +309,7 @@ const Value& GetNeighborsIter::getTagProp(const std::string& tag,
         return Value::kNullBadType;
     }
     auto& list = row[colId].getList();
-    return list.values[propIndex->second];
+    return list.values[position.second];
 }
 
 const Value& GetNeighborsIter::getEdgeProp(const std::string& edge,
@@ -314,24 +318,72 @@ const Value& GetNeighborsIter::getEdgeProp(const std::string& edge,
         return Value::kNullValue;
     }
 
-    auto& currentEdge = currentEdgeName();
-    if (edge != "*" &&
-            (currentEdge.compare(1, std::string::npos, edge) != 0)) {
-        VLOG(1) << "Current edge: " << currentEdgeName() << " Wanted: " << edge;
+    if (noEdge_) {
         return Value::kEmpty;
     }
-    auto index = currentDs_->edgePropsMap.find(currentEdge);
-    if (index == currentDs_->edgePropsMap.end()) {
-        VLOG(1) << "No edge found: " << edge;
-        VLOG(1) << "Current edge: " << currentEdge;
+    // The position is -1 if the current edge is not `edge', or has no `prop'
+    auto position = edgePropSlot(edge, prop).positions[currentDs_->layout][colIdx_];
+    if (position < 0) {
         return Value::kEmpty;
     }
-    auto propIndex = index->second.propIndices.find(prop);
-    if (propIndex == index->second.propIndices.end()) {
-        VLOG(1) << "No edge prop found: " << prop;
-        return Value::kEmpty;
+    return currentEdge_->values[position];
+}
+
+const GetNeighborsIter::TagPropSlot& GetNeighborsIter::tagPropSlot(const std::string& tag,
+                                                                  const std::string& prop) const {
+    for (auto& slot : tagPropSlots_) {
+        if (slot.prop == prop && slot.tag == tag) {
+            return slot;
+        }
+    }
+    TagPropSlot slot;
+    slot.tag = tag;
+    slot.prop = prop;
+    slot.positions.reserve(layouts_.size());
+    for (auto& layout : layouts_) {
+        std::pair<int64_t, int64_t> position(-1, -1);
+        auto index = layout->tagPropsMap.find(tag);
+        if (index != layout->tagPropsMap.end()) {
+            auto propIndex = index->second.propIndices.find(prop);
+            if (propIndex != index->second.propIndices.end()) {
+                position.first = index->second.colIdx;
+                position.second = propIndex->second;
+            }
+        }
+        slot.positions.emplace_back(position);
+    }
+    tagPropSlots_.emplace_back(std::move(slot));
+    return tagPropSlots_.back();
+}
+
+const GetNeighborsIter::EdgePropSlot& GetNeighborsIter::edgePropSlot(
+    const std::string& edge,
+    const std::string& prop) const {
+    for (auto& slot : edgePropSlots_) {
+        if (slot.prop == prop && slot.edge == edge) {
+            return slot;
+        }
     }
-    return currentEdge_->values[propIndex->second];
+    EdgePropSlot slot;
+    slot.edge = edge;
+    slot.prop = prop;
+    slot.positions.reserve(layouts_.size());
+    for (auto& layout : layouts_) {
+        std::vector<int64_t> positions(layout->tagEdgeNames.size(), -1);
+        for (auto& edgeProps : layout->edgePropsMap) {
+            // The edge name is prefixed by the direction
+            if (edge != "*" && edgeProps.first.compare(1, std::string::npos, edge) != 0) {
+                continue;
+            }
+            auto propIndex = edgeProps.second.propIndices.find(prop);
+            if (propIndex != edgeProps.second.propIndices.end()) {
+                positions[edgeProps.second.colIdx] = propIndex->second;
+            }
+        }
+        slot.positions.emplace_back(std::move(positions));
+    }
+    edgePropSlots_.emplace_back(std::move(slot));
+    return edgePropSlots_.back();
 }
 
 Value GetNeighborsIter::getVertex() const {
@@ -345,7 +397,7 @@ Value GetNeighborsIter::getVertex() const {
     }
     Vertex vertex;
     vertex.vid = vidVal;
-    auto& tagPropMap = currentDs_->tagPropsMap;
+    auto& tagPropMap = currentDs_->index->tagPropsMap;
     for (auto& tagProp : tagPropMap) {
         auto& row = *currentRow_;
         auto& tagPropNameList = tagProp.second.propList;
@@ -417,7 +469,7 @@ Value GetNeighborsIter::getEdge() const {
     }
     edge.ranking = rank.getInt();
 
-    auto& edgePropMap = currentDs_->edgePropsMap;
+    auto& edgePropMap = currentDs_->index->edgePropsMap;
     auto edgeProp = edgePropMap.find(currentEdgeName());
     if (edgeProp == edgePropMap.end()) {
         return Value::kNullValue;
@@ -481,10 +533,7 @@ void SequentialIter::init(std::vector<std::unique_ptr<Iterator>>&& iterators) {
     DataSet ds;
     for (auto& iter : iterators) {
         DCHECK(iter->isSequentialIter());
-        auto inputIter = static_cast<SequentialIter*>(iter.get());
-        ds.rows.insert(ds.rows.end(),
-                     std::make_move_iterator(inputIter->begin()),
-                     std::make_move_iterator(inputIter->end()));
+        static_cast<SequentialIter*>(iter.get())->appendRows(&ds.rows);
     }
     value_ = std::make_shared<Value>(std::move(ds));
     rows_ = &value_->mutableDataSet().rows;
@@ -492,20 +541,42 @@ void SequentialIter::init(std::vector<std::unique_ptr<Iterator>>&& iterators) {
 }
 
 bool SequentialIter::valid() const {
+    if (view_) {
+        return pos_ < sel_.size();
+    }
     return iter_ < rows_->end();
 }
 
 void SequentialIter::next() {
-    if (valid()) {
+    if (!valid()) {
+        return;
+    }
+    if (view_) {
+        ++pos_;
+        seek();
+    } else {
         ++iter_;
     }
 }
 
 void SequentialIter::erase() {
+    viewIfShared();
+    if (view_) {
+        sel_.erase(sel_.begin() + pos_);
+        seek();
+        return;
+    }
     iter_ = rows_->erase(iter_);
 }
 
 void SequentialIter::unstableErase() {
+    viewIfShared();
+    if (view_) {
+        std::swap(sel_.back(), sel_[pos_]);
+        sel_.pop_back();
+        seek();
+        return;
+    }
     std::swap(rows_->back(), *iter_);
     rows_->pop_back();
 }
@@ -514,16 +585,90 @@ void SequentialIter::eraseRange(size_t first, size_t last) {
     if (first >= last || first >= size()) {
         return;
     }
-    if (last > size()) {
-        rows_->erase(rows_->begin() + first, rows_->end());
+    last = std::min(last, size());
+    viewIfShared();
+    if (view_) {
+        sel_.erase(sel_.begin() + first, sel_.begin() + last);
     } else {
         rows_->erase(rows_->begin() + first, rows_->begin() + last);
     }
     reset();
 }
 
+void SequentialIter::clear() {
+    viewIfShared();
+    if (view_) {
+        sel_.clear();
+    } else {
+        rows_->clear();
+    }
+    reset();
+}
+
+void SequentialIter::select(std::vector<size_t> positions) {
+    // The rows selected are never changed in place, so the positions stay valid
+    // as long as they are in range when selected
+    for (auto& pos : positions) {
+        CHECK_LT(pos, size());
+        if (view_) {
+            pos = sel_[pos];
+        }
+    }
+    sel_ = std::move(positions);
+    view_ = true;
+    reset();
+}
+
+void SequentialIter::viewIfShared() {
+    if (!shared() || view_) {
+        return;
+    }
+    pos_ = iter_ - rows_->begin();
+    sel_.resize(rows_->size());
+    std::iota(sel_.begin(), sel_.end(), 0);
+    view_ = true;
+}
+
+DataSet SequentialIter::materialize() const {
+    DataSet ds;
+    if (value_->isDataSet()) {
+        ds.colNames = value_->getDataSet().colNames;
+    }
+    if (!view_) {
+        ds.rows = *rows_;
+        return ds;
+    }
+    ds.rows.reserve(sel_.size());
+    for (auto pos : sel_) {
+        ds.rows.emplace_back((*rows_)[pos]);
+    }
+    return ds;
+}
+
+void SequentialIter::appendRows(std::vector<Row>* rows) {
+    if (!shared()) {
+        rows->insert(rows->end(),
+                     std::make_move_iterator(rows_->begin()),
+                     std::make_move_iterator(rows_->end()));
+        return;
+    }
+    if (!view_) {
+        rows->insert(rows->end(), rows_->begin(), rows_->end());
+        return;
+    }
+    rows->reserve(rows->size() + sel_.size());
+    for (auto pos : sel_) {
+        rows->emplace_back((*rows_)[pos]);
+    }
+}
+
 void SequentialIter::doReset(size_t pos) {
     DCHECK((pos == 0 && size() == 0) || (pos < size()));
+    if (view_) {
+        pos_ = pos;
+        seek();
+        return;
+    }
     iter_ = rows_->begin() + pos;
 }
 
@@ -531,6 +676,14 @@ const Value& SequentialIter::getColumn(int32_t index) const {
     return getColumnByIndex(index, iter_);
 }
 
+ColumnBatch SequentialIter::columnBatch(size_t first,
+                                        size_t last,
+                                        const std::vector<size_t>& colIndices) const {
+    last = std::min(last, size());
+    first = std::min(first, last);
+    return ColumnBatch::make(*rows_, view_ ? &sel_ : nullptr, first, last, colIndices);
+}
+
 PropIter::PropIter(std::shared_ptr<Value> value) : SequentialIter(value) {
     DCHECK(value->isDataSet());
     auto& ds = value->getDataSet();
@@ -592,23 +745,36 @@ const Value& PropIter::getProp(const std::string& name, const std::string& prop)
     if (!valid()) {
         return Value::kNullValue;
     }
-    auto& propsMap = dsIndex_.propsMap;
-    auto index = propsMap.find(name);
-    if (index == propsMap.end()) {
+    auto colId = propColumn(name, prop);
+    if (colId == kNoName) {
         return Value::kEmpty;
     }
-
-    auto propIndex = index->second.find(prop);
-    if (propIndex == index->second.end()) {
+    if (colId == kNoProp) {
         VLOG(1) << "No prop found : " << prop;
         return Value::kNullValue;
     }
-    auto colId = propIndex->second;
     auto& row = *iter_;
-    DCHECK_GT(row.size(), colId);
+    DCHECK_GT(row.size(), static_cast<size_t>(colId));
     return row[colId];
 }
 
+int64_t PropIter::propColumn(const std::string& name, const std::string& prop) const {
+    for (auto& slot : propSlots_) {
+        if (slot.prop == prop && slot.name == name) {
+            return slot.colIdx;
+        }
+    }
+    int64_t colIdx = kNoName;
+    auto& propsMap = dsIndex_.propsMap;
+    auto index = propsMap.find(name);
+    if (index != propsMap.end()) {
+        auto propIndex = index->second.find(prop);
+        colIdx = propIndex == index->second.end() ? kNoProp : propIndex->second;
+    }
+    propSlots_.emplace_back(PropSlot{name, prop, colIdx});
+    return colIdx;
+}
+
 Value PropIter::getVertex() const {
     if (!valid()) {
         return Value::kNullValue;
@@ -711,7 +877,7 @@ Value PropIter::getEdge() const {
 }
 
 List PropIter::getVertices() {
-    DCHECK(iter_ == rows_->begin());
+    reset();
     List vertices;
     vertices.values.reserve(size());
     for (; valid(); next()) {
@@ -722,7 +888,7 @@ List PropIter::getVertices() {
 }
 
 List PropIter::getEdges() {
-    DCHECK(iter_ == rows_->begin());
+    reset();
     List edges;
     edges.values.reserve(size());
     for (; valid(); next()) {
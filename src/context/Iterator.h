@@ -14,6 +14,7 @@
 #include "common/datatypes/Value.h"
 #include "common/datatypes/List.h"
 #include "common/datatypes/DataSet.h"
+#include "context/ColumnBatch.h"
 #include "parser/TraverseSentences.h"
 
 namespace nebula {
@@ -106,6 +107,12 @@ public:
         return kind_ == Kind::kProp;
     }
 
+    // Whether the iterator only selects some rows of a value shared with others,
+    // see SequentialIter::select
+    virtual bool isView() const {
+        return false;
+    }
+
     // The derived class should rewrite get prop if the Value is kind of dataset.
     virtual const Value& getColumn(const std::string& col) const = 0;
 
@@ -279,9 +286,8 @@ private:
     }
 
     inline const std::string& currentEdgeName() const {
-        DCHECK(currentDs_->tagEdgeNameIndices.find(colIdx_)
-                != currentDs_->tagEdgeNameIndices.end());
-        return currentDs_->tagEdgeNameIndices.find(colIdx_)->second;
+        DCHECK_LT(static_cast<size_t>(colIdx_), currentDs_->index->tagEdgeNames.size());
+        return currentDs_->index->tagEdgeNames[colIdx_];
     }
 
     struct PropIndex {
@@ -290,14 +296,15 @@ private:
         std::unordered_map<std::string, size_t> propIndices;
     };
 
-    struct DataSetIndex {
-        const DataSet* ds;
+    // The index of the columns, which is built once for the datasets of the same
+    // column names and shared by them
+    struct ColumnIndex {
         // | _vid | _stats | _tag:t1:p1:p2 | _edge:e1:p1:p2 |
         // -> {_vid : 0, _stats : 1, _tag:t1:p1:p2 : 2, _edge:d1:p1:p2 : 3}
         std::unordered_map<std::string, size_t> colIndices;
         // | _vid | _stats | _tag:t1:p1:p2 | _edge:e1:p1:p2 |
-        // -> {2 : t1, 3 : e1}
-        std::unordered_map<size_t, std::string> tagEdgeNameIndices;
+        // -> ["", "", t1, e1]
+        std::vector<std::string> tagEdgeNames;
         // _tag:t1:p1:p2  ->  {t1 : [column_idx, [p1, p2], {p1 : 0, p2 : 1}]}
         std::unordered_map<std::string, PropIndex> tagPropsMap;
         // _edge:e1:p1:p2  ->  {e1 : [column_idx, [p1, p2], {p1 : 0, p2 : 1}]}
@@ -307,23 +314,54 @@ private:
         int64_t colUpperBound{-1};
     };
 
+    struct DataSetIndex {
+        const DataSet* ds;
+        std::shared_ptr<const ColumnIndex> index;
+        // The position of the index in `layouts_'
+        size_t layout;
+    };
+
+    // The prop of the tag or edge resolved against each layout once it is got, so
+    // the prop got by an expression on every row is an array access rather than
+    // the lookups by the names
+    struct TagPropSlot {
+        std::string tag;
+        std::string prop;
+        // The column and the position in it for each layout, -1 if there is none
+        std::vector<std::pair<int64_t, int64_t>> positions;
+    };
+
+    struct EdgePropSlot {
+        std::string edge;
+        std::string prop;
+        // The position in the edges of each column for each layout, -1 if there is none
+        std::vector<std::vector<int64_t>> positions;
+    };
+
+    const TagPropSlot& tagPropSlot(const std::string& tag, const std::string& prop) const;
+
+    const EdgePropSlot& edgePropSlot(const std::string& edge, const std::string& prop) const;
+
     Status processList(std::shared_ptr<Value> value);
 
     void goToFirstEdge();
 
-    StatusOr<int64_t> buildIndex(DataSetIndex* dsIndex);
+    StatusOr<int64_t> buildIndex(const std::vector<std::string>& colNames, ColumnIndex* index);
 
     Status buildPropIndex(const std::string& props,
                           size_t columnId,
                           bool isEdge,
-                          DataSetIndex* dsIndex);
-
-    StatusOr<DataSetIndex> makeDataSetIndex(const DataSet& ds);
+                          ColumnIndex* index);
 
     FRIEND_TEST(IteratorTest, TestHead);
 
     bool                                 valid_{false};
+    // The distinct indices of the datasets
+    std::vector<std::shared_ptr<const ColumnIndex>> layouts_;
     std::vector<DataSetIndex>            dsIndices_;
+    // Only a few props are got by a query, so they are searched linearly
+    mutable std::vector<TagPropSlot>     tagPropSlots_;
+    mutable std::vector<EdgePropSlot>    edgePropSlots_;
 
     std::vector<DataSetIndex>::iterator  currentDs_;
 
@@ -368,25 +406,50 @@ public:
 
     void eraseRange(size_t first, size_t last) override;
 
-    void clear() override {
-        rows_->clear();
-        reset();
+    void clear() override;
+
+    // Keep only the rows at `positions' of the current rows, in the given order.
+    //
+    // The iterator becomes a view over the rows shared with the other iterators
+    // of the same value: the rows are neither moved nor copied. So the executors
+    // filtering or reordering their input, e.g. Filter, Dedup, Intersect and Sort,
+    // don't touch the input rows which may be read by the other executors.
+    void select(std::vector<size_t> positions);
+
+    bool isView() const override {
+        return view_;
+    }
+
+    // Whether the rows may be read by the others. The rows shared are never
+    // changed in place: erasing on them turns the iterator into a view, and
+    // the rows are copied rather than moved out of them.
+    bool shared() const {
+        return view_ || value_.use_count() > 1;
     }
 
-    std::vector<Row>::iterator begin() {
-        return rows_->begin();
+    // The underlying rows, including the ones not selected by a view
+    const std::vector<Row>& rows() const {
+        return *rows_;
     }
 
-    std::vector<Row>::iterator end() {
-        return rows_->end();
+    // The positions of the selected rows in `rows()', nullptr if it's not a view
+    const std::vector<size_t>* selection() const {
+        return view_ ? &sel_ : nullptr;
     }
 
+    // The selected rows in a dataset of the same columns
+    DataSet materialize() const;
+
+    // Append the rows to `rows'. The rows are moved if they are owned by the
+    // iterator only, otherwise they are copied.
+    void appendRows(std::vector<Row>* rows);
+
     const std::unordered_map<std::string, size_t>& getColIndices() const {
         return colIndices_;
     }
 
     size_t size() const override {
-        return rows_->size();
+        return view_ ? sel_.size() : rows_->size();
     }
 
     const Value& getColumn(const std::string& col) const override {
@@ -405,19 +468,34 @@ public:
 
     const Value& getColumn(int32_t index) const override;
 
+    // Column-oriented view of the rows [first, last) on the given column indices,
+    // which is built alongside the row view and shares the cells with it.
+    ColumnBatch columnBatch(size_t first,
+                            size_t last,
+                            const std::vector<size_t>& colIndices) const;
+
 protected:
     const Row* row() const override {
         return &*iter_;
     }
 
     // Notice: We only use this interface when return results to client.
+    // The row shared is copied.
     friend class DataCollectExecutor;
-    Row&& moveRow() {
-        return std::move(*iter_);
+    Row moveRow() {
+        return shared() ? *iter_ : std::move(*iter_);
     }
 
     void doReset(size_t pos) override;
 
+    // Select all the rows instead of changing the rows shared
+    void viewIfShared();
+
+    // Point `iter_' to the selected row at `pos_'
+    void seek() {
+        iter_ = pos_ < sel_.size() ? rows_->begin() + sel_[pos_] : rows_->end();
+    }
+
     std::vector<Row>::iterator                   iter_;
     std::vector<Row>*                            rows_{nullptr};
 
@@ -425,6 +503,12 @@ private:
     void init(std::vector<std::unique_ptr<Iterator>>&& iterators);
 
     std::unordered_map<std::string, size_t>      colIndices_;
+
+    bool                                         view_{false};
+    // The positions of the selected rows in `rows_' if it's a view
+    std::vector<size_t>                          sel_;
+    // The current position in `sel_'
+    size_t                                       pos_{0};
 };
 
 class PropIter final : public SequentialIter {
@@ -468,6 +552,19 @@ private:
 
     Status buildPropIndex(const std::string& props, size_t columnIdx);
 
+    static constexpr int64_t kNoName = -1;
+    static constexpr int64_t kNoProp = -2;
+
+    // The prop resolved once it is got, see GetNeighborsIter::TagPropSlot
+    struct PropSlot {
+        std::string name;
+        std::string prop;
+        // The column, or kNoName or kNoProp
+        int64_t     colIdx;
+    };
+
+    int64_t propColumn(const std::string& name, const std::string& prop) const;
+
     struct DataSetIndex {
         const DataSet* ds;
         // vertex | _vid | tag1.prop1 | tag1.prop2 | tag2,prop1 | tag2,prop2 | ...
@@ -482,6 +579,7 @@ private:
 
 private:
     DataSetIndex                                                   dsIndex_;
+    mutable std::vector<PropSlot>                                  propSlots_;
 };
 
 
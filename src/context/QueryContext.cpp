@@ -6,6 +6,8 @@
 
 #include "context/QueryContext.h"
 
+#include "common/expression/Expression.h"
+
 namespace nebula {
 namespace graph {
 
@@ -30,6 +32,7 @@ QueryContext::QueryContext() {
 
 void QueryContext::init() {
     objPool_ = std::make_unique<ObjectPool>();
+    execPool_ = std::make_unique<ObjectPool>();
     ep_ = std::make_unique<ExecutionPlan>();
     ectx_ = std::make_unique<ExecutionContext>();
     idGen_ = std::make_unique<IdGenerator>(0);
@@ -37,5 +40,38 @@ void QueryContext::init() {
     vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
 }
 
+void QueryContext::resetExecution() {
+    // The executors refer to the results in the execution context
+    execPool_ = std::make_unique<ObjectPool>();
+    ectx_ = std::make_unique<ExecutionContext>();
+    symTable_->resetUserCounts();
+    killed_.store(false);
+}
+
+std::vector<Expression*> QueryContext::lendClones(const std::vector<Expression*>& exprs) {
+    std::vector<Expression*> clones;
+    clones.reserve(exprs.size());
+    std::lock_guard<std::mutex> lock(clonesLock_);
+    for (auto* expr : exprs) {
+        auto& idle = idleClones_[expr];
+        if (idle.empty()) {
+            clones.emplace_back(expr->clone());
+        } else {
+            clones.emplace_back(idle.back());
+            idle.pop_back();
+        }
+    }
+    return clones;
+}
+
+void QueryContext::giveBackClones(const std::vector<Expression*>& exprs,
+                                  const std::vector<Expression*>& clones) {
+    DCHECK_EQ(exprs.size(), clones.size());
+    std::lock_guard<std::mutex> lock(clonesLock_);
+    for (size_t i = 0; i < exprs.size(); ++i) {
+        idleClones_[exprs[i]].emplace_back(clones[i]);
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -7,6 +7,10 @@
 #ifndef CONTEXT_QUERYCONTEXT_H_
 #define CONTEXT_QUERYCONTEXT_H_
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "common/base/ObjectPool.h"
 #include "common/charset/Charset.h"
 #include "common/clients/meta/MetaClient.h"
@@ -23,6 +27,9 @@
 #include "util/IdGenerator.h"
 
 namespace nebula {
+
+class Expression;
+
 namespace graph {
 
 /***************************************************************************
@@ -56,6 +63,10 @@ public:
         rctx_ = std::move(rctx);
     }
 
+    RequestContextPtr releaseRCtx() {
+        return std::move(rctx_);
+    }
+
     void setSchemaManager(meta::SchemaManager* sm) {
         sm_ = sm;
     }
@@ -116,6 +127,11 @@ public:
         return objPool_.get();
     }
 
+    // The pool of the objects living in one execution, e.g. executors
+    ObjectPool* execPool() const {
+        return execPool_.get();
+    }
+
     int64_t genId() const {
         return idGen_->id();
     }
@@ -137,6 +153,17 @@ public:
         return killed_.load();
     }
 
+    // Clear the states left by the last execution, so that the plan could be
+    // executed again, e.g. the one cached by the plan cache.
+    void resetExecution();
+
+    // Lend the clones of `exprs' to a parallel job, since the expressions keep the
+    // evaluation states. The clones given back are lent again, so they are made once
+    // for the plan instead of for each job of each execution, e.g. in a loop.
+    std::vector<Expression*> lendClones(const std::vector<Expression*>& exprs);
+    void giveBackClones(const std::vector<Expression*>& exprs,
+                        const std::vector<Expression*>& clones);
+
 private:
     void init();
 
@@ -153,10 +180,15 @@ private:
     // The Object Pool holds all internal generated objects.
     // e.g. expressions, plan nodes, executors
     std::unique_ptr<ObjectPool>                             objPool_;
+    std::unique_ptr<ObjectPool>                             execPool_;
     std::unique_ptr<IdGenerator>                            idGen_;
     std::unique_ptr<SymbolTable>                            symTable_;
 
     std::atomic<bool>                                       killed_{false};
+
+    // The clones not lent to any job, by the expressions they are cloned from
+    std::mutex                                              clonesLock_;
+    std::unordered_map<const Expression*, std::vector<Expression*>> idleClones_;
 };
 
 }   // namespace graph
@@ -6,6 +6,8 @@
 
 #include "context/Result.h"
 
+#include "context/ExecutionContext.h"
+
 namespace nebula {
 namespace graph {
 
@@ -20,6 +22,16 @@ const std::vector<Result>& Result::EmptyResultList() {
     return kEmptyResultList;
 }
 
+const Value& Result::View::get(const Iterator& iter) {
+    std::call_once(once, [this, &iter]() {
+        value = std::make_shared<Value>(static_cast<const SequentialIter&>(iter).materialize());
+        if (ectx != nullptr) {
+            ectx->track(value);
+        }
+    });
+    return *value;
+}
+
 ResultBuilder& ResultBuilder::iter(Iterator::Kind kind) {
     DCHECK(kind == Iterator::Kind::kDefault || core_.value)
         << "Must set value when creating non-default iterator";
@@ -7,6 +7,7 @@
 #ifndef CONTEXT_RESULT_H_
 #define CONTEXT_RESULT_H_
 
+#include <mutex>
 #include <vector>
 
 #include "context/Iterator.h"
@@ -29,11 +30,17 @@ public:
     static const Result& EmptyResult();
     static const std::vector<Result>& EmptyResultList();
 
+    // The whole value, which is shared by the views over it
     std::shared_ptr<Value> valuePtr() const {
         return core_.value;
     }
 
+    // The value seen through the iterator, i.e. only the selected rows if the
+    // iterator is a view, which are copied out once on the first access
     const Value& value() const {
+        if (core_.view) {
+            return core_.view->get(*core_.iter);
+        }
         return *core_.value;
     }
 
@@ -62,9 +69,41 @@ private:
     friend class ExecutionContext;
 
     Value&& moveValue() {
+        if (core_.view) {
+            core_.view->get(*core_.iter);
+            return std::move(*core_.view->value);
+        }
         return std::move(*core_.value);
     }
 
+    // The rows selected by a view, materialized on demand and shared by the
+    // copies of the result
+    struct View {
+        const Value& get(const Iterator& iter);
+
+        std::once_flag once;
+        std::shared_ptr<Value> value;
+        // The context which holds the result, the rows materialized are counted
+        // in its memory
+        ExecutionContext* ectx{nullptr};
+    };
+
+    // Drop the rows materialized before, the selection of the iterator may be
+    // changed through `iterRef()'
+    void resetView(ExecutionContext* ectx = nullptr) {
+        if (core_.iter && core_.iter->isView()) {
+            core_.view = std::make_shared<View>();
+            core_.view->ectx = ectx;
+        } else {
+            core_.view.reset();
+        }
+    }
+
+    // The rows materialized from the view, nullptr if there is none
+    std::shared_ptr<Value> viewValuePtr() const {
+        return core_.view ? core_.view->value : nullptr;
+    }
+
     struct Core {
         Core() = default;
         Core(Core &&) = default;
@@ -78,6 +117,7 @@ private:
                 msg = c.msg;
                 value = c.value;
                 iter = c.iter->copy();
+                view = c.view;
             }
             return *this;
         }
@@ -86,6 +126,7 @@ private:
         std::string msg;
         std::shared_ptr<Value> value;
         std::unique_ptr<Iterator> iter;
+        std::shared_ptr<View> view;
     };
 
     explicit Result(Core&& core) : core_(std::move(core)) {}
@@ -103,7 +144,9 @@ public:
     Result finish() {
         if (!core_.iter) iter(Iterator::Kind::kSequential);
         if (!core_.value && core_.iter) value(core_.iter->valuePtr());
-        return Result(std::move(core_));
+        Result result(std::move(core_));
+        result.resetView();
+        return result;
     }
 
     ResultBuilder& value(Value&& value) {
@@ -122,6 +122,13 @@ public:
         }
     }
 
+    // Clear the counts analyzed by the scheduler of the last execution
+    void resetUserCounts() {
+        for (auto& var : vars_) {
+            var.second->userCount.store(0, std::memory_order_relaxed);
+        }
+    }
+
     std::string toString() const;
 
 private:
@@ -55,6 +55,8 @@ struct PathContext final : AstContext {
 
     bool            isShortest{false};
     bool            isWeight{false};
+    // The edge property as the weight of the shortest paths
+    std::string     weightProp;
     bool            noLoop{false};
     bool            withProp{false};
 
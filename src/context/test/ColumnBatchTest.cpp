@@ -0,0 +1,125 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "context/ColumnBatch.h"
+#include "context/Iterator.h"
+
+namespace nebula {
+namespace graph {
+
+class ColumnBatchTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        DataSet ds;
+        ds.colNames = {"int", "float", "str", "bool", "mixed", "null"};
+        for (auto i = 0; i < 10; ++i) {
+            Row row;
+            row.values.emplace_back(i % 3 == 0 ? Value::kNullValue : Value(i));
+            row.values.emplace_back(i * 1.5);
+            row.values.emplace_back(folly::to<std::string>(i));
+            row.values.emplace_back(i % 2 == 0);
+            row.values.emplace_back(i % 2 == 0 ? Value(i) : Value(folly::to<std::string>(i)));
+            row.values.emplace_back(i % 2 == 0 ? Value::kNullValue : Value::kEmpty);
+            ds.rows.emplace_back(std::move(row));
+        }
+        value_ = std::make_shared<Value>(std::move(ds));
+    }
+
+protected:
+    std::shared_ptr<Value> value_;
+};
+
+TEST_F(ColumnBatchTest, TypedColumns) {
+    SequentialIter iter(value_);
+    auto batch = iter.columnBatch(0, iter.size(), {0, 1, 2, 3});
+    EXPECT_EQ(batch.begin(), 0);
+    EXPECT_EQ(batch.numRows(), 10);
+    EXPECT_EQ(batch.numCols(), 4);
+
+    auto& ints = batch.column(0);
+    EXPECT_EQ(ints.kind(), Column::Kind::kInt);
+    EXPECT_TRUE(ints.hasNull());
+    for (size_t i = 0; i < ints.size(); ++i) {
+        if (i % 3 == 0) {
+            EXPECT_TRUE(ints.isNull(i));
+            EXPECT_TRUE(ints.value(i).isNull());
+        } else {
+            EXPECT_FALSE(ints.isNull(i));
+            EXPECT_EQ(ints.ints()[i], i);
+        }
+    }
+
+    auto& floats = batch.column(1);
+    EXPECT_EQ(floats.kind(), Column::Kind::kFloat);
+    EXPECT_FALSE(floats.hasNull());
+    for (size_t i = 0; i < floats.size(); ++i) {
+        EXPECT_DOUBLE_EQ(floats.floats()[i], i * 1.5);
+    }
+
+    auto& strs = batch.column(2);
+    EXPECT_EQ(strs.kind(), Column::Kind::kString);
+    for (size_t i = 0; i < strs.size(); ++i) {
+        EXPECT_EQ(strs.strs()[i].str(), folly::to<std::string>(i));
+    }
+
+    auto& bools = batch.column(3);
+    EXPECT_EQ(bools.kind(), Column::Kind::kBool);
+    for (size_t i = 0; i < bools.size(); ++i) {
+        EXPECT_EQ(static_cast<bool>(bools.bools()[i]), i % 2 == 0);
+    }
+}
+
+TEST_F(ColumnBatchTest, UntypedColumns) {
+    SequentialIter iter(value_);
+    auto batch = iter.columnBatch(0, iter.size(), {4, 5});
+
+    auto& mixed = batch.column(0);
+    EXPECT_EQ(mixed.kind(), Column::Kind::kValue);
+    EXPECT_FALSE(mixed.hasNull());
+    EXPECT_EQ(mixed.value(2), Value(2));
+    EXPECT_EQ(mixed.value(3), Value("3"));
+
+    auto& nulls = batch.column(1);
+    EXPECT_EQ(nulls.kind(), Column::Kind::kNull);
+    EXPECT_EQ(nulls.nulls().count(), 10);
+    EXPECT_TRUE(nulls.value(0).isNull());
+    EXPECT_TRUE(nulls.value(1).empty());
+}
+
+TEST_F(ColumnBatchTest, Range) {
+    SequentialIter iter(value_);
+    auto batch = iter.columnBatch(4, 100, {0, 2});
+    EXPECT_EQ(batch.begin(), 4);
+    EXPECT_EQ(batch.numRows(), 6);
+    auto& ints = batch.column(0);
+    EXPECT_EQ(ints.kind(), Column::Kind::kInt);
+    EXPECT_EQ(ints.ints()[0], 4);
+    EXPECT_TRUE(ints.isNull(2));
+    EXPECT_EQ(batch.column(1).strs()[5].str(), "9");
+
+    auto empty = iter.columnBatch(10, 20, {0});
+    EXPECT_EQ(empty.numRows(), 0);
+    EXPECT_EQ(empty.column(0).kind(), Column::Kind::kNull);
+}
+
+TEST_F(ColumnBatchTest, Selection) {
+    SequentialIter iter(value_);
+    iter.select({9, 1, 4});
+    auto batch = iter.columnBatch(1, 100, {0, 2});
+    EXPECT_EQ(batch.begin(), 1);
+    EXPECT_EQ(batch.numRows(), 2);
+    auto& ints = batch.column(0);
+    EXPECT_EQ(ints.kind(), Column::Kind::kInt);
+    EXPECT_EQ(ints.ints()[0], 1);
+    EXPECT_EQ(ints.ints()[1], 4);
+    EXPECT_EQ(ints.value(1), Value(4));
+    EXPECT_EQ(batch.column(1).strs()[0].str(), "1");
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -7,6 +7,8 @@
 #include "context/ExecutionContext.h"
 
 #include <gtest/gtest.h>
+#include <numeric>
+
 #include "common/base/Base.h"
 
 namespace nebula {
@@ -60,5 +62,84 @@ TEST(ExecutionContextTest, TestResult) {
     EXPECT_TRUE(result.valuePtr()->isDataSet());
 }
 
+TEST(ExecutionContextTest, TestView) {
+    DataSet ds({"v"});
+    for (int64_t i = 0; i < 10; ++i) {
+        ds.rows.emplace_back(Row({i}));
+    }
+    ExecutionContext ctx;
+    ctx.setResult("input", ResultBuilder().value(Value(std::move(ds))).finish());
+
+    Result result = ctx.getResult("input");
+    static_cast<SequentialIter*>(result.iterRef())->select({3, 5});
+    ctx.setResult("output", std::move(result));
+
+    // The output sees the selected rows, and shares the rows with the input
+    auto& input = ctx.getResult("input");
+    auto& output = ctx.getResult("output");
+    EXPECT_EQ(input.valuePtr(), output.valuePtr());
+    EXPECT_EQ(input.value().getDataSet().rows.size(), 10);
+    auto& selected = output.value().getDataSet();
+    EXPECT_EQ(selected.colNames, std::vector<std::string>({"v"}));
+    ASSERT_EQ(selected.rows.size(), 2);
+    EXPECT_EQ(selected.rows[0].values[0], 3);
+    EXPECT_EQ(selected.rows[1].values[0], 5);
+    EXPECT_EQ(&selected, &ctx.getValue("output").getDataSet());
+}
+
+TEST(ExecutionContextTest, TestViewMemory) {
+    DataSet ds({"v"});
+    for (int64_t i = 0; i < 1000; ++i) {
+        ds.rows.emplace_back(Row({std::string(100, 'a')}));
+    }
+    ExecutionContext ctx;
+    ctx.setResult("input", ResultBuilder().value(Value(std::move(ds))).finish());
+    auto bytes = ctx.memory();
+
+    Result result = ctx.getResult("input");
+    std::vector<size_t> positions(500);
+    std::iota(positions.begin(), positions.end(), 0);
+    static_cast<SequentialIter*>(result.iterRef())->select(std::move(positions));
+    ctx.setResult("output", std::move(result));
+    // The view shares the rows
+    EXPECT_EQ(bytes, ctx.memory());
+
+    // The rows materialized are counted until the result is dropped
+    EXPECT_EQ(500, ctx.getValue("output").getDataSet().rows.size());
+    EXPECT_GT(ctx.memory(), bytes + 500 * 100);
+    ctx.dropResult("output");
+    EXPECT_EQ(bytes, ctx.memory());
+}
+
+TEST(ExecutionContextTest, TestMemory) {
+    DataSet ds({"v"});
+    for (int64_t i = 0; i < 1000; ++i) {
+        ds.rows.emplace_back(Row({std::string(100, 'a')}));
+    }
+    Value value(std::move(ds));
+    auto bytes = ExecutionContext::estimateMemory(value);
+    EXPECT_GT(bytes, 1000 * 100);
+    EXPECT_EQ(static_cast<int64_t>(sizeof(Value)), ExecutionContext::estimateMemory(Value(1)));
+
+    ExecutionContext ctx;
+    auto result = ResultBuilder().value(std::move(value)).finish();
+    // The value shared by the results is counted once
+    ctx.setResult("v1", ResultBuilder().value(result.valuePtr()).finish());
+    ctx.setResult("v2", std::move(result));
+    EXPECT_EQ(bytes, ctx.memory());
+
+    ctx.dropResult("v1");
+    EXPECT_EQ(bytes, ctx.memory());
+    ctx.dropResult("v2");
+    EXPECT_EQ(0, ctx.memory());
+    EXPECT_EQ(bytes, ctx.peakMemory());
+
+    ctx.setValue("v3", 1);
+    ctx.setValue("v3", 2);
+    ctx.truncHistory("v3", 1);
+    EXPECT_EQ(static_cast<int64_t>(sizeof(Value)), ctx.memory());
+    EXPECT_EQ(bytes, ctx.peakMemory());
+}
+
 }   // namespace graph
 }   // namespace nebula
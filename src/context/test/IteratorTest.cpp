@@ -519,6 +519,51 @@ TEST(IteratorTest, GetNeighbor) {
     }
 }
 
+TEST(IteratorTest, GetNeighborSharedIndex) {
+    // The datasets of the same column names share the index, the one of the
+    // different order of the props gets its own
+    auto makeDataSet = [](const std::string& edge, const std::string& vid, int64_t prop) {
+        DataSet ds;
+        ds.colNames = {kVid, "_stats", edge, "_expr"};
+        List props;
+        if (edge.find(":prop1:prop2") != std::string::npos) {
+            props.values = {prop, prop + 1};
+        } else {
+            props.values = {prop + 1, prop};
+        }
+        props.values.emplace_back("dst");
+        List edges;
+        edges.values.emplace_back(std::move(props));
+        Row row;
+        row.values = {vid, Value(), std::move(edges), Value()};
+        ds.rows.emplace_back(std::move(row));
+        return ds;
+    };
+    List datasets;
+    datasets.values.emplace_back(makeDataSet("_edge:+edge1:prop1:prop2:_dst", "0", 0));
+    datasets.values.emplace_back(makeDataSet("_edge:+edge1:prop2:prop1:_dst", "1", 10));
+    datasets.values.emplace_back(makeDataSet("_edge:+edge1:prop1:prop2:_dst", "2", 20));
+    auto val = std::make_shared<Value>(std::move(datasets));
+
+    GetNeighborsIter iter(val);
+    std::vector<Value> vids;
+    std::vector<Value> prop1;
+    std::vector<Value> prop2;
+    for (; iter.valid(); iter.next()) {
+        vids.emplace_back(iter.getColumn(kVid));
+        prop1.emplace_back(iter.getEdgeProp("edge1", "prop1"));
+        prop2.emplace_back(iter.getEdgeProp("edge1", "prop2"));
+        EXPECT_EQ(Value("dst"), iter.getEdgeProp("edge1", kDst));
+        // Each pair of the names is resolved on its own
+        EXPECT_EQ(prop1.back(), iter.getEdgeProp("*", "prop1"));
+        EXPECT_EQ(Value::kEmpty, iter.getEdgeProp("edge2", "prop1"));
+        EXPECT_EQ(Value::kEmpty, iter.getEdgeProp("edge1", "prop3"));
+    }
+    EXPECT_EQ(std::vector<Value>({"0", "1", "2"}), vids);
+    EXPECT_EQ(std::vector<Value>({0, 10, 20}), prop1);
+    EXPECT_EQ(std::vector<Value>({1, 11, 21}), prop2);
+}
+
 TEST(IteratorTest, TestHead) {
     {
         DataSet ds;
@@ -734,6 +779,110 @@ TEST(IteratorTest, EraseRange) {
     }
 }
 
+TEST(IteratorTest, Select) {
+    DataSet ds({"col1", "col2"});
+    for (auto i = 0; i < 10; ++i) {
+        ds.rows.emplace_back(Row({i, folly::to<std::string>(i)}));
+    }
+    auto val = std::make_shared<Value>(std::move(ds));
+    SequentialIter iter(val);
+    EXPECT_FALSE(iter.isView());
+    iter.select({1, 3, 5, 7, 9});
+    EXPECT_TRUE(iter.isView());
+    EXPECT_EQ(iter.size(), 5);
+    auto i = 1;
+    for (; iter.valid(); iter.next()) {
+        EXPECT_EQ(iter.getColumn("col1"), i);
+        EXPECT_EQ(iter.getColumn(1), folly::to<std::string>(i));
+        i += 2;
+    }
+    EXPECT_EQ(i, 11);
+
+    // Select again on the view, the positions are of the view
+    iter.select({0, 2, 4});
+    EXPECT_EQ(iter.size(), 3);
+    EXPECT_EQ(*iter.selection(), std::vector<size_t>({1, 5, 9}));
+
+    // Erase only drops the positions
+    iter.reset(1);
+    iter.erase();
+    EXPECT_EQ(iter.size(), 2);
+    EXPECT_EQ(iter.getColumn("col1"), 9);
+    iter.reset();
+    iter.unstableErase();
+    EXPECT_EQ(iter.size(), 1);
+    EXPECT_EQ(iter.getColumn("col1"), 9);
+
+    // The copy shares the rows but not the selection
+    auto copy = iter.copy();
+    iter.clear();
+    EXPECT_EQ(iter.size(), 0);
+    EXPECT_FALSE(iter.valid());
+    EXPECT_EQ(copy->size(), 1);
+    EXPECT_EQ(copy->getColumn("col1"), 9);
+
+    // The shared rows are untouched
+    EXPECT_EQ(val->getDataSet().rows.size(), 10);
+    for (auto j = 0; j < 10; ++j) {
+        EXPECT_EQ(val->getDataSet().rows[j].values[0], j);
+    }
+}
+
+TEST(IteratorTest, CopyOnWrite) {
+    DataSet ds({"col1"});
+    for (auto i = 0; i < 10; ++i) {
+        ds.rows.emplace_back(Row({i}));
+    }
+    auto val = std::make_shared<Value>(std::move(ds));
+    SequentialIter iter(val);
+    EXPECT_TRUE(iter.shared());
+
+    // Erasing the rows shared only drops them from the selection
+    iter.reset(2);
+    iter.erase();
+    EXPECT_TRUE(iter.isView());
+    EXPECT_EQ(iter.getColumn("col1"), 3);
+    iter.unstableErase();
+    EXPECT_EQ(iter.getColumn("col1"), 9);
+    iter.eraseRange(0, 2);
+    EXPECT_EQ(iter.size(), 6);
+    EXPECT_EQ(iter.getColumn("col1"), 9);
+    EXPECT_EQ(val->getDataSet().rows.size(), 10);
+    for (auto i = 0; i < 10; ++i) {
+        EXPECT_EQ(val->getDataSet().rows[i].values[0], i);
+    }
+
+    auto materialized = iter.materialize();
+    EXPECT_EQ(materialized.colNames, std::vector<std::string>({"col1"}));
+    ASSERT_EQ(materialized.rows.size(), 6);
+    EXPECT_EQ(materialized.rows[0].values[0], 9);
+
+    // The rows shared are copied rather than moved out
+    std::vector<Row> rows;
+    iter.appendRows(&rows);
+    EXPECT_EQ(rows.size(), 6);
+    EXPECT_EQ(rows[0].values[0], 9);
+    EXPECT_EQ(val->getDataSet().rows[9].values[0], 9);
+}
+
+TEST(IteratorTest, Exclusive) {
+    DataSet ds({"col1"});
+    for (auto i = 0; i < 10; ++i) {
+        ds.rows.emplace_back(Row({i}));
+    }
+    SequentialIter iter(std::make_shared<Value>(std::move(ds)));
+    EXPECT_FALSE(iter.shared());
+
+    // The rows owned by the iterator only are erased and moved out in place
+    iter.eraseRange(0, 5);
+    EXPECT_FALSE(iter.isView());
+    EXPECT_EQ(iter.valuePtr()->getDataSet().rows.size(), 5);
+    std::vector<Row> rows;
+    iter.appendRows(&rows);
+    EXPECT_EQ(rows.size(), 5);
+    EXPECT_EQ(rows[0].values[0], 5);
+}
+
 TEST(IteratorTest, VertexProp) {
     DataSet ds;
     ds.colNames = {kVid, "tag1.prop1", "tag2.prop1", "tag2.prop2", "tag3.prop1", "tag3.prop2"};
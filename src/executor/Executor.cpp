@@ -52,6 +52,7 @@
 #include "executor/algo/BFSShortestPathExecutor.h"
 #include "executor/algo/CartesianProductExecutor.h"
 #include "executor/algo/ConjunctPathExecutor.h"
+#include "executor/algo/DijkstraShortestPathExecutor.h"
 #include "executor/algo/ProduceAllPathsExecutor.h"
 #include "executor/algo/ProduceSemiShortestPathExecutor.h"
 #include "executor/algo/SubgraphExecutor.h"
@@ -72,6 +73,7 @@
 #include "executor/query/AssignExecutor.h"
 #include "executor/query/DataCollectExecutor.h"
 #include "executor/query/DedupExecutor.h"
+#include "executor/query/ExpandExecutor.h"
 #include "executor/query/FilterExecutor.h"
 #include "executor/query/GetEdgesExecutor.h"
 #include "executor/query/GetNeighborsExecutor.h"
@@ -82,6 +84,7 @@
 #include "executor/query/LeftJoinExecutor.h"
 #include "executor/query/LimitExecutor.h"
 #include "executor/query/MinusExecutor.h"
+#include "executor/query/PipelineExecutor.h"
 #include "executor/query/ProjectExecutor.h"
 #include "executor/query/SortExecutor.h"
 #include "executor/query/TopNExecutor.h"
@@ -121,7 +124,23 @@ Executor *Executor::makeExecutor(const PlanNode *node,
         return iter->second;
     }
 
-    Executor *exec = makeExecutor(qctx, node);
+    // The dependencies of the fused chain are those of its head
+    const PlanNode *head = node;
+    Executor *exec = nullptr;
+    if (FLAGS_enable_pipeline_execution && FLAGS_enable_lifetime_optimize) {
+        auto chain = PipelineExecutor::fusibleChain(node);
+        bool fusible = !chain.empty() &&
+                       std::none_of(chain.begin(), chain.end(), [visited](const PlanNode *n) {
+                           return visited->find(n->id()) != visited->end();
+                       });
+        if (fusible) {
+            head = chain.front();
+            exec = qctx->execPool()->add(new PipelineExecutor(node, qctx, std::move(chain)));
+        }
+    }
+    if (exec == nullptr) {
+        exec = makeExecutor(qctx, node);
+    }
 
     if (node->kind() == PlanNode::Kind::kSelect) {
         auto select = asNode<Select>(node);
@@ -137,8 +156,8 @@ Executor *Executor::makeExecutor(const PlanNode *node,
         loopExecutor->setLoopBody(body);
     }
 
-    for (size_t i = 0; i < node->numDeps(); ++i) {
-        exec->dependsOn(makeExecutor(node->dep(i), qctx, visited));
+    for (size_t i = 0; i < head->numDeps(); ++i) {
+        exec->dependsOn(makeExecutor(head->dep(i), qctx, visited));
     }
 
     visited->insert({node->id(), exec});
@@ -147,7 +166,7 @@ Executor *Executor::makeExecutor(const PlanNode *node,
 
 // static
 Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
-    auto pool = qctx->objPool();
+    auto pool = qctx->execPool();
     switch (node->kind()) {
         case PlanNode::Kind::kPassThrough: {
             return pool->add(new PassThroughExecutor(node, qctx));
@@ -173,6 +192,9 @@ Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
         case PlanNode::Kind::kGetNeighbors: {
             return pool->add(new GetNeighborsExecutor(node, qctx));
         }
+        case PlanNode::Kind::kExpand: {
+            return pool->add(new ExpandExecutor(node, qctx));
+        }
         case PlanNode::Kind::kLimit: {
             return pool->add(new LimitExecutor(node, qctx));
         }
@@ -419,6 +441,9 @@ Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
         case PlanNode::Kind::kBFSShortest: {
             return pool->add(new BFSShortestPathExecutor(node, qctx));
         }
+        case PlanNode::Kind::kDijkstraShortestPath: {
+            return pool->add(new DijkstraShortestPathExecutor(node, qctx));
+        }
         case PlanNode::Kind::kProduceSemiShortestPath: {
             return pool->add(new ProduceSemiShortestPathExecutor(node, qctx));
         }
@@ -552,6 +577,7 @@ Status Executor::open() {
             FLAGS_system_memory_high_watermark_ratio,
             mem->totalInKB());
     }
+    NG_RETURN_IF_ERROR(checkMemory());
     numRows_ = 0;
     execTime_ = 0;
     totalDuration_.reset();
@@ -559,6 +585,8 @@ Status Executor::open() {
 }
 
 Status Executor::close() {
+    // The peak memory of the query by the time
+    otherStats_.emplace("peak memory", folly::to<std::string>(ectx_->peakMemory()));
     ProfilingStats stats;
     stats.totalDurationInUs = totalDuration_.elapsedInUSec();
     stats.rows = numRows_;
@@ -604,13 +632,66 @@ Status Executor::finish(Result &&result) {
     if (FLAGS_enable_lifetime_optimize) {
         drop();
     }
-    return Status::OK();
+    return checkMemory();
 }
 
 Status Executor::finish(Value &&value) {
     return finish(ResultBuilder().value(std::move(value)).iter(Iterator::Kind::kDefault).finish());
 }
 
+Status Executor::checkMemory() const {
+    constexpr int64_t kMB = 1024 * 1024;
+    if (FLAGS_max_query_memory_mb > 0) {
+        auto memory = ectx_->memory();
+        if (memory > FLAGS_max_query_memory_mb * kMB) {
+            return Status::Error("Memory used by the query(%ldB) exceeds the limit(%ldMB).",
+                                 memory,
+                                 FLAGS_max_query_memory_mb);
+        }
+    }
+    auto rctx = qctx()->rctx();
+    if (FLAGS_max_session_memory_mb > 0 && rctx != nullptr && rctx->session() != nullptr) {
+        auto memory = rctx->session()->memory();
+        if (memory > FLAGS_max_session_memory_mb * kMB) {
+            return Status::Error("Memory used by the session(%ldB) exceeds the limit(%ldMB).",
+                                 memory,
+                                 FLAGS_max_session_memory_mb);
+        }
+    }
+    return Status::OK();
+}
+
+// static
+DataSet Executor::concatMorsels(std::vector<DataSet> &&morsels,
+                                std::vector<std::string> colNames) {
+    DataSet ds;
+    ds.colNames = std::move(colNames);
+    size_t size = 0;
+    for (auto &morsel : morsels) {
+        size += morsel.rows.size();
+    }
+    ds.rows.reserve(size);
+    for (auto &morsel : morsels) {
+        std::move(morsel.rows.begin(), morsel.rows.end(), std::back_inserter(ds.rows));
+    }
+    return ds;
+}
+
+size_t Executor::numJobs(size_t size) const {
+    size_t minBatchSize = std::max<uint32_t>(FLAGS_min_batch_size, 1);
+    size_t jobs = std::min<size_t>(std::max<uint32_t>(FLAGS_max_job_size, 1), size / minBatchSize);
+    return std::max<size_t>(jobs, 1);
+}
+
+Executor::JobExprs::JobExprs(QueryContext *qctx, std::vector<Expression *> exprs)
+    : qctx_(DCHECK_NOTNULL(qctx)),
+      exprs_(std::move(exprs)),
+      clones_(qctx_->lendClones(exprs_)) {}
+
+Executor::JobExprs::~JobExprs() {
+    qctx_->giveBackClones(exprs_, clones_);
+}
+
 folly::Executor *Executor::runner() const {
     if (!qctx() || !qctx()->rctx() || !qctx()->rctx()->runner()) {
         // This is just for test
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include <folly/futures/Future.h>
+#include <folly/futures/helpers.h>
 
 #include "common/base/Status.h"
 #include "common/cpp/helpers.h"
@@ -21,6 +22,9 @@
 #include "util/ScopedTimer.h"
 
 namespace nebula {
+
+class Expression;
+
 namespace graph {
 
 class PlanNode;
@@ -97,13 +101,66 @@ protected:
 
     folly::Executor *runner() const;
 
-    void drop();
+    // The number of the jobs the input of `size' rows is split into
+    size_t numJobs(size_t size) const;
+
+    // Split the rows [0, size) into morsels and run `scatter(begin, end)' of each
+    // morsel concurrently by the runner. The results are in the order of morsels.
+    // `scatter' evaluates the clones of the expressions as the kernels of runMorsels do.
+    template <typename T>
+    folly::Future<std::vector<T>> runMultiJobs(size_t size,
+                                               std::function<T(size_t, size_t)> scatter) const;
+
+    // Whether the rows of `iter' are many enough to be split into morsels, only the
+    // sequential iterators are since their rows are addressed by the positions
+    bool splittable(const Iterator *iter) const {
+        return (iter->isSequentialIter() || iter->isPropIter()) && numJobs(iter->size()) > 1;
+    }
+
+    // Run `kernel(morsel, begin, end)' over the morsels of the rows of `iter' by
+    // runMultiJobs, where `morsel' is a copy of `iter' positioned at `begin'. The
+    // copies share the rows, so the kernels should not erase them. The expressions
+    // keep the evaluation states, so each kernel evaluates the JobExprs of them.
+    template <typename T>
+    folly::Future<std::vector<T>> runMorsels(
+        std::shared_ptr<Iterator> iter,
+        std::function<T(Iterator *, size_t, size_t)> kernel) const;
+
+    // The clones of the expressions lent to a job by the query context, which are
+    // given back once the job is done
+    class JobExprs final : private cpp::NonCopyable, private cpp::NonMovable {
+    public:
+        JobExprs(QueryContext *qctx, std::vector<Expression *> exprs);
+        ~JobExprs();
+
+        const std::vector<Expression *> &clones() const {
+            return clones_;
+        }
+
+        Expression *operator[](size_t i) const {
+            return clones_[i];
+        }
+
+    private:
+        QueryContext *qctx_;
+        std::vector<Expression *> exprs_;
+        std::vector<Expression *> clones_;
+    };
+
+    // Concatenate the rows got by the morsels in order
+    static DataSet concatMorsels(std::vector<DataSet> &&morsels,
+                                 std::vector<std::string> colNames);
+
+    virtual void drop();
 
     // Store the result of this executor to execution context
     Status finish(Result &&result);
     // Store the default result which not used for later executor
     Status finish(Value &&value);
 
+    // Fail the query once its results take more memory than the limit
+    Status checkMemory() const;
+
     int64_t id_;
 
     // Executor name
@@ -127,6 +184,34 @@ protected:
     std::unordered_map<std::string, std::string> otherStats_;
 };
 
+template <typename T>
+folly::Future<std::vector<T>> Executor::runMultiJobs(
+    size_t size,
+    std::function<T(size_t, size_t)> scatter) const {
+    auto jobs = numJobs(size);
+    auto batchSize = (size + jobs - 1) / jobs;
+    std::vector<folly::Future<T>> futures;
+    futures.reserve(jobs);
+    for (size_t begin = 0; begin < size; begin += batchSize) {
+        auto end = std::min(begin + batchSize, size);
+        futures.emplace_back(
+            folly::via(runner(), [scatter, begin, end]() { return scatter(begin, end); }));
+    }
+    return folly::collect(futures).via(runner());
+}
+
+template <typename T>
+folly::Future<std::vector<T>> Executor::runMorsels(
+    std::shared_ptr<Iterator> iter,
+    std::function<T(Iterator *, size_t, size_t)> kernel) const {
+    auto size = iter->size();
+    return runMultiJobs<T>(size, [iter, kernel](size_t begin, size_t end) {
+        auto morsel = iter->copy();
+        morsel->reset(begin);
+        return kernel(morsel.get(), begin, end);
+    });
+}
+
 }   // namespace graph
 }   // namespace nebula
 
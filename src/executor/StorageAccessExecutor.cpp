@@ -6,6 +6,7 @@
 
 #include "executor/StorageAccessExecutor.h"
 
+#include "common/datatypes/List.h"
 #include "common/interface/gen-cpp2/meta_types.h"
 #include "context/Iterator.h"
 #include "context/QueryExpressionContext.h"
@@ -69,6 +70,23 @@ bool StorageAccessExecutor::isIntVidType(const SpaceInfo &space) const {
     return (*space.spaceDesc.vid_type_ref()).type == meta::cpp2::PropertyType::INT64;
 }
 
+// static
+List StorageAccessExecutor::moveVertices(
+    storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse> &rpcResp) {
+    auto &responses = rpcResp.responses();
+    List list;
+    list.values.reserve(responses.size());
+    for (auto &resp : responses) {
+        auto vertices = resp.vertices_ref();
+        if (!vertices.has_value()) {
+            VLOG(1) << "Empty dataset in response";
+            continue;
+        }
+        list.values.emplace_back(std::move(*vertices));
+    }
+    return list;
+}
+
 DataSet StorageAccessExecutor::buildRequestDataSetByVidType(Iterator *iter,
                                                             Expression *expr,
                                                             bool dedup) {
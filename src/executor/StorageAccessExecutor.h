@@ -9,6 +9,7 @@
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include "common/clients/storage/StorageClientBase.h"
+#include "common/interface/gen-cpp2/storage_types.h"
 #include "context/QueryContext.h"
 #include "executor/Executor.h"
 
@@ -138,6 +139,11 @@ protected:
 
     bool isIntVidType(const SpaceInfo &space) const;
 
+    // Move the datasets of the responses of GetNeighbors into a list, rather than
+    // copying them through the const getter of the thrift field
+    static List moveVertices(
+        storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse> &rpcResp);
+
     DataSet buildRequestDataSetByVidType(Iterator *iter, Expression *expr, bool dedup);
 };
 
@@ -35,6 +35,7 @@ folly::Future<Status> ShowQueriesExecutor::showCurrentSessionQueries() {
                      "Host",
                      "StartTime",
                      "DurationInUSec",
+                     "PeakMemoryInBytes",
                      "Status",
                      "Query"});
     auto* session = qctx()->rctx()->session();
@@ -64,6 +65,7 @@ folly::Future<Status> ShowQueriesExecutor::showAllSessionQueries() {
                                  "Host",
                                  "StartTime",
                                  "DurationInUSec",
+                                 "PeakMemoryInBytes",
                                  "Status",
                                  "Query"});
                 for (auto& session : sessions) {
@@ -77,6 +79,12 @@ folly::Future<Status> ShowQueriesExecutor::showAllSessionQueries() {
 }
 
 void ShowQueriesExecutor::addQueries(const meta::cpp2::Session& session, DataSet& dataSet) const {
+    // The memory is only known by the graphd running the query
+    std::shared_ptr<ClientSession> localSession;
+    auto rctx = qctx()->rctx();
+    if (rctx != nullptr && rctx->sessionMgr() != nullptr) {
+        localSession = rctx->sessionMgr()->findSessionFromCache(session.get_session_id());
+    }
     auto& queries = session.get_queries();
     for (auto& query : queries) {
         Row row;
@@ -89,6 +97,12 @@ void ShowQueriesExecutor::addQueries(const meta::cpp2::Session& session, DataSet
         dateTime.microsec = query.second.get_start_time() % 1000000;
         row.values.emplace_back(std::move(dateTime));
         row.values.emplace_back(query.second.get_duration());
+        auto peakMemory = localSession == nullptr ? -1 : localSession->peakMemory(query.first);
+        if (peakMemory >= 0) {
+            row.values.emplace_back(peakMemory);
+        } else {
+            row.values.emplace_back(Value::kNullValue);
+        }
         row.values.emplace_back(apache::thrift::util::enumNameSafe(query.second.get_status()));
         row.values.emplace_back(query.second.get_query());
         dataSet.rows.emplace_back(std::move(row));
@@ -28,13 +28,13 @@ folly::Future<Status> BFSShortestPathExecutor::execute() {
             continue;
         }
         auto& edge = edgeVal.getEdge();
-        auto visited = visited_.find(edge.dst) != visited_.end();
+        auto visited = visited_.find(edge.dst) != VidDict::kNone;
         if (visited) {
             continue;
         }
 
         // save the starts.
-        visited_.emplace(edge.src);
+        visited_.intern(edge.src);
         VLOG(1) << "dst: " << edge.dst << " edge: " << edge;
         interim.emplace(edge.dst, std::move(edgeVal));
     }
@@ -45,7 +45,7 @@ folly::Future<Status> BFSShortestPathExecutor::execute() {
         row.values.emplace_back(dst);
         row.values.emplace_back(std::move(edge));
         ds.rows.emplace_back(std::move(row));
-        visited_.emplace(dst);
+        visited_.intern(dst);
     }
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
@@ -8,6 +8,7 @@
 #define EXECUTOR_ALGO_BFSSHORTESTPATHEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/VidDict.h"
 
 namespace nebula {
 namespace graph {
@@ -19,7 +20,7 @@ public:
     folly::Future<Status> execute() override;
 
 private:
-    std::unordered_set<Value>               visited_;
+    VidDict                                 visited_;
 };
 }  // namespace graph
 }  // namespace nebula
@@ -5,10 +5,20 @@
  */
 #include "executor/algo/ConjunctPathExecutor.h"
 
+#include <limits>
+
+#include "executor/algo/ProduceAllPathsExecutor.h"
 #include "planner/plan/Algo.h"
 
 namespace nebula {
 namespace graph {
+
+namespace {
+
+constexpr size_t kNoMeet = std::numeric_limits<size_t>::max();
+
+}   // namespace
+
 folly::Future<Status> ConjunctPathExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* conjunct = asNode<ConjunctPath>(node());
@@ -26,12 +36,10 @@ folly::Future<Status> ConjunctPathExecutor::execute() {
 
 folly::Future<Status> ConjunctPathExecutor::bfsShortestPath() {
     auto* conjunct = asNode<ConjunctPath>(node());
-    auto lIter = ectx_->getResult(conjunct->leftInputVar()).iter();
-    const auto& rHist = ectx_->getHistory(conjunct->rightInputVar());
+    const auto& leftVar = conjunct->leftInputVar();
+    const auto& rightVar = conjunct->rightInputVar();
     VLOG(1) << "current: " << node()->outputVar();
-    VLOG(1) << "left input: " << conjunct->leftInputVar()
-            << " right input: " << conjunct->rightInputVar();
-    DCHECK(!!lIter);
+    VLOG(1) << "left input: " << leftVar << " right input: " << rightVar;
 
     auto steps = conjunct->steps();
     count_++;
@@ -39,142 +47,179 @@ folly::Future<Status> ConjunctPathExecutor::bfsShortestPath() {
     DataSet ds;
     ds.colNames = conjunct->colNames();
 
-    VLOG(1) << "forward, size: " << forward_.size();
-    VLOG(1) << "backward, size: " << backward_.size();
-    forward_.emplace_back();
-    for (; lIter->valid(); lIter->next()) {
-        auto& dst = lIter->getColumn(kVid);
-        auto& edge = lIter->getColumn(kEdgeStr);
-        VLOG(1) << "dst: " << dst << " edge: " << edge;
-        if (!edge.isEdge()) {
-            forward_.back().emplace(Value(dst), nullptr);
-        } else {
-            forward_.back().emplace(Value(dst), &edge.getEdge());
-        }
+    if (count_ == 1) {
+        // The first versions of the inputs are the starts
+        addBfsLayer(ectx_->getHistory(leftVar).front(), &forward_);
+        addBfsLayer(ectx_->getHistory(rightVar).front(), &backward_);
+    }
+    if (forward_.layers.empty() || backward_.layers.empty()) {
+        setBfsFrontier(leftVar, nullptr);
+        setBfsFrontier(rightVar, nullptr);
+        return finish(ResultBuilder().value(Value(std::move(ds))).finish());
     }
+    // The side not expanded in this round has no new vids
+    bool forwardAdded = addBfsLayer(ectx_->getResult(leftVar), &forward_);
+    bool backwardAdded = addBfsLayer(ectx_->getResult(rightVar), &backward_);
+    VLOG(1) << "forward layers: " << forward_.layers.size()
+            << " backward layers: " << backward_.layers.size();
+
+    // The new vids are checked against all the vids visited by the other side,
+    // so the shortest paths are found in the first round that the sides meet
+    auto forwardLength = forwardAdded ? minMeetLength(forward_, backward_) : kNoMeet;
+    auto backwardLength = backwardAdded ? minMeetLength(backward_, forward_) : kNoMeet;
+    auto length = std::min(forwardLength, backwardLength);
+    if (length <= steps) {
+        VLOG(1) << "Meet, length: " << length;
+        std::vector<uint32_t> meets;
+        auto forwardLast = forward_.layers.size() - 1;
+        auto backwardLast = backward_.layers.size() - 1;
+        if (forwardLength == length) {
+            for (auto id : forward_.layers.back()) {
+                auto index = backward_.layerOf(id);
+                if (index != BfsSide::kNotVisited && forwardLast + index == length) {
+                    meets.emplace_back(id);
+                }
+            }
+        }
+        if (backwardLength == length) {
+            for (auto id : backward_.layers.back()) {
+                auto index = forward_.layerOf(id);
+                if (index == BfsSide::kNotVisited || backwardLast + index != length) {
+                    continue;
+                }
+                if (forwardLength == length && index == forwardLast) {
+                    // Met in the last forward layer too
+                    continue;
+                }
+                meets.emplace_back(id);
+            }
+        }
 
-    bool isLatest = false;
-    if (rHist.size() >= 2) {
-        auto previous = rHist[rHist.size() - 2].iter();
-        VLOG(1) << "Find odd length path.";
-        auto rows = findBfsShortestPath(previous.get(), isLatest, forward_.back());
-        if (!rows.empty()) {
-            VLOG(1) << "Meet odd length path.";
-            ds.rows = std::move(rows);
-            return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+        for (auto id : meets) {
+            auto forwardPaths = buildBfsPaths(forward_, id, forward_.layerOf(id));
+            auto backwardPaths = buildBfsPaths(backward_, id, backward_.layerOf(id));
+            for (auto& forwardPath : forwardPaths) {
+                forwardPath.reverse();
+                for (auto& backwardPath : backwardPaths) {
+                    Path result = forwardPath;
+                    result.append(backwardPath);
+                    Row row;
+                    row.emplace_back(std::move(result));
+                    ds.rows.emplace_back(std::move(row));
+                }
+            }
         }
+        setBfsFrontier(leftVar, nullptr);
+        setBfsFrontier(rightVar, nullptr);
+        return finish(ResultBuilder().value(Value(std::move(ds))).finish());
     }
 
-    if (count_ * 2 <= steps) {
-        auto latest = rHist.back().iter();
-        isLatest = true;
-        backward_.emplace_back();
-        VLOG(1) << "Find even length path.";
-        auto rows = findBfsShortestPath(latest.get(), isLatest, forward_.back());
-        if (!rows.empty()) {
-            VLOG(1) << "Meet even length path.";
-            ds.rows = std::move(rows);
-        }
+    // Stop once either side has nothing new to expand, since the sides could not
+    // meet any more, or once the paths would be longer than the steps
+    bool exhausted = (forward_.expanding && !forwardAdded) ||
+                     (backward_.expanding && !backwardAdded);
+    auto depth = forward_.layers.size() - 1 + backward_.layers.size() - 1;
+    if (exhausted || length != kNoMeet || depth >= steps) {
+        forward_.expanding = false;
+        backward_.expanding = false;
+    } else {
+        // Only expand the side with fewer vids to visit, instead of the both in
+        // lockstep, since the neighbors of the other side are likely many more
+        forward_.expanding = forward_.layers.back().size() <= backward_.layers.back().size();
+        backward_.expanding = !forward_.expanding;
     }
+    VLOG(1) << "Expand forward: " << forward_.expanding << " backward: " << backward_.expanding;
+    setBfsFrontier(leftVar, forward_.expanding ? &forward_ : nullptr);
+    setBfsFrontier(rightVar, backward_.expanding ? &backward_ : nullptr);
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
-std::vector<Row> ConjunctPathExecutor::findBfsShortestPath(
-    Iterator* iter,
-    bool isLatest,
-    std::unordered_multimap<Value, const Edge*>& table) {
-    std::unordered_set<Value> meets;
-    for (; iter->valid(); iter->next()) {
-        auto& dst = iter->getColumn(kVid);
-        if (isLatest) {
-            auto& edge = iter->getColumn(kEdgeStr);
-            VLOG(1) << "dst: " << dst << " edge: " << edge;
-            if (!edge.isEdge()) {
-                backward_.back().emplace(dst, nullptr);
-            } else {
-                backward_.back().emplace(dst, &edge.getEdge());
-            }
+bool ConjunctPathExecutor::addBfsLayer(const Result& result, BfsSide* side) {
+    auto index = side->layers.size();
+    std::vector<uint32_t> layer;
+    for (auto iter = result.iter(); iter->valid(); iter->next()) {
+        auto id = vids_.intern(iter->getColumn(kVid)).first;
+        if (side->visited.size() <= id) {
+            side->visited.resize(vids_.size(), BfsSide::kNotVisited);
+            side->edges.resize(vids_.size());
+        }
+        auto& visited = side->visited[id];
+        if (visited == BfsSide::kNotVisited) {
+            visited = index;
+            layer.emplace_back(id);
+        } else if (visited != index) {
+            // Visited in the previous layers
+            continue;
+        }
+        auto& edge = iter->getColumn(kEdgeStr);
+        if (edge.isEdge()) {
+            side->edges[id].emplace_back(&edge.getEdge());
         }
-        if (table.find(dst) != table.end()) {
-            meets.emplace(dst);
+    }
+    if (layer.empty()) {
+        return false;
+    }
+    side->layers.emplace_back(std::move(layer));
+    return true;
+}
+
+// static
+size_t ConjunctPathExecutor::minMeetLength(const BfsSide& side, const BfsSide& other) {
+    auto last = side.layers.size() - 1;
+    auto length = kNoMeet;
+    for (auto id : side.layers.back()) {
+        auto index = other.layerOf(id);
+        if (index != BfsSide::kNotVisited) {
+            length = std::min(length, last + index);
         }
     }
+    return length;
+}
 
-    std::vector<Row> rows;
-    if (!meets.empty()) {
-        VLOG(1) << "Build forward, size: " << forward_.size();
-        auto forwardPath = buildBfsInterimPath(meets, forward_);
-        VLOG(1) << "Build backward, size: " << backward_.size();
-        auto backwardPath = buildBfsInterimPath(meets, backward_);
-        for (auto& p : forwardPath) {
-            auto range = backwardPath.equal_range(p.first);
-            for (auto& i = range.first; i != range.second; ++i) {
-                Path result = p.second;
-                result.reverse();
-                VLOG(1) << "Forward path: " << result;
-                VLOG(1) << "Backward path: " << i->second;
-                result.append(i->second);
-                Row row;
-                row.emplace_back(std::move(result));
-                rows.emplace_back(std::move(row));
+std::vector<Path> ConjunctPathExecutor::buildBfsPaths(const BfsSide& side,
+                                                      uint32_t id,
+                                                      size_t layer) const {
+    Path start;
+    start.src = Vertex(vids_.vid(id), {});
+    std::vector<Path> paths = {std::move(start)};
+    // The id of the last vid of each path
+    std::vector<uint32_t> ends = {id};
+    // Walk back to the start through the layers
+    for (auto i = layer; i > 0; --i) {
+        std::vector<Path> interimPaths;
+        std::vector<uint32_t> interimEnds;
+        for (size_t j = 0; j < paths.size(); ++j) {
+            for (auto* edge : side.edges[ends[j]]) {
+                Path p = paths[j];
+                p.steps.emplace_back(
+                    Step(Vertex(edge->src, {}), -edge->type, edge->name, edge->ranking, {}));
+                interimPaths.emplace_back(std::move(p));
+                auto src = vids_.find(edge->src);
+                DCHECK_NE(src, VidDict::kNone);
+                interimEnds.emplace_back(src);
             }
         }
+        paths = std::move(interimPaths);
+        ends = std::move(interimEnds);
     }
-    return rows;
+    return paths;
 }
 
-std::unordered_multimap<Value, Path> ConjunctPathExecutor::buildBfsInterimPath(
-    std::unordered_set<Value>& meets,
-    std::vector<std::unordered_multimap<Value, const Edge*>>& hists) {
-    std::unordered_multimap<Value, Path> results;
-    for (auto& v : meets) {
-        VLOG(1) << "Meet at: " << v;
-        Path start;
-        start.src = Vertex(v, {});
-        if (hists.empty()) {
-            // Happens at one step path situation when meet at starts
-            VLOG(1) << "Start: " << start;
-            results.emplace(v, std::move(start));
-            continue;
+void ConjunctPathExecutor::setBfsFrontier(const std::string& var, const BfsSide* side) {
+    DataSet ds;
+    ds.colNames = {kVid, kEdgeStr};
+    if (side != nullptr) {
+        auto& layer = side->layers.back();
+        ds.rows.reserve(layer.size());
+        for (auto id : layer) {
+            Row row;
+            row.values = {vids_.vid(id), Value::kEmpty};
+            ds.rows.emplace_back(std::move(row));
         }
-        std::vector<Path> interimPaths = {std::move(start)};
-        for (auto hist = hists.rbegin(); hist < hists.rend(); ++hist) {
-            std::vector<Path> tmp;
-            for (auto& interimPath : interimPaths) {
-                Value id;
-                if (interimPath.steps.empty()) {
-                    id = interimPath.src.vid;
-                } else {
-                    id = interimPath.steps.back().dst.vid;
-                }
-                auto edges = hist->equal_range(id);
-                for (auto i = edges.first; i != edges.second; ++i) {
-                    Path p = interimPath;
-                    if (i->second != nullptr) {
-                        auto& edge = *(i->second);
-                        VLOG(1) << "Edge: " << edge;
-                        VLOG(1) << "Interim path: " << interimPath;
-                        p.steps.emplace_back(
-                            Step(Vertex(edge.src, {}), -edge.type, edge.name, edge.ranking, {}));
-                        VLOG(1) << "New semi path: " << p;
-                    }
-                    if (hist == (hists.rend() - 1)) {
-                        VLOG(1) << "emplace result: " << p.src.vid;
-                        results.emplace(p.src.vid, std::move(p));
-                    } else {
-                        tmp.emplace_back(std::move(p));
-                    }
-                }   // `edge'
-            }       // `interimPath'
-            if (hist != (hists.rend() - 1)) {
-                interimPaths = std::move(tmp);
-            }
-        }   // `hist'
-    }       // `v'
-    return results;
+    }
+    ectx_->setResult(var, ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
-
 folly::Future<Status> ConjunctPathExecutor::floydShortestPath() {
     auto* conjunct = asNode<ConjunctPath>(node());
     conditionalVar_ = conjunct->conditionalVar();
@@ -307,92 +352,94 @@ void ConjunctPathExecutor::delPathFromConditionalVar(const Value& start, const V
 folly::Future<Status> ConjunctPathExecutor::allPaths() {
     auto* conjunct = asNode<ConjunctPath>(node());
     noLoop_ = conjunct->noLoop();
-    auto lIter = ectx_->getResult(conjunct->leftInputVar()).iter();
+    const auto& lHist = ectx_->getHistory(conjunct->leftInputVar());
     const auto& rHist = ectx_->getHistory(conjunct->rightInputVar());
     VLOG(1) << "current: " << node()->outputVar();
     VLOG(1) << "left input: " << conjunct->leftInputVar()
             << " right input: " << conjunct->rightInputVar();
     VLOG(1) << "right hist size: " << rHist.size();
-    DCHECK(!!lIter);
+    DCHECK(!lHist.empty());
     auto steps = conjunct->steps();
     count_++;
 
     DataSet ds;
     ds.colNames = conjunct->colNames();
 
-    std::unordered_map<Value, const List&> table;
-    for (; lIter->valid(); lIter->next()) {
-        auto& dst = lIter->getColumn(kVid);
-        auto& path = lIter->getColumn(kPathStr);
-        if (path.isList()) {
+    ForwardPaths forwardPaths;
+    forwardPaths.hist = &lHist;
+    if (lHist.back().value().isDataSet()) {
+        const auto& rows = lHist.back().value().getDataSet().rows;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const auto& dst = rows[i].values[ProduceAllPathsExecutor::kVidCol];
             VLOG(1) << "Forward dst: " << dst;
-            table.emplace(dst, path.getList());
+            forwardPaths.nodes[dst].emplace_back(i);
         }
     }
 
     if (rHist.size() >= 2) {
         VLOG(1) << "Find odd length path.";
-        auto previous = rHist[rHist.size() - 2].iter();
-        findAllPaths(previous.get(), table, ds);
+        findAllPaths(rHist, rHist.size() - 2, forwardPaths, ds);
     }
 
     if (count_ * 2 <= steps) {
         VLOG(1) << "Find even length path.";
-        auto latest = rHist.back().iter();
-        findAllPaths(latest.get(), table, ds);
+        findAllPaths(rHist, rHist.size() - 1, forwardPaths, ds);
     }
 
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
-bool ConjunctPathExecutor::findAllPaths(Iterator* backwardPathsIter,
-                                        std::unordered_map<Value, const List&>& forwardPathsTable,
+bool ConjunctPathExecutor::findAllPaths(const std::vector<Result>& backwardHist,
+                                        size_t version,
+                                        ForwardPaths& forwardPaths,
                                         DataSet& ds) {
     bool found = false;
-    for (; backwardPathsIter->valid(); backwardPathsIter->next()) {
-        auto& dst = backwardPathsIter->getColumn(kVid);
+    if (!backwardHist[version].value().isDataSet()) {
+        return found;
+    }
+    const auto& rows = backwardHist[version].value().getDataSet().rows;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        auto& dst = rows[i].values[ProduceAllPathsExecutor::kVidCol];
         VLOG(1) << "Backward dst: " << dst;
-        auto& pathList = backwardPathsIter->getColumn(kPathStr);
-        if (!pathList.isList()) {
+        auto forwardNodes = forwardPaths.nodes.find(dst);
+        if (forwardNodes == forwardPaths.nodes.end()) {
             continue;
         }
-        for (const auto& path : pathList.getList().values) {
-            if (!path.isPath()) {
+        // Only the paths met are built from the prefix trees
+        auto backward = ProduceAllPathsExecutor::buildPath(backwardHist, version, i);
+        auto backwardSrc = backward.src;
+        VLOG(1) << "Backward path:" << backward;
+        backward.reverse();
+        VLOG(1) << "Backward reverse path:" << backward;
+
+        auto forwardVersion = forwardPaths.hist->size() - 1;
+        for (auto node : forwardNodes->second) {
+            auto cached = forwardPaths.paths.find(node);
+            if (cached == forwardPaths.paths.end()) {
+                auto path = ProduceAllPathsExecutor::buildPath(
+                    *forwardPaths.hist, forwardVersion, node);
+                cached = forwardPaths.paths.emplace(node, std::move(path)).first;
+            }
+            const auto& forward = cached->second;
+            if (forward.src == backwardSrc) {
                 continue;
             }
-            auto forwardPaths = forwardPathsTable.find(dst);
-            if (forwardPaths == forwardPathsTable.end()) {
+            VLOG(1) << "Forward path:" << forward;
+            Path path = forward;
+            path.append(backward);
+            if (path.hasDuplicateEdges()) {
                 continue;
             }
-
-            for (const auto& i : forwardPaths->second.values) {
-                if (!i.isPath()) {
-                    continue;
-                }
-                Row row;
-                auto forward = i.getPath();
-                Path backward = path.getPath();
-                if (forward.src == backward.src) {
-                    continue;
-                }
-                VLOG(1) << "Forward path:" << forward;
-                VLOG(1) << "Backward path:" << backward;
-                backward.reverse();
-                VLOG(1) << "Backward reverse path:" << backward;
-                forward.append(std::move(backward));
-                if (forward.hasDuplicateEdges()) {
-                    continue;
-                }
-                if (noLoop_ && forward.hasDuplicateVertices()) {
-                    continue;
-                }
-                VLOG(1) << "Found path: " << forward;
-                row.values.emplace_back(std::move(forward));
-                ds.rows.emplace_back(std::move(row));
-            }  // `i'
-            found = true;
-        }  // `path'
-    }  // `backwardPathsIter'
+            if (noLoop_ && path.hasDuplicateVertices()) {
+                continue;
+            }
+            VLOG(1) << "Found path: " << path;
+            Row row;
+            row.values.emplace_back(std::move(path));
+            ds.rows.emplace_back(std::move(row));
+        }  // `node'
+        found = true;
+    }  // `i'
     return found;
 }
 
@@ -8,6 +8,7 @@
 #define EXECUTOR_ALGO_CONJUNCTPATHEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/VidDict.h"
 
 namespace nebula {
 namespace graph {
@@ -31,13 +32,40 @@ private:
 
     folly::Future<Status> allPaths();
 
-    std::vector<Row> findBfsShortestPath(Iterator* iter,
-                                         bool isLatest,
-                                         std::unordered_multimap<Value, const Edge*>& table);
+    // The vids visited by one side of the bidirectional BFS, in layers, by the
+    // ids interned into `vids_'
+    struct BfsSide {
+        static constexpr size_t kNotVisited = std::numeric_limits<size_t>::max();
 
-    std::unordered_multimap<Value, Path> buildBfsInterimPath(
-        std::unordered_set<Value>& meets,
-        std::vector<std::unordered_multimap<Value, const Edge*>>& hist);
+        // The index of the layer where the vid is visited
+        std::vector<size_t>                         visited;
+        // The edges from the previous layer to the vid
+        std::vector<std::vector<const Edge*>>       edges;
+        // The vids of each layer
+        std::vector<std::vector<uint32_t>>          layers;
+        // Whether the side is expanded in the current round
+        bool                                        expanding{true};
+
+        size_t layerOf(uint32_t id) const {
+            return id < visited.size() ? visited[id] : kNotVisited;
+        }
+    };
+
+    // Add the new vids of `result' as the next layer of `side'. Return false if
+    // there is none.
+    bool addBfsLayer(const Result& result, BfsSide* side);
+
+    // The length of the shortest paths through the vids of the last layer of
+    // `side' which are visited by `other' too
+    static size_t minMeetLength(const BfsSide& side, const BfsSide& other);
+
+    // The paths from the start of `side' to the vid `id', which is in the layer
+    // `layer'
+    std::vector<Path> buildBfsPaths(const BfsSide& side, uint32_t id, size_t layer) const;
+
+    // Set the vids of the last layer of `side' as the input of the next round,
+    // or nothing if `side' is nullptr
+    void setBfsFrontier(const std::string& var, const BfsSide* side);
 
     folly::Future<Status> floydShortestPath();
 
@@ -48,14 +76,27 @@ private:
                         Value& cost,
                         DataSet& ds);
 
-    bool findAllPaths(Iterator* backwardPathsIter,
-                      std::unordered_map<Value, const List&>& forwardPathsTable,
+    // The paths found by the forward side in the current round
+    struct ForwardPaths {
+        const std::vector<Result>*                          hist{nullptr};
+        // The rows of the last version of the history, by the dst
+        std::unordered_map<Value, std::vector<size_t>>      nodes;
+        // The paths built from the rows
+        std::unordered_map<size_t, Path>                    paths;
+    };
+
+    // Conjunct the forward paths with the backward ones in the version `version'
+    // of `backwardHist', which are kept as the prefix trees by ProduceAllPaths.
+    bool findAllPaths(const std::vector<Result>& backwardHist,
+                      size_t version,
+                      ForwardPaths& forwardPaths,
                       DataSet& ds);
     void delPathFromConditionalVar(const Value& start, const Value& end);
 
 private:
-    std::vector<std::unordered_multimap<Value, const Edge*>> forward_;
-    std::vector<std::unordered_multimap<Value, const Edge*>> backward_;
+    VidDict vids_;
+    BfsSide forward_;
+    BfsSide backward_;
     size_t count_{0};
     // startVid : {endVid, cost}
     std::unordered_map<Value, std::unordered_map<Value, Value>> historyCostMap_;
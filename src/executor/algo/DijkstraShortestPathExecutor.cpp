@@ -0,0 +1,268 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "executor/algo/DijkstraShortestPathExecutor.h"
+
+#include "planner/plan/Algo.h"
+#include "service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+folly::Future<Status> DijkstraShortestPathExecutor::execute() {
+    SCOPED_TIMER(&execTime_);
+    auto* dijkstra = asNode<DijkstraShortestPath>(node());
+    if (!initialized_) {
+        init();
+        initialized_ = true;
+    }
+    NG_RETURN_IF_ERROR(addNeighbors());
+
+    DataSet paths;
+    paths.colNames = dijkstra->colNames();
+    settle(&paths);
+
+    ectx_->setResult(dijkstra->fromVidsVar(), ResultBuilder().value(Value(nextBatch())).finish());
+    return finish(ResultBuilder().value(Value(std::move(paths))).finish());
+}
+
+uint32_t DijkstraShortestPathExecutor::intern(const Value& vid) {
+    auto id = vids_.intern(vid).first;
+    if (adjacency_.size() <= id) {
+        adjacency_.resize(vids_.size());
+        ends_.resize(vids_.size(), false);
+    }
+    return id;
+}
+
+void DijkstraShortestPathExecutor::init() {
+    auto* dijkstra = asNode<DijkstraShortestPath>(node());
+    steps_ = dijkstra->steps();
+    weightProp_ = dijkstra->weightProp();
+
+    for (auto iter = ectx_->getResult(dijkstra->toVidsVar()).iter(); iter->valid(); iter->next()) {
+        auto id = intern(iter->getColumn(0));
+        if (!ends_[id]) {
+            ends_[id] = true;
+            ++numEnds_;
+        }
+    }
+
+    // The first version of the input is the starts, the later ones are
+    // the batches of the vids to fetch
+    const auto& hist = ectx_->getHistory(dijkstra->fromVidsVar());
+    if (hist.empty()) {
+        return;
+    }
+    std::vector<bool> started;
+    for (auto iter = hist.front().iter(); iter->valid(); iter->next()) {
+        auto start = intern(iter->getColumn(0));
+        if (started.size() <= start) {
+            started.resize(vids_.size(), false);
+        }
+        if (started[start]) {
+            continue;
+        }
+        started[start] = true;
+        auto search = searches_.size();
+        searches_.emplace_back();
+        auto& s = searches_.back();
+        s.start = start;
+        s.remaining = numEnds_ - (ends_[start] ? 1 : 0);
+
+        auto label = labels_.size();
+        labels_.emplace_back(Label{search, start, 0, 0.0, false, {}});
+        s.labelsOf(start).labels.emplace_back(label);
+        heap_.emplace_back(HeapEntry{heuristic(start), 0, label, 0.0});
+        std::push_heap(heap_.begin(), heap_.end());
+        fetching_.emplace_back(start);
+    }
+}
+
+Status DijkstraShortestPathExecutor::addNeighbors() {
+    auto iter = ectx_->getResult(node()->inputVar()).iter();
+    if (!iter->isGetNeighborsIter()) {
+        return Status::Error("Only accept GetNeighborsIter.");
+    }
+    for (; iter->valid(); iter->next()) {
+        auto edgeVal = iter->getEdge();
+        if (!edgeVal.isEdge()) {
+            continue;
+        }
+        const auto& edge = edgeVal.getEdge();
+        auto found = edge.props.find(weightProp_);
+        if (found == edge.props.end() || !(found->second.isInt() || found->second.isFloat())) {
+            return Status::Error("The weight `%s' of the edge from `%s' to `%s' is not a number",
+                                 weightProp_.c_str(),
+                                 edge.src.toString().c_str(),
+                                 edge.dst.toString().c_str());
+        }
+        double weight = found->second.isInt() ? found->second.getInt() : found->second.getFloat();
+        if (!(weight >= 0)) {
+            return Status::Error("The weight `%s' of the edge from `%s' to `%s' is negative",
+                                 weightProp_.c_str(),
+                                 edge.src.toString().c_str(),
+                                 edge.dst.toString().c_str());
+        }
+        auto src = intern(edge.src);
+        auto dst = intern(edge.dst);
+        adjacency_[src].neighbors.emplace_back(Neighbor{std::move(edgeVal), dst, weight});
+    }
+    // The vids without any edge are fetched too
+    for (auto vid : fetching_) {
+        adjacency_[vid].fetched = true;
+    }
+    fetching_.clear();
+    return Status::OK();
+}
+
+bool DijkstraShortestPathExecutor::isLive(const HeapEntry& entry) const {
+    const auto& label = labels_[entry.label];
+    const auto& search = searches_[label.search];
+    if (label.settled || entry.dist != label.dist || search.remaining == 0) {
+        return false;
+    }
+    // Dominated by a settled label of the fewer hops
+    return search.vids[label.vid].settledHops > label.hops;
+}
+
+void DijkstraShortestPathExecutor::settle(DataSet* paths) {
+    while (!heap_.empty()) {
+        auto top = heap_.front();
+        if (!isLive(top)) {
+            std::pop_heap(heap_.begin(), heap_.end());
+            heap_.pop_back();
+            continue;
+        }
+        auto& label = labels_[top.label];
+        if (label.hops < steps_ && !adjacency_[label.vid].fetched) {
+            // Wait for the neighbors
+            break;
+        }
+        std::pop_heap(heap_.begin(), heap_.end());
+        heap_.pop_back();
+
+        label.settled = true;
+        auto& search = searches_[label.search];
+        auto& vidLabels = search.vids[label.vid];
+        auto reached = vidLabels.settledHops == kNone;
+        vidLabels.settledHops = label.hops;
+        if (reached && ends_[label.vid] && label.vid != search.start) {
+            std::vector<Step> steps;
+            buildPaths(top.label, &steps, paths);
+            if (--search.remaining == 0) {
+                continue;
+            }
+        }
+        if (label.hops < steps_) {
+            relax(top.label);
+        }
+    }
+}
+
+void DijkstraShortestPathExecutor::relax(size_t label) {
+    // Copy since the labels grow
+    auto search = labels_[label].search;
+    auto hops = labels_[label].hops + 1;
+    auto dist = labels_[label].dist;
+    const auto& neighbors = adjacency_[labels_[label].vid].neighbors;
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+        push(search, neighbors[i].dst, hops, dist + neighbors[i].weight, label, i);
+    }
+}
+
+void DijkstraShortestPathExecutor::push(size_t search,
+                                        uint32_t vid,
+                                        size_t hops,
+                                        double dist,
+                                        size_t pred,
+                                        size_t edge) {
+    auto& vidLabels = searches_[search].labelsOf(vid);
+    if (vidLabels.settledHops <= hops) {
+        return;
+    }
+    for (auto l : vidLabels.labels) {
+        auto& label = labels_[l];
+        if (label.hops != hops) {
+            continue;
+        }
+        if (dist < label.dist) {
+            label.dist = dist;
+            label.preds.clear();
+            label.preds.emplace_back(pred, edge);
+            heap_.emplace_back(HeapEntry{dist + heuristic(vid), hops, l, dist});
+            std::push_heap(heap_.begin(), heap_.end());
+        } else if (dist == label.dist) {
+            label.preds.emplace_back(pred, edge);
+        }
+        return;
+    }
+    auto l = labels_.size();
+    labels_.emplace_back(Label{search, vid, hops, dist, false, {{pred, edge}}});
+    vidLabels.labels.emplace_back(l);
+    heap_.emplace_back(HeapEntry{dist + heuristic(vid), hops, l, dist});
+    std::push_heap(heap_.begin(), heap_.end());
+}
+
+DataSet DijkstraShortestPathExecutor::nextBatch() {
+    DataSet ds;
+    ds.colNames = {kVid};
+    std::vector<HeapEntry> candidates;
+    for (auto& entry : heap_) {
+        const auto& label = labels_[entry.label];
+        if (label.hops < steps_ && !adjacency_[label.vid].fetched && isLive(entry)) {
+            candidates.emplace_back(entry);
+        }
+    }
+    // The cheapest ones, which the heap top is among
+    auto cheaper = [] (const HeapEntry& lhs, const HeapEntry& rhs) { return rhs < lhs; };
+    size_t batchSize = std::max<size_t>(FLAGS_shortest_path_batch_size, 1);
+    if (candidates.size() > batchSize) {
+        std::nth_element(candidates.begin(),
+                         candidates.begin() + batchSize,
+                         candidates.end(),
+                         cheaper);
+        candidates.resize(batchSize);
+    }
+    std::vector<bool> added(vids_.size(), false);
+    for (auto& entry : candidates) {
+        auto vid = labels_[entry.label].vid;
+        if (!added[vid]) {
+            added[vid] = true;
+            Row row;
+            row.values.emplace_back(vids_.vid(vid));
+            ds.rows.emplace_back(std::move(row));
+            fetching_.emplace_back(vid);
+        }
+    }
+    return ds;
+}
+
+void DijkstraShortestPathExecutor::buildPaths(size_t label,
+                                              std::vector<Step>* steps,
+                                              DataSet* paths) const {
+    const auto& l = labels_[label];
+    if (l.preds.empty()) {
+        // Reach the start
+        Path path;
+        path.src = Vertex(vids_.vid(l.vid), {});
+        path.steps.assign(steps->rbegin(), steps->rend());
+        Row row;
+        row.values.emplace_back(std::move(path));
+        paths->rows.emplace_back(std::move(row));
+        return;
+    }
+    for (auto& pred : l.preds) {
+        const auto& from = labels_[pred.first];
+        const auto& edge = adjacency_[from.vid].neighbors[pred.second].edge.getEdge();
+        steps->emplace_back(Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
+        buildPaths(pred.first, steps, paths);
+        steps->pop_back();
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
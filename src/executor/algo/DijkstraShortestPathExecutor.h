@@ -0,0 +1,150 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXECUTOR_ALGO_DIJKSTRASHORTESTPATHEXECUTOR_H_
+#define EXECUTOR_ALGO_DIJKSTRASHORTESTPATHEXECUTOR_H_
+
+#include "executor/Executor.h"
+#include "util/VidDict.h"
+
+namespace nebula {
+namespace graph {
+
+// The shortest paths weighted by an edge property, from each of the starts to
+// each of the ends within the steps.
+//
+// All the starts are searched in one priority queue, sharing the neighbors
+// fetched. Each round settles the labels in the order of the distance until
+// the neighbors of the cheapest one are not fetched yet, then asks for the
+// neighbors of it along with the other cheapest unfetched vids in the queue,
+// so that a round trip to the storage fetches a batch of the neighbors.
+//
+// A label is the distance to a vid with the certain number of hops, so the
+// paths over the steps are not taken. Among the paths of the same weight, the
+// ones of the fewest hops are returned.
+class DijkstraShortestPathExecutor final : public Executor {
+public:
+    // The lower bound of the distance from the vid to the ends
+    using Heuristic = std::function<double(const Value& vid)>;
+
+    DijkstraShortestPathExecutor(const PlanNode* node, QueryContext* qctx)
+        : Executor("DijkstraShortestPath", node, qctx) {}
+
+    folly::Future<Status> execute() override;
+
+    // Search by A* with the heuristic, which must be consistent, e.g. the
+    // distances on a map. Dijkstra if not set.
+    void setHeuristic(Heuristic heuristic) {
+        heuristic_ = std::move(heuristic);
+    }
+
+private:
+    static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+    struct Neighbor {
+        Value       edge;
+        uint32_t    dst;
+        double      weight;
+    };
+
+    // The neighbors of a vid
+    struct Adjacency {
+        std::vector<Neighbor>   neighbors;
+        bool                    fetched{false};
+    };
+
+    struct Label {
+        size_t      search;
+        uint32_t    vid;
+        size_t      hops;
+        double      dist;
+        bool        settled{false};
+        // The previous labels and the index of the edge in their neighbors
+        std::vector<std::pair<size_t, size_t>> preds;
+    };
+
+    // The labels of a vid searched from a start
+    struct VidLabels {
+        std::vector<size_t>     labels;
+        // The fewest hops of the settled labels
+        size_t                  settledHops{kNone};
+    };
+
+    struct Search {
+        uint32_t                    start;
+        // By the vid, grown on demand
+        std::vector<VidLabels>      vids;
+        // The number of the ends not reached yet
+        size_t                      remaining{0};
+
+        VidLabels& labelsOf(uint32_t vid) {
+            if (vids.size() <= vid) {
+                vids.resize(vid + 1);
+            }
+            return vids[vid];
+        }
+    };
+
+    struct HeapEntry {
+        double      key;
+        size_t      hops;
+        size_t      label;
+        // The distance of the label when pushed, stale if changed since
+        double      dist;
+
+        // The min heap by the key, then the hops
+        bool operator<(const HeapEntry& rhs) const {
+            return key != rhs.key ? key > rhs.key : hops > rhs.hops;
+        }
+    };
+
+    void init();
+
+    // Intern the vid, and grow the states by the vid
+    uint32_t intern(const Value& vid);
+
+    Status addNeighbors();
+
+    // Settle the labels until the neighbors of the cheapest one are not fetched
+    void settle(DataSet* paths);
+
+    void relax(size_t label);
+
+    void push(size_t search, uint32_t vid, size_t hops, double dist, size_t pred, size_t edge);
+
+    // The cheapest unfetched vids in the queue, empty if the search is over
+    DataSet nextBatch();
+
+    // Build the paths to the label, with the steps walked back so far
+    void buildPaths(size_t label, std::vector<Step>* steps, DataSet* paths) const;
+
+    // Whether the label is still to settle
+    bool isLive(const HeapEntry& entry) const;
+
+    double heuristic(uint32_t vid) const {
+        return heuristic_ ? heuristic_(vids_.vid(vid)) : 0.0;
+    }
+
+    bool                                    initialized_{false};
+    size_t                                  steps_{0};
+    std::string                             weightProp_;
+    Heuristic                               heuristic_;
+    VidDict                                 vids_;
+    // By the vid
+    std::vector<bool>                       ends_;
+    std::vector<Adjacency>                  adjacency_;
+    size_t                                  numEnds_{0};
+    std::vector<Search>                     searches_;
+    std::vector<Label>                      labels_;
+    std::vector<HeapEntry>                  heap_;
+    // The vids whose neighbors are asked for in the last round
+    std::vector<uint32_t>                   fetching_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // EXECUTOR_ALGO_DIJKSTRASHORTESTPATHEXECUTOR_H_
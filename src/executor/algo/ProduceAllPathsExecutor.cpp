@@ -6,9 +6,29 @@
 #include "executor/algo/ProduceAllPathsExecutor.h"
 
 #include "planner/plan/Algo.h"
+#include "util/FlatHashMap.h"
 
 namespace nebula {
 namespace graph {
+
+namespace {
+
+// Whether the edges are the same one, in either direction
+bool isSameEdge(const Edge& lhs, const Edge& rhs) {
+    if (lhs.ranking != rhs.ranking) {
+        return false;
+    }
+    if (lhs.type == rhs.type) {
+        return lhs.src == rhs.src && lhs.dst == rhs.dst;
+    }
+    if (lhs.type == -rhs.type) {
+        return lhs.src == rhs.dst && lhs.dst == rhs.src;
+    }
+    return false;
+}
+
+}   // namespace
+
 folly::Future<Status> ProduceAllPathsExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* allPaths = asNode<ProduceAllPaths>(node());
@@ -18,73 +38,106 @@ folly::Future<Status> ProduceAllPathsExecutor::execute() {
 
     DataSet ds;
     ds.colNames = node()->colNames();
-    Interims interims;
 
     if (!iter->isGetNeighborsIter()) {
         return Status::Error("Only accept GetNeighbotsIter.");
     }
     VLOG(1) << "Edge size: " << iter->size();
+
+    // The paths of the last version are extended by the edges from their dsts
+    const auto& hist = ectx_->getHistory(node()->outputVar());
+    FlatHashMap<Value, std::vector<size_t>> lastNodes;
+    if (!hist.empty() && hist.back().value().isDataSet()) {
+        const auto& rows = hist.back().value().getDataSet().rows;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const auto& vid = rows[i].values[kVidCol];
+            lastNodes.tryEmplace(vid, std::hash<Value>()(vid)).first->emplace_back(i);
+        }
+    }
+
     for (; iter->valid(); iter->next()) {
         auto edgeVal = iter->getEdge();
         if (!edgeVal.isEdge()) {
             continue;
         }
         auto& edge = edgeVal.getEdge();
-        auto histPaths = historyPaths_.find(edge.src);
-        if (histPaths == historyPaths_.end()) {
-            createPaths(edge, interims);
-        } else {
-            buildPaths(histPaths->second, edge, interims);
+        auto* parents = lastNodes.find(edge.src, std::hash<Value>()(edge.src));
+        if (parents != nullptr) {
+            for (auto parent : *parents) {
+                if (isDuplicate(hist, hist.size() - 1, parent, edge)) {
+                    continue;
+                }
+                Row row;
+                row.values = {edge.dst, edgeVal, static_cast<int64_t>(parent)};
+                ds.rows.emplace_back(std::move(row));
+            }
+        } else if (visited_.find(edge.src) == VidDict::kNone) {
+            // The src is a start
+            if (noLoop_ && edge.src == edge.dst) {
+                continue;
+            }
+            Row row;
+            row.values = {edge.dst, edgeVal, -1};
+            ds.rows.emplace_back(std::move(row));
         }
     }
 
-    for (auto& interim : interims) {
-        Row row;
-        auto& dst = interim.first;
-        auto& paths = interim.second;
-        row.values.emplace_back(std::move(dst));
-        row.values.emplace_back(List(std::move(paths)));
-        ds.rows.emplace_back(std::move(row));
-
-        const auto& dstInDs = ds.rows.back().values.front();
-        for (auto& path : ds.rows.back().values.back().getList().values) {
-            historyPaths_[dstInDs].emplace_back(&path.getPath());
-        }
+    for (auto& row : ds.rows) {
+        visited_.intern(row.values[kVidCol]);
     }
-    count_++;
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
-void ProduceAllPathsExecutor::createPaths(const Edge& edge, Interims& interims) {
+// static
+Path ProduceAllPathsExecutor::buildPath(const std::vector<Result>& hist,
+                                        size_t version,
+                                        size_t row) {
     Path path;
-    path.src = Vertex(edge.src, {});
-    path.steps.emplace_back(Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
-    if (noLoop_ && path.hasDuplicateVertices()) {
-        return;
+    // Walk back to the start, with the steps reversed
+    while (true) {
+        const auto& node = hist[version].value().getDataSet().rows[row];
+        const auto& edgeVal = node.values[kEdgeCol];
+        if (!edgeVal.isEdge()) {
+            path.src = Vertex(node.values[kVidCol], {});
+            break;
+        }
+        const auto& edge = edgeVal.getEdge();
+        path.steps.emplace_back(Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
+        const auto& parent = node.values[kParentCol];
+        if (!parent.isInt() || parent.getInt() < 0 || version == 0) {
+            path.src = Vertex(edge.src, {});
+            break;
+        }
+        --version;
+        row = parent.getInt();
     }
-    VLOG(1) << "Create path: " << path;
-    interims[edge.dst].emplace_back(std::move(path));
+    std::reverse(path.steps.begin(), path.steps.end());
+    return path;
 }
 
-void ProduceAllPathsExecutor::buildPaths(const std::vector<const Path*>& history,
-                                         const Edge& edge,
-                                         Interims& interims) {
-    for (auto* histPath : history) {
-        if (histPath->steps.size() < count_) {
-            continue;
-        } else {
-            Path path = *histPath;
-            path.steps.emplace_back(
-                Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
-            if (path.hasDuplicateEdges()) {
-                continue;
-            }
-            if (noLoop_ && path.hasDuplicateVertices()) {
-                continue;
-            }
-            VLOG(1) << "Build path: " << path;
-            interims[edge.dst].emplace_back(std::move(path));
+bool ProduceAllPathsExecutor::isDuplicate(const std::vector<Result>& hist,
+                                          size_t version,
+                                          size_t row,
+                                          const Edge& edge) const {
+    while (true) {
+        const auto& node = hist[version].value().getDataSet().rows[row];
+        if (noLoop_ && node.values[kVidCol] == edge.dst) {
+            return true;
+        }
+        const auto& edgeVal = node.values[kEdgeCol];
+        if (!edgeVal.isEdge()) {
+            return false;
+        }
+        const auto& prev = edgeVal.getEdge();
+        if (isSameEdge(prev, edge)) {
+            return true;
+        }
+        const auto& parent = node.values[kParentCol];
+        if (!parent.isInt() || parent.getInt() < 0 || version == 0) {
+            return noLoop_ && prev.src == edge.dst;
         }
+        --version;
+        row = parent.getInt();
     }
 }
 
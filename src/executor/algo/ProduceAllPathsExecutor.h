@@ -8,9 +8,19 @@
 #define EXECUTOR_ALGO_PRODUCEALLPATHSEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/VidDict.h"
 
 namespace nebula {
 namespace graph {
+
+/**
+ * The paths are kept as a prefix tree in the versions of the output variable,
+ * instead of the whole paths, so that the paths with the same prefix share it.
+ * Each row of a version is a node of the tree: the vid, the edge to the vid,
+ * and the index of the row of the previous version as the parent. The node
+ * without the edge is a start, and the one without the parent starts from the
+ * src of its edge. The whole paths are only built for the paths found.
+ */
 class ProduceAllPathsExecutor final : public Executor {
 public:
     ProduceAllPathsExecutor(const PlanNode* node, QueryContext* qctx)
@@ -18,19 +28,24 @@ public:
 
     folly::Future<Status> execute() override;
 
-private:
-    // k: dst, v: paths to dst
-    using HistoryPaths = std::unordered_map<Value, std::vector<const Path*>>;
-
-    // k: dst, v: paths to dst
-    using Interims = std::unordered_map<Value, std::vector<Value>>;
-
-    void createPaths(const Edge& edge, Interims& interims);
+    // The columns of the nodes
+    static constexpr size_t kVidCol = 0;
+    static constexpr size_t kEdgeCol = 1;
+    static constexpr size_t kParentCol = 2;
 
-    void buildPaths(const std::vector<const Path*>& history, const Edge& edge, Interims& interims);
+    // The path of the row `row' in the version `version' of the history
+    static Path buildPath(const std::vector<Result>& hist, size_t version, size_t row);
 
-    size_t count_{0};
-    HistoryPaths historyPaths_;
+private:
+    // Whether the edge from the node is a duplicate one of the path of the node,
+    // or the dst of the edge is in the path when `noLoop_'
+    bool isDuplicate(const std::vector<Result>& hist,
+                     size_t version,
+                     size_t row,
+                     const Edge& edge) const;
+
+    // The vids which have been the dst of the paths, or the start
+    VidDict visited_;
     bool noLoop_{false};
 };
 }  // namespace graph
@@ -31,22 +31,27 @@ folly::Future<Status> SubgraphExecutor::execute() {
     VLOG(1) << "input: " << subgraph->inputVar() << " output: " << node()->outputVar();
     auto iter = ectx_->getResult(subgraph->inputVar()).iter();
     DCHECK(iter && iter->isGetNeighborsIter());
-    ds.rows.reserve(iter->size());
     if (currentStep == 1) {
         for (; iter->valid(); iter->next()) {
             const auto& src = iter->getColumn(nebula::kVid);
-            historyVids_.emplace(src);
+            historyVids_.add(vids_.intern(src).first);
         }
         iter->reset();
     }
+    // The next step is the dsts not in the subgraph yet
+    VidBitmap frontier;
     for (; iter->valid(); iter->next()) {
         const auto& dst = iter->getEdgeProp("*", nebula::kDst);
-        if (historyVids_.emplace(dst).second) {
-            Row row;
-            row.values.emplace_back(std::move(dst));
-            ds.rows.emplace_back(std::move(row));
-        }
+        frontier.add(vids_.intern(dst).first);
     }
+    frontier.subtract(historyVids_);
+    historyVids_.unionWith(frontier);
+    ds.rows.reserve(frontier.size());
+    frontier.forEach([&ds, this](uint32_t id) {
+        Row row;
+        row.values.emplace_back(vids_.vid(id));
+        ds.rows.emplace_back(std::move(row));
+    });
 
     VLOG(1) << "Next step vid is : " << ds;
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
@@ -63,7 +68,8 @@ void SubgraphExecutor::oneMoreStep() {
     builder.value(iter->valuePtr());
     while (iter->valid()) {
         const auto& dst = iter->getEdgeProp("*", nebula::kDst);
-        if (historyVids_.find(dst) == historyVids_.end()) {
+        auto id = vids_.find(dst);
+        if (id == VidDict::kNone || !historyVids_.contains(id)) {
             iter->unstableErase();
         } else {
             iter->next();
@@ -8,6 +8,8 @@
 #define EXECUTOR_ALGO_SUBGRAPHEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/VidBitmap.h"
+#include "util/VidDict.h"
 
 namespace nebula {
 namespace graph {
@@ -22,7 +24,9 @@ private:
     void oneMoreStep();
 
 private:
-    std::unordered_set<Value>   historyVids_;
+    VidDict                     vids_;
+    // The vids of the subgraph so far
+    VidBitmap                   historyVids_;
 };
 
 }   // namespace graph
@@ -6,8 +6,7 @@
 
 #include "executor/query/AggregateExecutor.h"
 
-#include "common/datatypes/List.h"
-#include "common/expression/AggregateExpression.h"
+#include "common/datatypes/Set.h"
 #include "context/QueryExpressionContext.h"
 #include "context/Result.h"
 #include "planner/plan/PlanNode.h"
@@ -17,6 +16,19 @@
 namespace nebula {
 namespace graph {
 
+namespace {
+
+std::string funcName(Expression *item) {
+    if (item->kind() != Expression::Kind::kAggregate) {
+        return "";
+    }
+    auto func = static_cast<AggregateExpression *>(item)->name();
+    std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+    return func;
+}
+
+}   // namespace
+
 folly::Future<Status> AggregateExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* agg = asNode<Aggregate>(node());
@@ -24,9 +36,13 @@ folly::Future<Status> AggregateExecutor::execute() {
     auto groupItems = agg->groupItems();
     auto iter = ectx_->getResult(agg->inputVar()).iter();
     DCHECK(!!iter);
-    QueryExpressionContext ctx(ectx_);
 
-    std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
+    if ((iter->isSequentialIter() || iter->isPropIter()) && numJobs(iter->size()) > 1 &&
+        isMergeable(groupItems)) {
+        return aggregateInParallel(agg, std::move(iter));
+    }
+
+    AggResult result;
 
     // generate default result when input dataset is empty
     if (UNLIKELY(!iter->valid())) {
@@ -44,49 +60,177 @@ folly::Future<Status> AggregateExecutor::execute() {
         }
         if (allAggItems) {
             List dummyKey;
-            std::vector<std::unique_ptr<AggData>> cols;
+            auto h = AggResult::hash(dummyKey);
+            auto& cols = *result.tryEmplace(std::move(dummyKey), h).first;
             for (size_t i = 0; i < groupItems.size(); ++i) {
                 cols.emplace_back(new AggData());
                 cols[i]->setResult(defaultValues[i]);
             }
-            result.emplace(std::make_pair(dummyKey, std::move(cols)));
         }
     }
 
-    for (; iter->valid(); iter->next()) {
+    aggregate(groupKeys, groupItems, iter.get(), std::numeric_limits<size_t>::max(), &result);
+    return finishResult(agg, &result);
+}
+
+void AggregateExecutor::aggregate(const std::vector<Expression*>& groupKeys,
+                                  const std::vector<Expression*>& groupItems,
+                                  Iterator* iter,
+                                  size_t numRows,
+                                  AggResult* result) {
+    QueryExpressionContext ctx(ectx_);
+    for (size_t n = 0; n < numRows && iter->valid(); ++n, iter->next()) {
         List list;
+        list.values.reserve(groupKeys.size());
         for (auto* key : groupKeys) {
-            list.values.emplace_back(key->eval(ctx(iter.get())));
+            list.values.emplace_back(key->eval(ctx(iter)));
         }
 
-        auto it = result.find(list);
-        if (it == result.end()) {
-           std::vector<std::unique_ptr<AggData>> cols;
-           for (size_t i = 0; i < groupItems.size(); ++i) {
-               cols.emplace_back(new AggData());
-           }
-           result.emplace(std::make_pair(list, std::move(cols)));
+        // Hash the group key once for both the probing and the insertion
+        auto h = AggResult::hash(list);
+        auto ret = result->tryEmplace(std::move(list), h);
+        auto& cols = *ret.first;
+        if (ret.second) {
+            cols.reserve(groupItems.size());
+            for (size_t i = 0; i < groupItems.size(); ++i) {
+                cols.emplace_back(new AggData());
+            }
         } else {
-            DCHECK_EQ(it->second.size(), groupItems.size());
+            DCHECK_EQ(cols.size(), groupItems.size());
         }
 
         for (size_t i = 0; i < groupItems.size(); ++i) {
             auto* item = groupItems[i];
             if (item->kind() == Expression::Kind::kAggregate) {
-                static_cast<AggregateExpression*>(item)->setAggData(result[list][i].get());
-                item->eval(ctx(iter.get()));
+                static_cast<AggregateExpression*>(item)->setAggData(cols[i].get());
+                item->eval(ctx(iter));
             } else {
-                result[list][i]->setResult(item->eval(ctx(iter.get())));
+                cols[i]->setResult(item->eval(ctx(iter)));
+            }
+        }
+    }
+}
+
+// static
+bool AggregateExecutor::isMergeable(const std::vector<Expression*>& groupItems) {
+    static const std::unordered_set<std::string> kMergeableFuncs = {
+        "COUNT", "SUM", "MAX", "MIN", "COLLECT", "COLLECT_SET"};
+    for (auto* item : groupItems) {
+        if (item->kind() != Expression::Kind::kAggregate) {
+            continue;
+        }
+        if (static_cast<AggregateExpression*>(item)->distinct() ||
+            kMergeableFuncs.find(funcName(item)) == kMergeableFuncs.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+folly::Future<Status> AggregateExecutor::aggregateInParallel(const Aggregate* agg,
+                                                             std::shared_ptr<Iterator> iter) {
+    auto size = iter->size();
+    auto scatter = [this, agg, iter](size_t begin, size_t end) -> AggResult {
+        JobExprs groupKeys(qctx_, agg->groupKeys());
+        JobExprs groupItems(qctx_, agg->groupItems());
+        auto jobIter = iter->copy();
+        jobIter->reset(begin);
+        AggResult result;
+        aggregate(groupKeys.clones(), groupItems.clones(), jobIter.get(), end - begin, &result);
+        return result;
+    };
+
+    return runMultiJobs<AggResult>(size, std::move(scatter))
+        .thenValue([this, agg](std::vector<AggResult>&& partials) {
+            SCOPED_TIMER(&execTime_);
+            DCHECK(!partials.empty());
+            std::vector<std::string> funcs;
+            for (auto* item : agg->groupItems()) {
+                funcs.emplace_back(funcName(item));
+            }
+
+            // Merge in the order of ranges to keep the results of the order sensitive
+            // functions, e.g. COLLECT, the same as the serial aggregation
+            auto& result = partials.front();
+            for (size_t p = 1; p < partials.size(); ++p) {
+                for (auto& entry : partials[p].entries()) {
+                    auto ret = result.tryEmplace(std::move(entry.key), entry.hash);
+                    if (ret.second) {
+                        *ret.first = std::move(entry.value);
+                        continue;
+                    }
+                    auto& cols = *ret.first;
+                    for (size_t i = 0; i < cols.size(); ++i) {
+                        if (funcs[i].empty()) {
+                            // The non-aggregate item takes the value of the last row
+                            cols[i] = std::move(entry.value[i]);
+                        } else {
+                            merge(funcs[i], cols[i].get(), entry.value[i].get());
+                        }
+                    }
+                }
             }
+            otherStats_.emplace("jobs", folly::to<std::string>(partials.size()));
+            return finishResult(agg, &result);
+        });
+}
+
+// static
+void AggregateExecutor::merge(const std::string& func, AggData* to, AggData* from) {
+    const auto& lhs = to->result();
+    const auto& rhs = from->result();
+    if (lhs.isBadNull()) {
+        return;
+    }
+    if (rhs.isBadNull()) {
+        to->setResult(rhs);
+        return;
+    }
+    // Null means no value has been aggregated by the part
+    if (rhs.isNull() || rhs.empty()) {
+        return;
+    }
+    if (lhs.isNull() || lhs.empty()) {
+        to->setResult(rhs);
+        return;
+    }
+
+    if (func == "COUNT" || func == "SUM") {
+        auto sum = lhs + rhs;
+        to->setResult(std::move(sum));
+    } else if (func == "MAX") {
+        if (lhs < rhs) {
+            to->setResult(rhs);
         }
+    } else if (func == "MIN") {
+        if (rhs < lhs) {
+            to->setResult(rhs);
+        }
+    } else if (func == "COLLECT") {
+        DCHECK(lhs.isList() && rhs.isList());
+        List list = lhs.getList();
+        auto& values = rhs.getList().values;
+        list.values.insert(list.values.end(), values.begin(), values.end());
+        to->setResult(Value(std::move(list)));
+    } else if (func == "COLLECT_SET") {
+        DCHECK(lhs.isSet() && rhs.isSet());
+        Set set = lhs.getSet();
+        auto& values = rhs.getSet().values;
+        set.values.insert(values.begin(), values.end());
+        to->setResult(Value(std::move(set)));
+    } else {
+        LOG(FATAL) << "Unmergeable aggregate function: " << func;
     }
+}
 
+Status AggregateExecutor::finishResult(const Aggregate* agg, AggResult* result) {
     DataSet ds;
     ds.colNames = agg->colNames();
-    ds.rows.reserve(result.size());
-    for (auto& kv : result) {
+    ds.rows.reserve(result->size());
+    for (auto& entry : result->entries()) {
         Row row;
-        for (auto& v : kv.second) {
+        row.values.reserve(entry.value.size());
+        for (auto& v : entry.value) {
             row.values.emplace_back(v->result());
         }
         ds.rows.emplace_back(std::move(row));
@@ -7,17 +7,44 @@
 #ifndef EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 #define EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 
+#include "common/datatypes/List.h"
+#include "common/expression/AggregateExpression.h"
 #include "executor/Executor.h"
+#include "util/FlatHashMap.h"
 
 namespace nebula {
 namespace graph {
 
+class Aggregate;
+
 class AggregateExecutor final : public Executor {
 public:
     AggregateExecutor(const PlanNode *node, QueryContext *qctx)
         : Executor("AggregateExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+private:
+    using AggResult = FlatHashMap<List, std::vector<std::unique_ptr<AggData>>>;
+
+    // Aggregate at most `numRows' rows from the current position of `iter' into `result'
+    void aggregate(const std::vector<Expression *> &groupKeys,
+                   const std::vector<Expression *> &groupItems,
+                   Iterator *iter,
+                   size_t numRows,
+                   AggResult *result);
+
+    // Whether the partial results of the disjoint ranges of input could be merged,
+    // which is true when all aggregate functions are decomposable and not distinct
+    static bool isMergeable(const std::vector<Expression *> &groupItems);
+
+    // Aggregate the ranges of input concurrently, then merge the partial results
+    folly::Future<Status> aggregateInParallel(const Aggregate *agg,
+                                              std::shared_ptr<Iterator> iter);
+
+    static void merge(const std::string &func, AggData *to, AggData *from);
+
+    Status finishResult(const Aggregate *agg, AggResult *result);
 };
 
 }   // namespace graph
@@ -7,10 +7,70 @@
 #include "executor/query/DataCollectExecutor.h"
 
 #include "planner/plan/Query.h"
+#include "util/Arena.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
 namespace graph {
+namespace {
+
+using VertexMap = std::unordered_map<Value, Vertex>;
+using EdgeKey = std::tuple<Value, EdgeType, EdgeRanking, Value>;
+using EdgeMap = std::unordered_map<EdgeKey, Edge>;
+
+// The nodes are allocated from an arena released at once on return
+template <typename T>
+using ArenaSet = std::unordered_set<T, std::hash<T>, std::equal_to<T>, ArenaAllocator<T>>;
+
+template <typename T>
+ArenaSet<T> makeArenaSet(Arena* arena) {
+    return ArenaSet<T>(0, std::hash<T>(), std::equal_to<T>(), ArenaAllocator<T>(arena));
+}
+
+// Fill the props of the vertices and edges of at most `numRows' paths from the current
+// one of `iter', the maps are only read so that the morsels share them
+void attachProps(const VertexMap& vertexMap,
+                 const EdgeMap& edgeMap,
+                 Iterator* iter,
+                 size_t numRows,
+                 DataSet* ds) {
+    for (size_t n = 0; n < numRows && iter->valid(); ++n, iter->next()) {
+        auto& pathVal = iter->getColumn(0);
+        if (!pathVal.isPath()) {
+            continue;
+        }
+        auto path = pathVal.getPath();
+        auto src = path.src.vid;
+        auto found = vertexMap.find(src);
+        if (found != vertexMap.end()) {
+            path.src = found->second;
+        }
+        for (auto& step : path.steps) {
+            auto dst = step.dst.vid;
+            auto dstFound = vertexMap.find(dst);
+            step.dst = dstFound != vertexMap.end() ? dstFound->second : Vertex();
+
+            auto type = step.type;
+            auto ranking = step.ranking;
+            if (type < 0) {
+                dst = src;
+                src = step.dst.vid;
+                type = -type;
+            }
+            auto edgeFound = edgeMap.find(std::make_tuple(src, type, ranking, dst));
+            if (edgeFound != edgeMap.end()) {
+                step.props = edgeFound->second.props;
+            } else {
+                step.props.clear();
+            }
+            src = step.dst.vid;
+        }
+        ds->rows.emplace_back(Row({std::move(path)}));
+    }
+}
+
+}   // namespace
+
 folly::Future<Status> DataCollectExecutor::execute() {
     return doCollect().ensure([this] () {
         result_ = Value::kEmpty;
@@ -50,12 +110,15 @@ folly::Future<Status> DataCollectExecutor::doCollect() {
             break;
         }
         case DataCollect::DCKind::kPathProp: {
-            NG_RETURN_IF_ERROR(collectPathProp(vars));
-            break;
+            return collectPathProp(vars);
         }
         default:
             LOG(FATAL) << "Unknown data collect type: " << static_cast<int64_t>(dc->kind());
     }
+    return finishCollect();
+}
+
+Status DataCollectExecutor::finishCollect() {
     ResultBuilder builder;
     builder.value(Value(std::move(result_))).iter(Iterator::Kind::kSequential);
     return finish(builder.finish());
@@ -65,8 +128,9 @@ Status DataCollectExecutor::collectSubgraph(const std::vector<std::string>& vars
     DataSet ds;
     ds.colNames = std::move(colNames_);
     // the subgraph not need duplicate vertices or edges, so dedup here directly
-    std::unordered_set<Value> uniqueVids;
-    std::unordered_set<std::tuple<Value, EdgeType, EdgeRanking, Value>> uniqueEdges;
+    Arena arena;
+    auto uniqueVids = makeArenaSet<Value>(&arena);
+    auto uniqueEdges = makeArenaSet<EdgeKey>(&arena);
     for (auto i = vars.begin(); i != vars.end(); ++i) {
         const auto& hist = ectx_->getHistory(*i);
         for (auto j = hist.begin(); j != hist.end(); ++j) {
@@ -83,6 +147,7 @@ Status DataCollectExecutor::collectSubgraph(const std::vector<std::string>& vars
             List edges;
             auto* gnIter = static_cast<GetNeighborsIter*>(iter.get());
             auto originVertices = gnIter->getVertices();
+            uniqueVids.reserve(uniqueVids.size() + originVertices.values.size());
             for (auto& v : originVertices.values) {
                 if (!v.isVertex()) {
                     continue;
@@ -92,6 +157,7 @@ Status DataCollectExecutor::collectSubgraph(const std::vector<std::string>& vars
                 }
             }
             auto originEdges = gnIter->getEdges();
+            uniqueEdges.reserve(uniqueEdges.size() + originEdges.values.size());
             for (auto& edge : originEdges.values) {
                 if (!edge.isEdge()) {
                     continue;
@@ -142,7 +208,19 @@ Status DataCollectExecutor::collectMToN(const std::vector<std::string>& vars,
     DataSet ds;
     ds.colNames = std::move(colNames_);
     DCHECK(!ds.colNames.empty());
-    std::unordered_set<const Row*> unique;
+    Arena arena;
+    auto unique = makeArenaSet<const Row*>(&arena);
+    if (distinct) {
+        size_t cap = 0;
+        for (auto& var : vars) {
+            auto& hist = ectx_->getHistory(var);
+            auto n = std::min(static_cast<size_t>(mToN.nSteps()), hist.size());
+            for (auto i = mToN.mSteps() - 1; i < n; ++i) {
+                cap += hist[i].size();
+            }
+        }
+        unique.reserve(cap);
+    }
     // itersHolder keep life cycle of iters util this method return.
     std::vector<std::unique_ptr<Iterator>> itersHolder;
     for (auto& var : vars) {
@@ -154,12 +232,15 @@ Status DataCollectExecutor::collectMToN(const std::vector<std::string>& vars,
             auto iter = hist[i].iter();
             if (iter->isSequentialIter()) {
                 auto* seqIter = static_cast<SequentialIter*>(iter.get());
-                while (seqIter->valid()) {
-                    if (distinct && !unique.emplace(seqIter->row()).second) {
-                        seqIter->unstableErase();
-                    } else {
-                        seqIter->next();
+                if (distinct) {
+                    std::vector<size_t> positions;
+                    size_t pos = 0;
+                    for (; seqIter->valid(); seqIter->next(), ++pos) {
+                        if (unique.emplace(seqIter->row()).second) {
+                            positions.emplace_back(pos);
+                        }
                     }
+                    seqIter->select(std::move(positions));
                 }
             } else {
                 std::stringstream msg;
@@ -275,16 +356,13 @@ Status DataCollectExecutor::collectMultiplePairShortestPath(const std::vector<st
     return Status::OK();
 }
 
-Status DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars) {
-    DataSet ds;
-    ds.colNames = colNames_;
-    DCHECK(!ds.colNames.empty());
+folly::Future<Status> DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars) {
     // 0: vertices's props, 1: Edges's props 2: paths without prop
     DCHECK_EQ(vars.size(), 3);
 
     auto vIter = ectx_->getResult(vars[0]).iter();
-    std::unordered_map<Value, Vertex> vertexMap;
-    vertexMap.reserve(vIter->size());
+    auto vertexMap = std::make_shared<VertexMap>();
+    vertexMap->reserve(vIter->size());
     DCHECK(vIter->isPropIter());
     for (; vIter->valid(); vIter->next()) {
         const auto& vertexVal = vIter->getVertex();
@@ -292,12 +370,12 @@ Status DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars
             continue;
         }
         const auto& vertex = vertexVal.getVertex();
-        vertexMap.insert(std::make_pair(vertex.vid, std::move(vertex)));
+        vertexMap->insert(std::make_pair(vertex.vid, std::move(vertex)));
     }
 
     auto eIter = ectx_->getResult(vars[1]).iter();
-    std::unordered_map<std::tuple<Value, EdgeType, EdgeRanking, Value>, Edge> edgeMap;
-    edgeMap.reserve(eIter->size());
+    auto edgeMap = std::make_shared<EdgeMap>();
+    edgeMap->reserve(eIter->size());
     DCHECK(eIter->isPropIter());
     for (; eIter->valid(); eIter->next()) {
         auto edgeVal = eIter->getEdge();
@@ -306,43 +384,34 @@ Status DataCollectExecutor::collectPathProp(const std::vector<std::string>& vars
         }
         auto& edge = edgeVal.getEdge();
         auto edgeKey = std::make_tuple(edge.src, edge.type, edge.ranking, edge.dst);
-        edgeMap.insert(std::make_pair(std::move(edgeKey), std::move(edge)));
+        edgeMap->insert(std::make_pair(std::move(edgeKey), std::move(edge)));
     }
 
     auto pIter = ectx_->getResult(vars[2]).iter();
     DCHECK(pIter->isSequentialIter());
-    for (; pIter->valid(); pIter->next()) {
-        auto& pathVal = pIter->getColumn(0);
-        if (!pathVal.isPath()) {
-            continue;
-        }
-        auto path = pathVal.getPath();
-        auto src = path.src.vid;
-        auto found = vertexMap.find(src);
-        if (found != vertexMap.end()) {
-            path.src = found->second;
-        }
-        for (auto& step : path.steps) {
-            auto dst = step.dst.vid;
-            step.dst = vertexMap[dst];
-
-            auto type = step.type;
-            auto ranking = step.ranking;
-            if (type < 0) {
-                dst = src;
-                src = step.dst.vid;
-                type = -type;
-            }
-            auto edgeKey = std::make_tuple(src, type, ranking, dst);
-            auto edge = edgeMap[edgeKey];
-            step.props = edge.props;
-            src = step.dst.vid;
-        }
-        ds.rows.emplace_back(Row({std::move(path)}));
+    if (!splittable(pIter.get())) {
+        DataSet ds;
+        ds.colNames = colNames_;
+        DCHECK(!ds.colNames.empty());
+        attachProps(*vertexMap, *edgeMap, pIter.get(), pIter->size(), &ds);
+        VLOG(2) << "Path with props : \n" << ds;
+        result_.setDataSet(std::move(ds));
+        return finishCollect();
     }
-    VLOG(2) << "Path with props : \n" << ds;
-    result_.setDataSet(std::move(ds));
-    return Status::OK();
+
+    auto kernel = [vertexMap, edgeMap](Iterator* morsel, size_t begin, size_t end) {
+        DataSet ds;
+        ds.rows.reserve(end - begin);
+        attachProps(*vertexMap, *edgeMap, morsel, end - begin, &ds);
+        return ds;
+    };
+    return runMorsels<DataSet>(std::move(pIter), std::move(kernel))
+        .thenValue([this](std::vector<DataSet>&& morsels) {
+            SCOPED_TIMER(&execTime_);
+            otherStats_.emplace("jobs", folly::to<std::string>(morsels.size()));
+            result_.setDataSet(concatMorsels(std::move(morsels), colNames_));
+            return finishCollect();
+        });
 }
 
 }  // namespace graph
@@ -21,6 +21,8 @@ public:
 private:
     folly::Future<Status> doCollect();
 
+    Status finishCollect();
+
     Status collectSubgraph(const std::vector<std::string>& vars);
 
     Status rowBasedMove(const std::vector<std::string>& vars);
@@ -33,7 +35,8 @@ private:
 
     Status collectMultiplePairShortestPath(const std::vector<std::string>& vars);
 
-    Status collectPathProp(const std::vector<std::string>& vars);
+    // The paths are built by the morsels concurrently if there are many
+    folly::Future<Status> collectPathProp(const std::vector<std::string>& vars);
 
     std::vector<std::string>    colNames_;
     Value                       result_;
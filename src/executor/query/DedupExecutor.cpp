@@ -7,10 +7,55 @@
 #include "executor/query/DedupExecutor.h"
 #include "planner/plan/Query.h"
 #include "context/QueryExpressionContext.h"
+#include "util/Arena.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
 namespace graph {
+namespace {
+
+// The row with its hash computed by the morsels
+struct HashedRow {
+    const Row*  row;
+    size_t      hash;
+
+    struct Hash {
+        size_t operator()(const HashedRow& r) const {
+            return r.hash;
+        }
+    };
+
+    struct Equal {
+        bool operator()(const HashedRow& lhs, const HashedRow& rhs) const {
+            return lhs.hash == rhs.hash && std::equal_to<const Row*>()(lhs.row, rhs.row);
+        }
+    };
+};
+
+// The nodes are allocated from an arena released at once on return
+using RowSet = std::unordered_set<const Row*,
+                                  std::hash<const Row*>,
+                                  std::equal_to<const Row*>,
+                                  ArenaAllocator<const Row*>>;
+using HashedRowSet =
+    std::unordered_set<HashedRow, HashedRow::Hash, HashedRow::Equal, ArenaAllocator<HashedRow>>;
+
+struct VidHash {
+    size_t operator()(const Value* vid) const {
+        return std::hash<Value>()(*vid);
+    }
+};
+
+struct VidEqual {
+    bool operator()(const Value* lhs, const Value* rhs) const {
+        return *lhs == *rhs;
+    }
+};
+
+using VidSet = std::unordered_set<const Value*, VidHash, VidEqual, ArenaAllocator<const Value*>>;
+
+}   // namespace
+
 folly::Future<Status> DedupExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* dedup = asNode<Dedup>(node());
@@ -28,18 +73,84 @@ folly::Future<Status> DedupExecutor::execute() {
         LOG(ERROR) << e;
         return e;
     }
-    std::unordered_set<const Row*> unique;
-    unique.reserve(iter->size());
-    while (iter->valid()) {
-        if (!unique.emplace(iter->row()).second) {
-            iter->unstableErase();
-        } else {
-            iter->next();
+    if (dedup->isVidFrontier()) {
+        dedupVids(iter);
+        return finish(std::move(result));
+    }
+    if (splittable(iter)) {
+        return dedupInParallel(std::move(result));
+    }
+    Arena arena;
+    RowSet unique(iter->size(),
+                  std::hash<const Row*>(),
+                  std::equal_to<const Row*>(),
+                  ArenaAllocator<const Row*>(&arena));
+    // Select the first occurrences at once rather than erasing the duplicates
+    std::vector<size_t> positions;
+    size_t pos = 0;
+    for (; iter->valid(); iter->next(), ++pos) {
+        if (unique.emplace(iter->row()).second) {
+            positions.emplace_back(pos);
         }
     }
-    iter->reset();
+    static_cast<SequentialIter*>(iter)->select(std::move(positions));
     return finish(std::move(result));
 }
 
+folly::Future<Status> DedupExecutor::dedupInParallel(Result result) {
+    // Hashing the rows is the most of the work, which is done by the morsels
+    auto kernel = [](Iterator* morsel, size_t begin, size_t end) {
+        std::vector<size_t> hashes;
+        hashes.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i, morsel->next()) {
+            hashes.emplace_back(std::hash<const Row*>()(morsel->row()));
+        }
+        return hashes;
+    };
+    using Hashes = std::vector<size_t>;
+    return runMorsels<Hashes>(result.iter(), std::move(kernel))
+        .thenValue([this, result = std::move(result)](std::vector<Hashes>&& morsels) mutable {
+            SCOPED_TIMER(&execTime_);
+            auto* iter = result.iterRef();
+            Arena arena;
+            HashedRowSet unique(iter->size(),
+                                HashedRow::Hash(),
+                                HashedRow::Equal(),
+                                ArenaAllocator<HashedRow>(&arena));
+            // Select the first occurrences in the origin order, the input rows which
+            // may be shared with the other executors are untouched
+            std::vector<size_t> positions;
+            size_t size = 0;
+            for (auto& hashes : morsels) {
+                for (auto h : hashes) {
+                    DCHECK(iter->valid());
+                    if (unique.emplace(HashedRow{iter->row(), h}).second) {
+                        positions.emplace_back(size);
+                    }
+                    ++size;
+                    iter->next();
+                }
+            }
+            DCHECK_EQ(size, iter->size());
+            static_cast<SequentialIter*>(iter)->select(std::move(positions));
+            otherStats_.emplace("jobs", folly::to<std::string>(morsels.size()));
+            return finish(std::move(result));
+        });
+}
+
+void DedupExecutor::dedupVids(Iterator* iter) {
+    // Nothing is kept across the steps of a loop, so the set goes with the arena
+    Arena arena;
+    VidSet unique(iter->size(), VidHash(), VidEqual(), ArenaAllocator<const Value*>(&arena));
+    std::vector<size_t> positions;
+    size_t pos = 0;
+    for (; iter->valid(); iter->next(), ++pos) {
+        if (unique.emplace(&iter->getColumn(0)).second) {
+            positions.emplace_back(pos);
+        }
+    }
+    static_cast<SequentialIter*>(iter)->select(std::move(positions));
+}
+
 }   // namespace graph
 }   // namespace nebula
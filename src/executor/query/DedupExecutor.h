@@ -18,6 +18,14 @@ public:
         : Executor("DedupExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+private:
+    // Hash the morsels of the rows concurrently, and then select the first occurrences
+    folly::Future<Status> dedupInParallel(Result result);
+
+    // Select the first occurrences of the vids of the frontier, which is deduplicated in
+    // each step only
+    void dedupVids(Iterator* iter);
 };
 
 }   // namespace graph
@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "executor/query/ExpandExecutor.h"
+
+#include "common/clients/storage/GraphStorageClient.h"
+#include "context/Iterator.h"
+#include "context/QueryContext.h"
+#include "service/GraphFlags.h"
+#include "util/ScopedTimer.h"
+
+using nebula::storage::GraphStorageClient;
+
+namespace nebula {
+namespace graph {
+
+folly::Future<Status> ExpandExecutor::execute() {
+    DataSet reqDs;
+    {
+        SCOPED_TIMER(&execTime_);
+        auto iter = ectx_->getResult(expand_->inputVar()).iter();
+        reqDs = buildRequestDataSetByVidType(iter.get(), expand_->src(), expand_->dedup());
+
+        colNames_ = std::move(reqDs.colNames);
+        start(reqDs.rows);
+    }
+
+    return expandStep(0, std::move(reqDs.rows)).thenValue([this](Status status) {
+        SCOPED_TIMER(&execTime_);
+        NG_RETURN_IF_ERROR(status);
+        otherStats_.emplace("requests", folly::to<std::string>(numRequests_));
+
+        DataSet ds;
+        ds.colNames = node()->colNames();
+        // Not reached if the expansion stopped on the way
+        auto last = steps_.find(expand_->steps());
+        if (last != steps_.end()) {
+            last->second.frontier.forEach([this, &ds](uint32_t id) {
+                Row row;
+                row.values.emplace_back(vids_.vid(id));
+                ds.rows.emplace_back(std::move(row));
+            });
+        }
+        steps_.clear();
+        vids_ = VidDict();
+        return finish(ResultBuilder().state(state_).value(Value(std::move(ds))).finish());
+    });
+}
+
+void ExpandExecutor::start(const std::vector<Row>& srcs) {
+    // The executor is run once for each execution of the plan
+    vids_ = VidDict();
+    steps_.clear();
+    state_ = Result::State::kSuccess;
+    numRequests_ = 0;
+    batchSize_ = std::max<uint32_t>(FLAGS_expand_batch_size, 1);
+    auto& first = steps_[0];
+    for (auto& row : srcs) {
+        first.frontier.add(vids_.intern(row.values.front()).first);
+    }
+    if (expand_->steps() > 0) {
+        first.requests = numBatches(srcs.size());
+    }
+}
+
+void ExpandExecutor::releaseSteps() {
+    // No request of the steps before is left to add to the frontier of the first step,
+    // so it is done once its own requests are responded
+    while (!steps_.empty()) {
+        auto first = steps_.begin();
+        if (first->first >= expand_->steps() || first->second.requests > 0) {
+            break;
+        }
+        steps_.erase(first);
+    }
+}
+
+folly::Future<Status> ExpandExecutor::expandStep(size_t step, std::vector<Row> vids) {
+    if (step >= expand_->steps() || vids.empty()) {
+        return Status::OK();
+    }
+    if (qctx_->isKilled()) {
+        return Status::Error("Execution had been killed");
+    }
+    // The requests are accounted to the step by numBatches already
+    std::vector<folly::Future<Status>> futures;
+    futures.reserve(numBatches(vids.size()));
+    for (size_t begin = 0; begin < vids.size(); begin += batchSize_) {
+        auto end = std::min(begin + batchSize_, vids.size());
+        futures.emplace_back(expandBatch(step,
+                                         std::vector<Row>(
+                                             std::make_move_iterator(vids.begin() + begin),
+                                             std::make_move_iterator(vids.begin() + end))));
+    }
+    return folly::collect(futures).via(runner()).thenValue([](std::vector<Status> results) {
+        for (auto& status : results) {
+            NG_RETURN_IF_ERROR(status);
+        }
+        return Status::OK();
+    });
+}
+
+folly::Future<Status> ExpandExecutor::expandBatch(size_t step, std::vector<Row> vids) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        ++numRequests_;
+    }
+    GraphStorageClient* storageClient = qctx_->getStorageClient();
+    return storageClient
+        ->getNeighbors(expand_->space(),
+                       colNames_,
+                       std::move(vids),
+                       std::vector<EdgeType>(),
+                       storage::cpp2::EdgeDirection::OUT_EDGE,
+                       nullptr,
+                       nullptr,
+                       expand_->edgeProps(),
+                       nullptr,
+                       expand_->dedup(),
+                       false,
+                       expand_->orderBy(),
+                       expand_->limit(),
+                       expand_->filter())
+        .via(runner())
+        .thenValue([this, step](RpcResponse&& resp) -> folly::Future<Status> {
+            auto next = handleResponse(step, std::move(resp));
+            NG_RETURN_IF_ERROR(next);
+            // Go on with the new vertices of this response regardless of the other ones
+            return expandStep(step + 1, std::move(next).value());
+        });
+}
+
+StatusOr<std::vector<Row>> ExpandExecutor::handleResponse(size_t step, RpcResponse&& resp) {
+    auto result = handleCompleteness(resp, FLAGS_accept_partial_success);
+    NG_RETURN_IF_ERROR(result);
+
+    GetNeighborsIter iter(std::make_shared<Value>(moveVertices(resp)));
+
+    std::vector<Row> vids;
+    // The destinations of the last step are only collected
+    bool toExpand = step + 1 < expand_->steps();
+    std::lock_guard<std::mutex> guard(lock_);
+    SCOPED_TIMER(&execTime_);
+    if (result.value() != Result::State::kSuccess) {
+        state_ = result.value();
+    }
+    auto& next = steps_[step + 1];
+    for (; iter.valid(); iter.next()) {
+        const auto& dst = iter.getEdgeProp("*", kDst);
+        if (!dst.isStr() && !dst.isInt()) {
+            continue;
+        }
+        if (next.frontier.add(vids_.intern(dst).first) && toExpand) {
+            Row row;
+            row.values.emplace_back(dst);
+            vids.emplace_back(std::move(row));
+        }
+    }
+    // Account the requests of the new vertices before this one is done, so that the
+    // next step is not taken as done in between
+    next.requests += numBatches(vids.size());
+    auto current = steps_.find(step);
+    DCHECK(current != steps_.end());
+    DCHECK_GT(current->second.requests, 0);
+    --current->second.requests;
+    releaseSteps();
+    return vids;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,93 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXECUTOR_QUERY_EXPANDEXECUTOR_H_
+#define EXECUTOR_QUERY_EXPANDEXECUTOR_H_
+
+#include <map>
+#include <mutex>
+
+#include "common/interface/gen-cpp2/storage_types.h"
+
+#include "executor/StorageAccessExecutor.h"
+#include "planner/plan/Query.h"
+#include "util/VidBitmap.h"
+#include "util/VidDict.h"
+
+namespace nebula {
+namespace graph {
+
+// Expand the source vertices step by step without the barrier between the steps.
+//
+// The frontier of a step is requested in the batches of expand_batch_size, and the
+// destinations in the response of each batch are deduped into the frontier of the next
+// step, whose new vertices are requested at once. So a slow storage only delays the
+// vertices it serves rather than the whole next step, and the latencies of the slowest
+// responses are not summed up over the steps.
+//
+// The frontier of each step is the same as expanding the whole previous step at once,
+// only the order of the output differs. The states of a step are created once it is
+// reached, and dropped once all the responses of it and the steps before are handled.
+class ExpandExecutor final : public StorageAccessExecutor {
+public:
+    ExpandExecutor(const PlanNode *node, QueryContext *qctx)
+        : StorageAccessExecutor("ExpandExecutor", node, qctx) {
+        expand_ = asNode<Expand>(node);
+    }
+
+    folly::Future<Status> execute() override;
+
+private:
+    friend class ExpandTest_HandleResponse_Test;
+    friend class ExpandTest_PartialSuccess_Test;
+    friend class ExpandTest_ReleaseSteps_Test;
+
+    using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
+
+    struct Step {
+        // The vertices reached by the step
+        VidBitmap   frontier;
+        // The requests for the neighbors of the frontier not responded yet
+        size_t      requests{0};
+    };
+
+    // Reset the states to start from `srcs'
+    void start(const std::vector<Row>& srcs);
+
+    size_t numBatches(size_t numVids) const {
+        return (numVids + batchSize_ - 1) / batchSize_;
+    }
+
+    // Drop the steps whose frontiers are neither added to nor expanded any more,
+    // but the last one
+    void releaseSteps();
+
+    // Request the neighbors of `vids', which are in the frontier of `step'
+    folly::Future<Status> expandStep(size_t step, std::vector<Row> vids);
+
+    folly::Future<Status> expandBatch(size_t step, std::vector<Row> vids);
+
+    // Add the destinations of the response to the frontier of the next step of `step',
+    // and return the ones added just now which are to expand
+    StatusOr<std::vector<Row>> handleResponse(size_t step, RpcResponse &&resp);
+
+    const Expand*                   expand_;
+    std::vector<std::string>        colNames_;
+
+    // Guard the following states shared by the responses
+    std::mutex                      lock_;
+    VidDict                         vids_;
+    // The live steps by the number, the step 0 is the source vertices
+    std::map<size_t, Step>          steps_;
+    size_t                          batchSize_{1};
+    Result::State                   state_{Result::State::kSuccess};
+    size_t                          numRequests_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // EXECUTOR_QUERY_EXPANDEXECUTOR_H_
@@ -8,12 +8,23 @@
 
 #include "planner/plan/Query.h"
 
+#include "context/BatchExpression.h"
 #include "context/QueryExpressionContext.h"
+#include "service/GraphFlags.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
 namespace graph {
 
+// static
+StatusOr<bool> FilterExecutor::isPassed(const Value &val) {
+    if (val.isBadNull() || (!val.empty() && !val.isBool() && !val.isNull())) {
+        return Status::Error("Internal Error: Wrong type result, "
+                             "the type should be NULL,EMPTY or BOOL");
+    }
+    return !(val.empty() || val.isNull() || !val.getBool());
+}
+
 folly::Future<Status> FilterExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* filter = asNode<Filter>(node());
@@ -28,22 +39,36 @@ folly::Future<Status> FilterExecutor::execute() {
             << ", iterator type: " << static_cast<int16_t>(iter->kind())
             << ", input data size: " << iter->size();
 
+    if (splittable(iter)) {
+        return filterInParallel(std::move(result));
+    }
+
     ResultBuilder builder;
     builder.value(result.valuePtr());
-    QueryExpressionContext ctx(ectx_);
     auto condition = filter->condition();
+    if (iter->isSequentialIter() || iter->isPropIter()) {
+        // Select the passed rows at once rather than erasing the others one by one,
+        // which is quadratic for the stable filter
+        auto *seqIter = static_cast<SequentialIter *>(iter);
+        std::unique_ptr<BatchExpression> batchCond;
+        if (FLAGS_enable_batch_eval) {
+            batchCond = BatchExpression::compile(condition, seqIter->getColIndices());
+        }
+        auto passed = evalCondition(condition, batchCond.get(), seqIter, 0, seqIter->size());
+        NG_RETURN_IF_ERROR(passed);
+        selectPassed(seqIter, {std::move(passed).value()});
+        builder.iter(std::move(result).iter());
+        return finish(builder.finish());
+    }
+
+    // The rows of GetNeighborsIter are erased by marking its bitset
+    QueryExpressionContext ctx(ectx_);
     while (iter->valid()) {
         auto val = condition->eval(ctx(iter));
-        if (val.isBadNull() || (!val.empty() && !val.isBool() && !val.isNull())) {
-            return Status::Error("Internal Error: Wrong type result, "
-                                 "the type should be NULL,EMPTY or BOOL");
-        }
-        if (val.empty() || val.isNull() || !val.getBool()) {
-            if (UNLIKELY(filter->needStableFilter())) {
-                iter->erase();
-            } else {
-                iter->unstableErase();
-            }
+        auto passed = isPassed(val);
+        NG_RETURN_IF_ERROR(passed);
+        if (!std::move(passed).value()) {
+            iter->erase();
         } else {
             iter->next();
         }
@@ -54,5 +79,94 @@ folly::Future<Status> FilterExecutor::execute() {
     return finish(builder.finish());
 }
 
+folly::Future<Status> FilterExecutor::filterInParallel(Result result) {
+    auto* filter = asNode<Filter>(node());
+    auto* iter = static_cast<SequentialIter *>(result.iterRef());
+    std::shared_ptr<const BatchExpression> batchCond;
+    if (FLAGS_enable_batch_eval) {
+        batchCond = BatchExpression::compile(filter->condition(), iter->getColIndices());
+    }
+
+    // The rows are selected after all the morsels are evaluated
+    auto kernel = [this, filter, batchCond](Iterator* morsel, size_t begin, size_t end)
+        -> StatusOr<boost::dynamic_bitset<>> {
+        JobExprs condition(qctx_, {filter->condition()});
+        return evalCondition(
+            condition[0], batchCond.get(), static_cast<SequentialIter *>(morsel), begin, end);
+    };
+    using Passed = StatusOr<boost::dynamic_bitset<>>;
+    return runMorsels<Passed>(result.iter(), std::move(kernel))
+        .thenValue([this, result = std::move(result)](std::vector<Passed>&& partials) mutable {
+            SCOPED_TIMER(&execTime_);
+            std::vector<boost::dynamic_bitset<>> passed;
+            passed.reserve(partials.size());
+            for (auto& partial : partials) {
+                NG_RETURN_IF_ERROR(partial);
+                passed.emplace_back(std::move(partial).value());
+            }
+            selectPassed(static_cast<SequentialIter *>(result.iterRef()), passed);
+            otherStats_.emplace("jobs", folly::to<std::string>(passed.size()));
+            ResultBuilder builder;
+            builder.value(result.valuePtr()).iter(std::move(result).iter());
+            return finish(builder.finish());
+        });
+}
+
+StatusOr<boost::dynamic_bitset<>> FilterExecutor::evalCondition(Expression *condition,
+                                                                const BatchExpression *batchCond,
+                                                                SequentialIter *iter,
+                                                                size_t begin,
+                                                                size_t end) {
+    QueryExpressionContext ctx(ectx_);
+    boost::dynamic_bitset<> passed(end - begin);
+    if (batchCond == nullptr) {
+        iter->reset(begin);
+        for (size_t i = 0; i < end - begin; ++i, iter->next()) {
+            auto result = isPassed(condition->eval(ctx(iter)));
+            NG_RETURN_IF_ERROR(result);
+            passed[i] = std::move(result).value();
+        }
+        return passed;
+    }
+
+    for (size_t first = begin; first < end; first += ColumnBatch::kDefaultSize) {
+        auto last = std::min(first + ColumnBatch::kDefaultSize, end);
+        auto batch = iter->columnBatch(first, last, batchCond->colIndices());
+        BatchVector vec;
+        batchCond->eval(batch, &vec);
+        bool isBool = vec.kind == Column::Kind::kBool;
+        for (size_t i = 0; i < batch.numRows(); ++i) {
+            if (isBool && !vec.isFallback(i)) {
+                passed[first - begin + i] = vec.bools[i];
+                continue;
+            }
+            // Evaluate the rows which have no typed result one by one
+            iter->reset(first + i);
+            auto result = isPassed(condition->eval(ctx(iter)));
+            NG_RETURN_IF_ERROR(result);
+            passed[first - begin + i] = std::move(result).value();
+        }
+    }
+    return passed;
+}
+
+// static
+void FilterExecutor::selectPassed(SequentialIter *iter,
+                                  const std::vector<boost::dynamic_bitset<>> &passed) {
+    // Select the passed rows in the origin order, the input rows which may be
+    // shared with the other executors are neither moved nor erased
+    std::vector<size_t> positions;
+    size_t size = 0;
+    for (auto &morsel : passed) {
+        for (size_t i = 0; i < morsel.size(); ++i, ++size) {
+            if (morsel[i]) {
+                positions.emplace_back(size);
+            }
+        }
+    }
+    DCHECK_EQ(size, iter->size());
+    iter->select(std::move(positions));
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -7,17 +7,39 @@
 #ifndef EXECUTOR_QUERY_FILTEREXECUTOR_H_
 #define EXECUTOR_QUERY_FILTEREXECUTOR_H_
 
+#include "common/expression/Expression.h"
 #include "executor/Executor.h"
 
 namespace nebula {
 namespace graph {
 
+class BatchExpression;
+
 class FilterExecutor final : public Executor {
 public:
     FilterExecutor(const PlanNode *node, QueryContext *qctx)
         : Executor("FilterExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+    // Whether the row passes the condition evaluated to `val'
+    static StatusOr<bool> isPassed(const Value &val);
+
+private:
+    // Evaluate the condition over the morsels of the rows concurrently
+    folly::Future<Status> filterInParallel(Result result);
+
+    // Return whether each of the rows [begin, end) passes the condition, which is
+    // evaluated over blocks of rows by the batch kernels if `batchCond' is given
+    StatusOr<boost::dynamic_bitset<>> evalCondition(Expression *condition,
+                                                    const BatchExpression *batchCond,
+                                                    SequentialIter *iter,
+                                                    size_t begin,
+                                                    size_t end);
+
+    // Select the rows passed, `passed' is of the morsels in order
+    static void selectPassed(SequentialIter *iter,
+                             const std::vector<boost::dynamic_bitset<>> &passed);
 };
 
 }   // namespace graph
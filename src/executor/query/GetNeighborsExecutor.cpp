@@ -11,6 +11,7 @@
 #include "common/clients/storage/GraphStorageClient.h"
 #include "common/datatypes/List.h"
 #include "common/datatypes/Vertex.h"
+#include "context/Iterator.h"
 #include "context/QueryContext.h"
 #include "util/ScopedTimer.h"
 #include "service/GraphFlags.h"
@@ -40,24 +41,19 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
                           .finish());
     }
 
+    // Fetch the neighbors of a part of the vertices at a time if only a few of the rows
+    // are required, and stop once there are enough rows
+    if (gn_->limit() >= 0 && static_cast<int64_t>(reqDs.rows.size()) > gn_->limit() &&
+        !gn_->random() && (gn_->orderBy() == nullptr || gn_->orderBy()->empty())) {
+        auto rounds = std::make_shared<Rounds>();
+        rounds->colNames = std::move(reqDs.colNames);
+        rounds->vids = std::move(reqDs.rows);
+        rounds->roundSize = std::max<int64_t>(gn_->limit(), 1);
+        return getNeighborsInRounds(std::move(rounds));
+    }
+
     time::Duration getNbrTime;
-    GraphStorageClient* storageClient = qctx_->getStorageClient();
-    return storageClient
-        ->getNeighbors(gn_->space(),
-                       std::move(reqDs.colNames),
-                       std::move(reqDs.rows),
-                       gn_->edgeTypes(),
-                       gn_->edgeDirection(),
-                       gn_->statProps(),
-                       gn_->vertexProps(),
-                       gn_->edgeProps(),
-                       gn_->exprs(),
-                       gn_->dedup(),
-                       gn_->random(),
-                       gn_->orderBy(),
-                       gn_->limit(),
-                       gn_->filter())
-        .via(runner())
+    return getNeighbors(std::move(reqDs.colNames), std::move(reqDs.rows))
         .ensure([this, getNbrTime]() {
             SCOPED_TIMER(&execTime_);
             otherStats_.emplace("total_rpc_time",
@@ -83,26 +79,93 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
         });
 }
 
+folly::Future<GetNeighborsExecutor::RpcResponse> GetNeighborsExecutor::getNeighbors(
+    std::vector<std::string> colNames,
+    std::vector<Row> vids) {
+    GraphStorageClient* storageClient = qctx_->getStorageClient();
+    return storageClient
+        ->getNeighbors(gn_->space(),
+                       std::move(colNames),
+                       std::move(vids),
+                       gn_->edgeTypes(),
+                       gn_->edgeDirection(),
+                       gn_->statProps(),
+                       gn_->vertexProps(),
+                       gn_->edgeProps(),
+                       gn_->exprs(),
+                       gn_->dedup(),
+                       gn_->random(),
+                       gn_->orderBy(),
+                       gn_->limit(),
+                       gn_->filter())
+        .via(runner());
+}
+
+folly::Future<Status> GetNeighborsExecutor::getNeighborsInRounds(std::shared_ptr<Rounds> rounds) {
+    if (qctx_->isKilled()) {
+        return Status::Error("Execution had been killed");
+    }
+    return getNeighbors(rounds->colNames, nextRound(rounds.get()))
+        .thenValue([this, rounds](RpcResponse&& resp) -> folly::Future<Status> {
+            SCOPED_TIMER(&execTime_);
+            auto more = handleRound(rounds.get(), std::move(resp));
+            NG_RETURN_IF_ERROR(more);
+            if (more.value()) {
+                return getNeighborsInRounds(rounds);
+            }
+            return finishRounds(rounds.get());
+        });
+}
+
+std::vector<Row> GetNeighborsExecutor::nextRound(Rounds* rounds) {
+    auto begin = rounds->next;
+    auto end = std::min(begin + rounds->roundSize, rounds->vids.size());
+    std::vector<Row> vids(std::make_move_iterator(rounds->vids.begin() + begin),
+                          std::make_move_iterator(rounds->vids.begin() + end));
+    rounds->next = end;
+    // Double the vertices of the next round for the vertices without enough neighbors
+    rounds->roundSize *= 2;
+    ++rounds->numRounds;
+    return vids;
+}
+
+StatusOr<bool> GetNeighborsExecutor::handleRound(Rounds* rounds, RpcResponse&& resp) {
+    auto result = handleCompleteness(resp, FLAGS_accept_partial_success);
+    NG_RETURN_IF_ERROR(result);
+    if (result.value() != Result::State::kSuccess) {
+        rounds->state = result.value();
+    }
+
+    // Count the rows as the downstream iterates them
+    auto value = std::make_shared<Value>(moveVertices(resp));
+    for (GetNeighborsIter iter(value); iter.valid(); iter.next()) {
+        ++rounds->numRows;
+    }
+    for (auto& ds : value->mutableList().values) {
+        rounds->list.values.emplace_back(std::move(ds));
+    }
+    return rounds->numRows < gn_->limit() && rounds->next < rounds->vids.size();
+}
+
+Status GetNeighborsExecutor::finishRounds(Rounds* rounds) {
+    otherStats_.emplace("rounds", folly::to<std::string>(rounds->numRounds));
+    otherStats_.emplace("skipped vertices",
+                        folly::to<std::string>(rounds->vids.size() - rounds->next));
+    return finish(ResultBuilder()
+                      .state(rounds->state)
+                      .value(Value(std::move(rounds->list)))
+                      .iter(Iterator::Kind::kGetNeighbors)
+                      .finish());
+}
+
 Status GetNeighborsExecutor::handleResponse(RpcResponse& resps) {
     auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
     NG_RETURN_IF_ERROR(result);
     ResultBuilder builder;
     builder.state(result.value());
 
-    auto& responses = resps.responses();
-    VLOG(2) << node_->toString() << ", Resp size: " << responses.size();
-    List list;
-    for (auto& resp : responses) {
-        auto dataset = resp.get_vertices();
-        if (dataset == nullptr) {
-            LOG(INFO) << "Empty dataset in response";
-            continue;
-        }
-
-        VLOG(2) << "Resp row size: " << dataset->rows.size() << ", Resp: " << *dataset;
-        list.values.emplace_back(std::move(*dataset));
-    }
-    builder.value(Value(std::move(list)));
+    VLOG(2) << node_->toString() << ", Resp size: " << resps.responses().size();
+    builder.value(Value(moveVertices(resps)));
     return finish(builder.iter(Iterator::Kind::kGetNeighbors).finish());
 }
 
@@ -27,7 +27,38 @@ public:
     DataSet buildRequestDataSet();
 
 private:
+    friend class GetNeighborsTest_Rounds_Test;
+    friend class GetNeighborsTest_ErrorInRound_Test;
+
     using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
+
+    // The state of fetching the neighbors of the source vertices part by part
+    struct Rounds {
+        std::vector<std::string>    colNames;
+        std::vector<Row>            vids;
+        // The first vertex of the next round
+        size_t                      next{0};
+        size_t                      roundSize{0};
+        size_t                      numRounds{0};
+        int64_t                     numRows{0};
+        List                        list;
+        Result::State               state{Result::State::kSuccess};
+    };
+
+    folly::Future<RpcResponse> getNeighbors(std::vector<std::string> colNames,
+                                            std::vector<Row> vids);
+
+    // Issue the next round until the rows reach the limit or all vertices are requested
+    folly::Future<Status> getNeighborsInRounds(std::shared_ptr<Rounds> rounds);
+
+    // Take the source vertices of the next round
+    std::vector<Row> nextRound(Rounds* rounds);
+
+    // Collect the response of a round, and return whether to go on with the next round
+    StatusOr<bool> handleRound(Rounds* rounds, RpcResponse&& resp);
+
+    Status finishRounds(Rounds* rounds);
+
     Status handleResponse(RpcResponse& resps);
 
 private:
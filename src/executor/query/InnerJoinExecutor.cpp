@@ -26,104 +26,64 @@ Status InnerJoinExecutor::close() {
 
 folly::Future<Status> InnerJoinExecutor::join() {
     auto* join = asNode<Join>(node());
-    auto bucketSize = lhsIter_->size() > rhsIter_->size() ? rhsIter_->size() : lhsIter_->size();
-
     auto& hashKeys = join->hashKeys();
     auto& probeKeys = join->probeKeys();
     DCHECK_EQ(hashKeys.size(), probeKeys.size());
-    DataSet result;
 
     if (lhsIter_->empty() || rhsIter_->empty()) {
+        DataSet result;
         result.colNames = join->colNames();
         return finish(ResultBuilder().value(Value(std::move(result))).finish());
     }
 
-    if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-        std::unordered_map<Value, std::vector<const Row*>> hashTable;
-        hashTable.reserve(bucketSize);
-        if (lhsIter_->size() < rhsIter_->size()) {
-            buildSingleKeyHashTable(hashKeys.front(), lhsIter_.get(), hashTable);
-            result = singleKeyProbe(probeKeys.front(), rhsIter_.get(), hashTable);
-        } else {
-            exchange_ = true;
-            buildSingleKeyHashTable(probeKeys.front(), rhsIter_.get(), hashTable);
-            result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
-        }
-    } else {
-        std::unordered_map<List, std::vector<const Row*>> hashTable;
-        hashTable.reserve(bucketSize);
-        if (lhsIter_->size() < rhsIter_->size()) {
-            buildHashTable(join->hashKeys(), lhsIter_.get(), hashTable);
-            result = probe(join->probeKeys(), rhsIter_.get(), hashTable);
-        } else {
-            exchange_ = true;
-            buildHashTable(join->probeKeys(), rhsIter_.get(), hashTable);
-            result = probe(join->hashKeys(), lhsIter_.get(), hashTable);
-        }
+    // Build the hash table on the smaller side
+    exchange_ = lhsIter_->size() >= rhsIter_->size();
+    auto& buildKeys = exchange_ ? probeKeys : hashKeys;
+    auto& buildIter = exchange_ ? rhsIter_ : lhsIter_;
+    auto& probeSideKeys = exchange_ ? hashKeys : probeKeys;
+    auto& probeIter = exchange_ ? lhsIter_ : rhsIter_;
+    if (hashKeys.size() == 1) {
+        return this->join<Value>(buildKeys, buildIter, probeSideKeys, probeIter);
     }
-    result.colNames = join->colNames();
-    return finish(ResultBuilder().value(Value(std::move(result))).finish());
+    return this->join<List>(buildKeys, buildIter, probeSideKeys, probeIter);
 }
 
-DataSet InnerJoinExecutor::probe(
-    const std::vector<Expression*>& probeKeys,
-    Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
-    DataSet ds;
-    QueryExpressionContext ctx(ectx_);
-    ds.rows.reserve(probeIter->size());
-    for (; probeIter->valid(); probeIter->next()) {
-        List list;
-        list.values.reserve(probeKeys.size());
-        for (auto& col : probeKeys) {
-            Value val = col->eval(ctx(probeIter));
-            list.values.emplace_back(std::move(val));
+template <typename K>
+folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& buildKeys,
+                                              std::shared_ptr<Iterator> buildIter,
+                                              const std::vector<Expression*>& probeKeys,
+                                              std::shared_ptr<Iterator> probeIter) {
+    // The rows of the lhs are always in front of the rows of the rhs
+    auto exchange = exchange_;
+    auto joinRows = [exchange](const Row& probeRow,
+                               const std::vector<const Row*>* buildRows,
+                               DataSet* ds) {
+        if (buildRows == nullptr) {
+            return;
         }
-        buildNewRow<List>(hashTable, list, *probeIter->row(), ds);
-    }
-    return ds;
-}
-
-DataSet InnerJoinExecutor::singleKeyProbe(
-    Expression* probeKey,
-    Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
-    DataSet ds;
-    QueryExpressionContext ctx(ectx_);
-    for (; probeIter->valid(); probeIter->next()) {
-        auto& val = probeKey->eval(ctx(probeIter));
-        buildNewRow<Value>(hashTable, val, *probeIter->row(), ds);
-    }
-    return ds;
-}
-
-template <class T>
-void InnerJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                                    const T& val,
-                                    const Row& rRow,
-                                    DataSet& ds) const {
-    const auto& range = hashTable.find(val);
-    if (range == hashTable.end()) {
-        return;
-    }
-    for (auto* row : range->second) {
-        auto& lRow = *row;
-        Row newRow;
-        newRow.reserve(lRow.size() + rRow.size());
-        auto& values = newRow.values;
-        if (exchange_) {
-            values.insert(values.end(),
-                    std::make_move_iterator(rRow.values.begin()),
-                    std::make_move_iterator(rRow.values.end()));
+        for (auto* buildRow : *buildRows) {
+            auto& lRow = exchange ? probeRow : *buildRow;
+            auto& rRow = exchange ? *buildRow : probeRow;
+            Row newRow;
+            auto& values = newRow.values;
+            values.reserve(lRow.size() + rRow.size());
             values.insert(values.end(), lRow.values.begin(), lRow.values.end());
-        } else {
-            values.insert(values.end(), lRow.values.begin(), lRow.values.end());
-            values.insert(values.end(),
-                    std::make_move_iterator(rRow.values.begin()),
-                    std::make_move_iterator(rRow.values.end()));
+            values.insert(values.end(), rRow.values.begin(), rRow.values.end());
+            ds->rows.emplace_back(std::move(newRow));
         }
-        ds.rows.emplace_back(std::move(newRow));
-    }
+    };
+    return buildHashTable<K>(buildKeys, std::move(buildIter))
+        .thenValue([this, probeKeys, probeIter, joinRows](
+                       std::shared_ptr<PartitionedHashTable<K>> hashTable) {
+            return probe<K>(probeKeys, probeIter, std::move(hashTable), joinRows);
+        })
+        .thenValue([this](DataSet result) {
+            SCOPED_TIMER(&execTime_);
+            otherStats_.emplace("build side", exchange_ ? "rhs" : "lhs");
+            result.colNames = asNode<Join>(node())->colNames();
+            return finish(ResultBuilder().value(Value(std::move(result))).finish());
+        });
 }
+
 }   // namespace graph
 }   // namespace nebula
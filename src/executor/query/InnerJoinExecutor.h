@@ -24,20 +24,11 @@ public:
 private:
     folly::Future<Status> join();
 
-    DataSet probe(const std::vector<Expression*>& probeKeys,
-                  Iterator* probeIter,
-                  const std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
-
-    DataSet singleKeyProbe(
-        Expression* probeKey,
-        Iterator* probeIter,
-        const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const;
-
-    template <class T>
-    void buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                     const T& val,
-                     const Row& rRow,
-                     DataSet& ds) const;
+    template <typename K>
+    folly::Future<Status> join(const std::vector<Expression*>& buildKeys,
+                               std::shared_ptr<Iterator> buildIter,
+                               const std::vector<Expression*>& probeKeys,
+                               std::shared_ptr<Iterator> probeIter);
 
 private:
     bool exchange_{false};
@@ -39,14 +39,7 @@ folly::Future<Status> IntersectExecutor::execute() {
         return finish(builder.finish());
     }
 
-    while (lIter->valid()) {
-        auto iter = hashSet.find(lIter->row());
-        if (iter == hashSet.end()) {
-            lIter->unstableErase();
-        } else {
-            lIter->next();
-        }
-    }
+    keepRows(lIter, [&hashSet](const Row *row) { return hashSet.find(row) != hashSet.end(); });
 
     builder.value(left.valuePtr()).iter(std::move(left).iter());
     return finish(builder.finish());
@@ -13,6 +13,36 @@
 namespace nebula {
 namespace graph {
 
+namespace {
+
+template <typename K>
+struct KeyedRow {
+    size_t          hash;
+    K               key;
+    const Row*      row;
+};
+
+const Value& evalKey(const std::vector<Expression*>& keys,
+                     QueryExpressionContext& ctx,
+                     Iterator* iter,
+                     Value*) {
+    return keys.front()->eval(ctx(iter));
+}
+
+// Evaluate the multiple keys into the reused `buffer'
+const List& evalKey(const std::vector<Expression*>& keys,
+                    QueryExpressionContext& ctx,
+                    Iterator* iter,
+                    List* buffer) {
+    buffer->values.clear();
+    for (auto* key : keys) {
+        buffer->values.emplace_back(key->eval(ctx(iter)));
+    }
+    return *buffer;
+}
+
+}   // namespace
+
 Status JoinExecutor::checkInputDataSets() {
     auto* join = asNode<Join>(node());
     lhsIter_ = ectx_->getVersionedResult(join->leftVar().first, join->leftVar().second).iter();
@@ -36,36 +66,139 @@ Status JoinExecutor::checkInputDataSets() {
     return Status::OK();
 }
 
-void JoinExecutor::buildHashTable(
-    const std::vector<Expression*>& hashKeys,
-    Iterator* iter,
-    std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
-    QueryExpressionContext ctx(ectx_);
-    for (; iter->valid(); iter->next()) {
-        List list;
-        list.values.reserve(hashKeys.size());
-        for (auto& col : hashKeys) {
-            Value val = col->eval(ctx(iter));
-            list.values.emplace_back(std::move(val));
+template <typename K>
+folly::Future<std::shared_ptr<JoinExecutor::PartitionedHashTable<K>>>
+JoinExecutor::buildHashTable(const std::vector<Expression*>& keys,
+                             std::shared_ptr<Iterator> iter) {
+    auto size = iter->size();
+    if (!splittable(iter.get())) {
+        auto hashTable = std::make_shared<PartitionedHashTable<K>>();
+        hashTable->partitions.emplace_back(size);
+        auto& partition = hashTable->partitions.front();
+        QueryExpressionContext ctx(ectx_);
+        K buffer;
+        for (; iter->valid(); iter->next()) {
+            const auto& key = evalKey(keys, ctx, iter.get(), &buffer);
+            partition.tryEmplace(key, HashTable<K>::hash(key)).first->emplace_back(iter->row());
         }
-
-        auto& vals = hashTable[list];
-        vals.emplace_back(iter->row());
+        return folly::makeFuture(std::move(hashTable));
     }
-}
 
-void JoinExecutor::buildSingleKeyHashTable(
-    Expression* hashKey,
-    Iterator* iter,
-    std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
-    QueryExpressionContext ctx(ectx_);
-    for (; iter->valid(); iter->next()) {
-        auto& val = hashKey->eval(ctx(iter));
+    // Scatter the rows into the partitions by ranges first, then build each
+    // partition by one job.
+    auto numPartitions = numJobs(size);
+    using Scattered = std::vector<std::vector<KeyedRow<K>>>;
+    auto scatter = [this, keys, iter, numPartitions](size_t begin, size_t end) -> Scattered {
+        JobExprs jobKeys(qctx_, keys);
+        auto jobIter = iter->copy();
+        jobIter->reset(begin);
+        QueryExpressionContext ctx(ectx_);
+        Scattered scattered(numPartitions);
+        K buffer;
+        for (size_t i = begin; i < end && jobIter->valid(); ++i, jobIter->next()) {
+            const auto& key = evalKey(jobKeys.clones(), ctx, jobIter.get(), &buffer);
+            auto h = HashTable<K>::hash(key);
+            auto& rows = scattered[PartitionedHashTable<K>::partitionOf(h, numPartitions)];
+            rows.emplace_back(KeyedRow<K>{h, key, jobIter->row()});
+        }
+        return scattered;
+    };
+
+    return runMultiJobs<Scattered>(size, std::move(scatter))
+        .thenValue([this, numPartitions](std::vector<Scattered>&& ranges) {
+            auto shared = std::make_shared<std::vector<Scattered>>(std::move(ranges));
+            std::vector<folly::Future<HashTable<K>>> futures;
+            futures.reserve(numPartitions);
+            for (size_t p = 0; p < numPartitions; ++p) {
+                futures.emplace_back(folly::via(runner(), [shared, p]() {
+                    size_t rows = 0;
+                    for (auto& scattered : *shared) {
+                        rows += scattered[p].size();
+                    }
+                    HashTable<K> partition(rows);
+                    // Consume the ranges in order to keep the order of the rows
+                    // of the same key
+                    for (auto& scattered : *shared) {
+                        for (auto& keyed : scattered[p]) {
+                            auto ret = partition.tryEmplace(std::move(keyed.key), keyed.hash);
+                            ret.first->emplace_back(keyed.row);
+                        }
+                    }
+                    return partition;
+                }));
+            }
+            return folly::collect(futures).via(runner());
+        })
+        .thenValue([this](std::vector<HashTable<K>>&& partitions) {
+            otherStats_.emplace("partitions", folly::to<std::string>(partitions.size()));
+            auto hashTable = std::make_shared<PartitionedHashTable<K>>();
+            hashTable->partitions = std::move(partitions);
+            return hashTable;
+        });
+}
 
-        auto& vals = hashTable[val];
-        vals.emplace_back(iter->row());
+template <typename K>
+folly::Future<DataSet> JoinExecutor::probe(
+    const std::vector<Expression*>& keys,
+    std::shared_ptr<Iterator> iter,
+    std::shared_ptr<const PartitionedHashTable<K>> hashTable,
+    JoinRows join) {
+    auto size = iter->size();
+    auto probeRange = [this, hashTable, join](const std::vector<Expression*>& probeKeys,
+                                              Iterator* probeIter,
+                                              size_t count) {
+        DataSet ds;
+        ds.rows.reserve(count);
+        QueryExpressionContext ctx(ectx_);
+        K buffer;
+        for (size_t i = 0; i < count && probeIter->valid(); ++i, probeIter->next()) {
+            const auto& key = evalKey(probeKeys, ctx, probeIter, &buffer);
+            join(*probeIter->row(), hashTable->find(key, HashTable<K>::hash(key)), &ds);
+        }
+        return ds;
+    };
+    if (!splittable(iter.get())) {
+        return folly::makeFuture(probeRange(keys, iter.get(), size));
     }
+
+    auto scatter = [this, keys, iter, probeRange](size_t begin, size_t end) -> DataSet {
+        JobExprs jobKeys(qctx_, keys);
+        auto jobIter = iter->copy();
+        jobIter->reset(begin);
+        return probeRange(jobKeys.clones(), jobIter.get(), end - begin);
+    };
+    return runMultiJobs<DataSet>(size, std::move(scatter))
+        .thenValue([this](std::vector<DataSet>&& parts) {
+            otherStats_.emplace("jobs", folly::to<std::string>(parts.size()));
+            size_t rows = 0;
+            for (auto& part : parts) {
+                rows += part.rows.size();
+            }
+            DataSet ds;
+            ds.rows.reserve(rows);
+            for (auto& part : parts) {
+                ds.rows.insert(ds.rows.end(),
+                               std::make_move_iterator(part.rows.begin()),
+                               std::make_move_iterator(part.rows.end()));
+            }
+            return ds;
+        });
 }
 
+template folly::Future<std::shared_ptr<JoinExecutor::PartitionedHashTable<Value>>>
+JoinExecutor::buildHashTable<Value>(const std::vector<Expression*>&, std::shared_ptr<Iterator>);
+template folly::Future<std::shared_ptr<JoinExecutor::PartitionedHashTable<List>>>
+JoinExecutor::buildHashTable<List>(const std::vector<Expression*>&, std::shared_ptr<Iterator>);
+template folly::Future<DataSet> JoinExecutor::probe<Value>(
+    const std::vector<Expression*>&,
+    std::shared_ptr<Iterator>,
+    std::shared_ptr<const PartitionedHashTable<Value>>,
+    JoinRows);
+template folly::Future<DataSet> JoinExecutor::probe<List>(
+    const std::vector<Expression*>&,
+    std::shared_ptr<Iterator>,
+    std::shared_ptr<const PartitionedHashTable<List>>,
+    JoinRows);
+
 }  // namespace graph
 }  // namespace nebula
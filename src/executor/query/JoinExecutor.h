@@ -8,6 +8,7 @@
 #define EXECUTOR_QUERY_JOINEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/FlatHashMap.h"
 
 namespace nebula {
 namespace graph {
@@ -19,20 +20,48 @@ public:
 
     Status checkInputDataSets();
 
-    void buildHashTable(const std::vector<Expression*>& hashKeys, Iterator* iter);
-
 protected:
-    void buildHashTable(const std::vector<Expression*>& hashKeys,
-                        Iterator* iter,
-                        std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
+    template <typename K>
+    using HashTable = FlatHashMap<K, std::vector<const Row*>>;
+
+    // The hash table is partitioned by the hashes of the keys, so that the
+    // partitions are built in parallel without any lock.
+    template <typename K>
+    struct PartitionedHashTable {
+        std::vector<HashTable<K>>       partitions;
+
+        static size_t partitionOf(size_t h, size_t numPartitions) {
+            // The slots of the partitions are decided by the low bits
+            return (folly::hash::twang_mix64(h) >> 32) % numPartitions;
+        }
+
+        // Return nullptr if `key' whose hash is `h' does not exist
+        const std::vector<const Row*>* find(const K& key, size_t h) const {
+            return partitions[partitionOf(h, partitions.size())].find(key, h);
+        }
+    };
+
+    // Join the probe row with the build rows of the same key, which is nullptr
+    // if there is none.
+    using JoinRows = std::function<void(const Row&, const std::vector<const Row*>*, DataSet*)>;
+
+    // Build the hash table of the rows of `iter' on `keys'. The key is a Value
+    // for the single key and a List otherwise.
+    template <typename K>
+    folly::Future<std::shared_ptr<PartitionedHashTable<K>>> buildHashTable(
+        const std::vector<Expression*>& keys,
+        std::shared_ptr<Iterator> iter);
 
-    void buildSingleKeyHashTable(
-        Expression* hashKey,
-        Iterator* iter,
-        std::unordered_map<Value, std::vector<const Row*>>& hashTable) const;
+    // Probe the hash table with the rows of `iter', the results are in the order
+    // of the probe rows.
+    template <typename K>
+    folly::Future<DataSet> probe(const std::vector<Expression*>& keys,
+                                 std::shared_ptr<Iterator> iter,
+                                 std::shared_ptr<const PartitionedHashTable<K>> hashTable,
+                                 JoinRows join);
 
-    std::unique_ptr<Iterator>                          lhsIter_;
-    std::unique_ptr<Iterator>                          rhsIter_;
+    std::shared_ptr<Iterator>                          lhsIter_;
+    std::shared_ptr<Iterator>                          rhsIter_;
     size_t                                             colSize_{0};
 };
 }  // namespace graph
@@ -25,98 +25,138 @@ Status LeftJoinExecutor::close() {
 
 folly::Future<Status> LeftJoinExecutor::join() {
     auto* join = asNode<Join>(node());
-    auto& rhsResult = ectx_->getVersionedResult(join->rightVar().first, join->rightVar().second);
-    rightColSize_ = rhsResult.valuePtr()->getDataSet().colNames.size();
-
     auto& hashKeys = join->hashKeys();
     auto& probeKeys = join->probeKeys();
     DCHECK_EQ(hashKeys.size(), probeKeys.size());
-    DataSet result;
 
-    if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-        std::unordered_map<Value, std::vector<const Row*>> hashTable;
-        hashTable.reserve(rhsIter_->size() == 0 ? 1 : rhsIter_->size());
-        if (!lhsIter_->empty()) {
-            buildSingleKeyHashTable(join->probeKeys().front(), rhsIter_.get(), hashTable);
-            result = singleKeyProbe(join->hashKeys().front(), lhsIter_.get(), hashTable);
-        }
-    } else {
-        std::unordered_map<List, std::vector<const Row*>> hashTable;
-        hashTable.reserve(rhsIter_->size() == 0 ? 1 : rhsIter_->size());
-        if (!lhsIter_->empty()) {
-            buildHashTable(join->probeKeys(), rhsIter_.get(), hashTable);
-            result = probe(join->hashKeys(), lhsIter_.get(), hashTable);
-        }
+    if (lhsIter_->empty()) {
+        DataSet result;
+        result.colNames = join->colNames();
+        return finish(ResultBuilder().value(Value(std::move(result))).finish());
     }
 
-    result.colNames = join->colNames();
-    VLOG(2) << node_->toString() << ", result: " << result;
-    return finish(ResultBuilder().value(Value(std::move(result))).finish());
+    // Build the hash table on the smaller side
+    if (lhsIter_->size() < rhsIter_->size()) {
+        if (hashKeys.size() == 1) {
+            return buildOnLeft<Value>(hashKeys, probeKeys);
+        }
+        return buildOnLeft<List>(hashKeys, probeKeys);
+    }
+    if (hashKeys.size() == 1) {
+        return buildOnRight<Value>(probeKeys, hashKeys);
+    }
+    return buildOnRight<List>(probeKeys, hashKeys);
 }
 
-DataSet LeftJoinExecutor::probe(
-    const std::vector<Expression*>& probeKeys,
-    Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
-    DataSet ds;
-    ds.rows.reserve(probeIter->size());
-    QueryExpressionContext ctx(ectx_);
-    for (; probeIter->valid(); probeIter->next()) {
-        List list;
-        list.values.reserve(probeKeys.size());
-        for (auto& col : probeKeys) {
-            Value val = col->eval(ctx(probeIter));
-            list.values.emplace_back(std::move(val));
+template <typename K>
+folly::Future<Status> LeftJoinExecutor::buildOnRight(const std::vector<Expression*>& buildKeys,
+                                                     const std::vector<Expression*>& probeKeys) {
+    auto colSize = colSize_;
+    auto joinRows = [colSize](const Row& lRow,
+                              const std::vector<const Row*>* rRows,
+                              DataSet* ds) {
+        if (rRows == nullptr) {
+            Row newRow;
+            auto& values = newRow.values;
+            values.reserve(colSize);
+            values.insert(values.end(), lRow.values.begin(), lRow.values.end());
+            values.insert(values.end(), colSize - lRow.size(), Value::kEmpty);
+            ds->rows.emplace_back(std::move(newRow));
+            return;
         }
-
-        buildNewRow<List>(hashTable, list, *probeIter->row(), ds);
-    }
-    return ds;
+        for (auto* rRow : *rRows) {
+            Row newRow;
+            auto& values = newRow.values;
+            values.reserve(lRow.size() + rRow->size());
+            values.insert(values.end(), lRow.values.begin(), lRow.values.end());
+            values.insert(values.end(), rRow->values.begin(), rRow->values.end());
+            ds->rows.emplace_back(std::move(newRow));
+        }
+    };
+    return buildHashTable<K>(buildKeys, rhsIter_)
+        .thenValue([this, probeKeys, joinRows](std::shared_ptr<PartitionedHashTable<K>> hashTable) {
+            return probe<K>(probeKeys, lhsIter_, std::move(hashTable), joinRows);
+        })
+        .thenValue([this](DataSet result) {
+            SCOPED_TIMER(&execTime_);
+            otherStats_.emplace("build side", "rhs");
+            result.colNames = asNode<Join>(node())->colNames();
+            VLOG(2) << node_->toString() << ", result: " << result;
+            return finish(ResultBuilder().value(Value(std::move(result))).finish());
+        });
 }
 
-DataSet LeftJoinExecutor::singleKeyProbe(
-    Expression* probeKey,
-    Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
-    DataSet ds;
-    ds.rows.reserve(probeIter->size());
-    QueryExpressionContext ctx(ectx_);
-    for (; probeIter->valid(); probeIter->next()) {
-        auto& val = probeKey->eval(ctx(probeIter));
-        buildNewRow<Value>(hashTable, val, *probeIter->row(), ds);
+template <typename K>
+folly::Future<Status> LeftJoinExecutor::buildOnLeft(const std::vector<Expression*>& buildKeys,
+                                                    const std::vector<Expression*>& probeKeys) {
+    // Number the rows of the lhs to put the results back in the order of the lhs
+    auto lhsRows = std::make_shared<std::vector<const Row*>>();
+    auto positions = std::make_shared<std::unordered_map<const Row*, int64_t>>();
+    lhsRows->reserve(lhsIter_->size());
+    positions->reserve(lhsIter_->size());
+    for (auto iter = lhsIter_->copy(); iter->valid(); iter->next()) {
+        positions->emplace(iter->row(), lhsRows->size());
+        lhsRows->emplace_back(iter->row());
     }
-    return ds;
-}
 
-template <class T>
-void LeftJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                                   const T& val,
-                                   const Row& lRow,
-                                   DataSet& ds) const {
-    auto range = hashTable.find(val);
-    if (range == hashTable.end()) {
-        auto lRowSize = lRow.size();
-        Row newRow;
-        newRow.reserve(colSize_);
-        auto& values = newRow.values;
-        values.insert(values.end(),
-                std::make_move_iterator(lRow.values.begin()),
-                std::make_move_iterator(lRow.values.end()));
-        values.insert(values.end(), colSize_ - lRowSize, Value::kEmpty);
-        ds.rows.emplace_back(std::move(newRow));
-    } else {
-        for (auto* row : range->second) {
-            auto& rRow = *row;
+    auto joinRows = [positions](const Row& rRow,
+                                const std::vector<const Row*>* lRows,
+                                DataSet* ds) {
+        if (lRows == nullptr) {
+            return;
+        }
+        for (auto* lRow : *lRows) {
             Row newRow;
             auto& values = newRow.values;
-            values.reserve(lRow.size() + rRow.size());
-            values.insert(values.end(),
-                    std::make_move_iterator(lRow.values.begin()),
-                    std::make_move_iterator(lRow.values.end()));
+            values.reserve(lRow->size() + rRow.size() + 1);
+            values.insert(values.end(), lRow->values.begin(), lRow->values.end());
             values.insert(values.end(), rRow.values.begin(), rRow.values.end());
-            ds.rows.emplace_back(std::move(newRow));
+            // The position of the lhs row, removed once reordered
+            values.emplace_back(positions->at(lRow));
+            ds->rows.emplace_back(std::move(newRow));
         }
-    }
+    };
+    auto colSize = colSize_;
+    return buildHashTable<K>(buildKeys, lhsIter_)
+        .thenValue([this, probeKeys, joinRows](std::shared_ptr<PartitionedHashTable<K>> hashTable) {
+            return probe<K>(probeKeys, rhsIter_, std::move(hashTable), joinRows);
+        })
+        .thenValue([this, lhsRows, colSize](DataSet matched) {
+            SCOPED_TIMER(&execTime_);
+            // Each row of the lhs takes the slots of its matched rows, or one slot
+            // for itself padded with the empty values
+            std::vector<size_t> offsets(lhsRows->size() + 1, 0);
+            for (auto& row : matched.rows) {
+                ++offsets[row.values.back().getInt() + 1];
+            }
+            for (size_t i = 0; i < lhsRows->size(); ++i) {
+                offsets[i + 1] = offsets[i] + std::max<size_t>(offsets[i + 1], 1);
+            }
+
+            DataSet result;
+            result.rows.resize(offsets.back());
+            auto cursors = offsets;
+            for (auto& row : matched.rows) {
+                auto pos = row.values.back().getInt();
+                row.values.pop_back();
+                result.rows[cursors[pos]++] = std::move(row);
+            }
+            for (size_t i = 0; i < lhsRows->size(); ++i) {
+                if (cursors[i] != offsets[i]) {
+                    continue;
+                }
+                auto& lRow = *(*lhsRows)[i];
+                auto& values = result.rows[offsets[i]].values;
+                values.reserve(colSize);
+                values.insert(values.end(), lRow.values.begin(), lRow.values.end());
+                values.insert(values.end(), colSize - lRow.size(), Value::kEmpty);
+            }
+
+            otherStats_.emplace("build side", "lhs");
+            result.colNames = asNode<Join>(node())->colNames();
+            VLOG(2) << node_->toString() << ", result: " << result;
+            return finish(ResultBuilder().value(Value(std::move(result))).finish());
+        });
 }
 
 }   // namespace graph
@@ -24,23 +24,16 @@ public:
 private:
     folly::Future<Status> join();
 
-    DataSet probe(const std::vector<Expression*>& probeKeys,
-                  Iterator* probeIter,
-                  const std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
-
-    DataSet singleKeyProbe(
-        Expression* probeKey,
-        Iterator* probeIter,
-        const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const;
-
-    template <class T>
-    void buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                     const T& val,
-                     const Row& lRow,
-                     DataSet& ds) const;
-
-private:
-    size_t rightColSize_{0};
+    // Build the hash table on the rhs, and probe it with the lhs
+    template <typename K>
+    folly::Future<Status> buildOnRight(const std::vector<Expression*>& buildKeys,
+                                       const std::vector<Expression*>& probeKeys);
+
+    // Build the hash table on the smaller lhs, and probe it with the rhs. The
+    // results are put back in the order of the lhs.
+    template <typename K>
+    folly::Future<Status> buildOnLeft(const std::vector<Expression*>& buildKeys,
+                                      const std::vector<Expression*>& probeKeys);
 };
 }  // namespace graph
 }  // namespace nebula
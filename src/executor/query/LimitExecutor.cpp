@@ -22,7 +22,14 @@ folly::Future<Status> LimitExecutor::execute() {
     auto offset = limit->offset();
     auto count = limit->count();
     auto size = iter->size();
-    if (size <= static_cast<size_t>(offset)) {
+    if (iter->isSequentialIter() || iter->isPropIter()) {
+        // Select the range instead of erasing the input rows shared with the others
+        auto first = std::min(size, static_cast<size_t>(offset));
+        auto last = std::min(size, static_cast<size_t>(offset + count));
+        std::vector<size_t> positions(last - first);
+        std::iota(positions.begin(), positions.end(), first);
+        static_cast<SequentialIter*>(iter)->select(std::move(positions));
+    } else if (size <= static_cast<size_t>(offset)) {
         iter->clear();
     } else if (size > static_cast<size_t>(offset + count)) {
         iter->eraseRange(0, offset);
@@ -30,14 +30,8 @@ folly::Future<Status> MinusExecutor::execute() {
 
     auto* lIter = left.iterRef();
     if (!hashSet.empty()) {
-        while (lIter->valid()) {
-            auto iter = hashSet.find(lIter->row());
-            if (iter == hashSet.end()) {
-                lIter->next();
-            } else {
-                lIter->unstableErase();
-            }
-        }
+        keepRows(lIter,
+                 [&hashSet](const Row *row) { return hashSet.find(row) == hashSet.end(); });
     }
 
     ResultBuilder builder;
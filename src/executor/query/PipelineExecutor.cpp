@@ -0,0 +1,230 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "executor/query/PipelineExecutor.h"
+
+#include <folly/String.h>
+
+#include "context/QueryExpressionContext.h"
+#include "executor/query/FilterExecutor.h"
+#include "parser/Clauses.h"
+#include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
+#include "util/ScopedTimer.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+bool isStreaming(const PlanNode *node) {
+    switch (node->kind()) {
+        case PlanNode::Kind::kFilter:
+        case PlanNode::Kind::kProject:
+        case PlanNode::Kind::kLimit:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isKind(const PlanNode *node, PlanNode::Kind kind) {
+    return node->kind() == kind;
+}
+
+}   // namespace
+
+// static
+std::vector<const PlanNode *> PipelineExecutor::fusibleChain(const PlanNode *tail) {
+    std::vector<const PlanNode *> chain;
+    if (!isStreaming(tail)) {
+        return chain;
+    }
+    chain.emplace_back(tail);
+    for (auto *node = tail; node->numDeps() == 1;) {
+        auto *dep = node->dep();
+        // The output of `dep' is not materialized, so nobody else could read it
+        if (dep == nullptr || !isStreaming(dep) || dep->outputVar() != node->inputVar() ||
+            dep->outputVarPtr()->userCount.load(std::memory_order_relaxed) != 1) {
+            break;
+        }
+        chain.emplace_back(dep);
+        node = dep;
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    auto project = std::find_if(chain.begin(), chain.end(), [](auto *node) {
+        return isKind(node, PlanNode::Kind::kProject);
+    });
+    if (project == chain.end()) {
+        return {};
+    }
+    // Only the filters could work on the input iterator before the first Project
+    auto limit = std::find_if(std::make_reverse_iterator(project), chain.rend(), [](auto *node) {
+        return isKind(node, PlanNode::Kind::kLimit);
+    });
+    chain.erase(chain.begin(), limit.base());
+    if (chain.size() < 2) {
+        return {};
+    }
+    return chain;
+}
+
+folly::Future<Status> PipelineExecutor::execute() {
+    SCOPED_TIMER(&execTime_);
+    auto *head = chain_.front();
+    auto iter = ectx_->getResult(head->inputVar()).iter();
+    DCHECK(!!iter);
+    QueryExpressionContext ctx(ectx_);
+
+    limits_.clear();
+    std::vector<std::string> fused;
+    for (auto *node : chain_) {
+        if (isKind(node, PlanNode::Kind::kLimit)) {
+            auto *limit = asNode<Limit>(node);
+            limits_.emplace_back(limit->offset(), limit->count());
+        } else {
+            limits_.emplace_back(0, 0);
+        }
+        fused.emplace_back(node->outputVar());
+    }
+
+    size_t first = 0;
+    while (!isKind(chain_[first], PlanNode::Kind::kProject)) {
+        ++first;
+    }
+    auto *project = asNode<Project>(chain_[first]);
+    auto columns = project->columns()->columns();
+    size_t batchSize = std::max<uint32_t>(FLAGS_pipeline_batch_size, 1);
+
+    DataSet output;
+    output.colNames = node()->colNames();
+    DataSet batch;
+    batch.colNames = project->colNames();
+    batch.rows.reserve(batchSize);
+    bool done = false;
+    for (; iter->valid() && !done; iter->next()) {
+        bool passed = true;
+        for (size_t i = 0; i < first && passed; ++i) {
+            auto *filter = asNode<Filter>(chain_[i]);
+            auto result = FilterExecutor::isPassed(filter->condition()->eval(ctx(iter.get())));
+            NG_RETURN_IF_ERROR(result);
+            passed = std::move(result).value();
+        }
+        if (!passed) {
+            continue;
+        }
+
+        Row row;
+        row.values.reserve(columns.size());
+        for (auto *col : columns) {
+            row.values.emplace_back(col->expr()->eval(ctx(iter.get())));
+        }
+        batch.rows.emplace_back(std::move(row));
+        if (batch.rows.size() >= batchSize) {
+            NG_RETURN_IF_ERROR(pushBatch(std::move(batch), first + 1, &output, &done));
+            batch = DataSet();
+            batch.colNames = project->colNames();
+            batch.rows.reserve(batchSize);
+        }
+    }
+    if (!done && !batch.rows.empty()) {
+        NG_RETURN_IF_ERROR(pushBatch(std::move(batch), first + 1, &output, &done));
+    }
+
+    otherStats_.emplace("fused", folly::join(",", fused));
+    return finish(ResultBuilder().value(Value(std::move(output))).finish());
+}
+
+Status PipelineExecutor::pushBatch(DataSet &&batch, size_t stage, DataSet *output, bool *done) {
+    QueryExpressionContext ctx(ectx_);
+    for (size_t i = stage; i < chain_.size() && !batch.rows.empty(); ++i) {
+        auto *node = chain_[i];
+        switch (node->kind()) {
+            case PlanNode::Kind::kFilter: {
+                auto *condition = asNode<Filter>(node)->condition();
+                auto value = std::make_shared<Value>(std::move(batch));
+                SequentialIter iter(value);
+                std::vector<bool> passed;
+                passed.reserve(iter.size());
+                for (; iter.valid(); iter.next()) {
+                    auto result = FilterExecutor::isPassed(condition->eval(ctx(&iter)));
+                    NG_RETURN_IF_ERROR(result);
+                    passed.emplace_back(std::move(result).value());
+                }
+                batch = value->moveDataSet();
+                // Keep the origin order of rows as the stable filter
+                size_t numPassed = 0;
+                for (size_t j = 0; j < batch.rows.size(); ++j) {
+                    if (passed[j]) {
+                        if (numPassed != j) {
+                            batch.rows[numPassed] = std::move(batch.rows[j]);
+                        }
+                        ++numPassed;
+                    }
+                }
+                batch.rows.resize(numPassed);
+                break;
+            }
+            case PlanNode::Kind::kProject: {
+                auto *project = asNode<Project>(node);
+                auto value = std::make_shared<Value>(std::move(batch));
+                SequentialIter iter(value);
+                DataSet ds;
+                ds.colNames = project->colNames();
+                ds.rows.reserve(iter.size());
+                for (; iter.valid(); iter.next()) {
+                    Row row;
+                    for (auto *col : project->columns()->columns()) {
+                        row.values.emplace_back(col->expr()->eval(ctx(&iter)));
+                    }
+                    ds.rows.emplace_back(std::move(row));
+                }
+                batch = std::move(ds);
+                break;
+            }
+            case PlanNode::Kind::kLimit: {
+                auto &offset = limits_[i].first;
+                auto &count = limits_[i].second;
+                auto &rows = batch.rows;
+                auto skip = std::min<size_t>(std::max<int64_t>(offset, 0), rows.size());
+                rows.erase(rows.begin(), rows.begin() + skip);
+                offset -= skip;
+                auto take = std::min<size_t>(std::max<int64_t>(count, 0), rows.size());
+                rows.resize(take);
+                count -= take;
+                if (count <= 0) {
+                    // No more rows could pass this Limit
+                    *done = true;
+                }
+                break;
+            }
+            default:
+                LOG(FATAL) << "Unexpected plan node in pipeline: " << node->kind();
+        }
+    }
+
+    for (auto &row : batch.rows) {
+        output->rows.emplace_back(std::move(row));
+    }
+    return Status::OK();
+}
+
+void PipelineExecutor::drop() {
+    // The input of the chain is the input of the head
+    for (const auto &inputVar : chain_.front()->inputVars()) {
+        if (inputVar != nullptr) {
+            if (inputVar->userCount.fetch_sub(1, std::memory_order_release) == 1) {
+                CHECK_EQ(inputVar->userCount.load(std::memory_order_acquire), 0);
+                ectx_->dropResult(inputVar->name);
+                VLOG(1) << "Drop variable " << inputVar->name;
+            }
+        }
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXECUTOR_QUERY_PIPELINEEXECUTOR_H_
+#define EXECUTOR_QUERY_PIPELINEEXECUTOR_H_
+
+#include "executor/Executor.h"
+
+namespace nebula {
+namespace graph {
+
+// Run a chain of the streaming operators, i.e. Filter, Project and Limit, as one
+// executor, which pushes bounded batches of rows through the operators instead of
+// materializing the variables between them. The chain stops pulling its input once
+// any Limit of it is satisfied.
+//
+// The chain is `Filter* Project (Filter | Project | Limit)*', so the leading filters
+// are evaluated on the input iterator of any kind, and the following operators work
+// on the batches of rows built by the first Project.
+class PipelineExecutor final : public Executor {
+public:
+    // `chain' is ordered from the head to the tail, which is `node'
+    PipelineExecutor(const PlanNode *node, QueryContext *qctx, std::vector<const PlanNode *> chain)
+        : Executor("PipelineExecutor", node, qctx), chain_(std::move(chain)) {}
+
+    folly::Future<Status> execute() override;
+
+    // Return the chain to fuse which ends with `tail', or empty if there is none.
+    // The variables inside the chain must be used only by the next operator.
+    static std::vector<const PlanNode *> fusibleChain(const PlanNode *tail);
+
+    const std::vector<const PlanNode *> &chain() const {
+        return chain_;
+    }
+
+private:
+    // Push `batch' through the operators of the chain starting from `stage', and
+    // append the survived rows to `output'. `done' is set when a Limit is satisfied.
+    Status pushBatch(DataSet &&batch, size_t stage, DataSet *output, bool *done);
+
+    void drop() override;
+
+    std::vector<const PlanNode *>                   chain_;
+    // The offset and count left of each Limit in the chain
+    std::vector<std::pair<int64_t, int64_t>>        limits_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // EXECUTOR_QUERY_PIPELINEEXECUTOR_H_
@@ -6,9 +6,11 @@
 
 #include "executor/query/ProjectExecutor.h"
 
+#include "context/BatchExpression.h"
 #include "context/QueryExpressionContext.h"
 #include "parser/Clauses.h"
 #include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
@@ -17,26 +19,138 @@ namespace graph {
 folly::Future<Status> ProjectExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* project = asNode<Project>(node());
-    auto columns = project->columns()->columns();
     auto iter = ectx_->getResult(project->inputVar()).iter();
     DCHECK(!!iter);
-    QueryExpressionContext ctx(ectx_);
 
     VLOG(1) << "input: " << project->inputVar();
+    if (splittable(iter.get())) {
+        return projectInParallel(std::move(iter));
+    }
+
+    std::vector<Expression*> columns;
+    for (auto* col : project->columns()->columns()) {
+        columns.emplace_back(col->expr());
+    }
     DataSet ds;
     ds.colNames = project->colNames();
     ds.rows.reserve(iter->size());
-    for (; iter->valid(); iter->next()) {
-        Row row;
-        for (auto& col : columns) {
-            Value val = col->expr()->eval(ctx(iter.get()));
-            row.values.emplace_back(std::move(val));
-        }
-        ds.rows.emplace_back(std::move(row));
+    auto batchExprs = compileBatchExprs(iter.get());
+    if (!batchExprs.empty()) {
+        batchProject(
+            batchExprs, columns, static_cast<SequentialIter*>(iter.get()), 0, iter->size(), &ds);
+    } else {
+        projectRows(columns, iter.get(), iter->size(), &ds);
     }
     VLOG(1) << node()->outputVar() << ":" << ds;
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
+folly::Future<Status> ProjectExecutor::projectInParallel(std::shared_ptr<Iterator> iter) {
+    auto* project = asNode<Project>(node());
+    // The batch expressions keep no evaluation state, so they are shared by the morsels
+    auto batchExprs = std::make_shared<std::vector<std::unique_ptr<BatchExpression>>>(
+        compileBatchExprs(iter.get()));
+    std::vector<Expression*> exprs;
+    for (auto* col : project->columns()->columns()) {
+        exprs.emplace_back(col->expr());
+    }
+    auto kernel = [this, exprs, batchExprs](Iterator* morsel, size_t begin, size_t end) {
+        JobExprs jobExprs(qctx_, exprs);
+        const auto& columns = jobExprs.clones();
+        DataSet ds;
+        ds.rows.reserve(end - begin);
+        if (!batchExprs->empty()) {
+            auto* seqIter = static_cast<SequentialIter*>(morsel);
+            batchProject(*batchExprs, columns, seqIter, begin, end, &ds);
+        } else {
+            projectRows(columns, morsel, end - begin, &ds);
+        }
+        return ds;
+    };
+    return runMorsels<DataSet>(std::move(iter), std::move(kernel))
+        .thenValue([this, project](std::vector<DataSet>&& morsels) {
+            SCOPED_TIMER(&execTime_);
+            otherStats_.emplace("jobs", folly::to<std::string>(morsels.size()));
+            auto ds = concatMorsels(std::move(morsels), project->colNames());
+            return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+        });
+}
+
+void ProjectExecutor::projectRows(const std::vector<Expression*>& columns,
+                                  Iterator* iter,
+                                  size_t numRows,
+                                  DataSet* ds) {
+    QueryExpressionContext ctx(ectx_);
+    for (size_t n = 0; n < numRows && iter->valid(); ++n, iter->next()) {
+        Row row;
+        row.values.reserve(columns.size());
+        for (auto* col : columns) {
+            row.values.emplace_back(col->eval(ctx(iter)));
+        }
+        ds->rows.emplace_back(std::move(row));
+    }
+}
+
+std::vector<std::unique_ptr<BatchExpression>> ProjectExecutor::compileBatchExprs(Iterator* iter) {
+    std::vector<std::unique_ptr<BatchExpression>> batchExprs;
+    if (!FLAGS_enable_batch_eval || !(iter->isSequentialIter() || iter->isPropIter())) {
+        return batchExprs;
+    }
+    auto* project = asNode<Project>(node());
+    auto& colIndices = static_cast<SequentialIter*>(iter)->getColIndices();
+    bool anyCompiled = false;
+    for (auto* col : project->columns()->columns()) {
+        auto kind = col->expr()->kind();
+        // Just copy the input column, nothing to gain from the batch kernels
+        if (kind == Expression::Kind::kInputProperty || kind == Expression::Kind::kVarProperty) {
+            batchExprs.emplace_back(nullptr);
+            continue;
+        }
+        auto batchExpr = BatchExpression::compile(col->expr(), colIndices);
+        anyCompiled = anyCompiled || batchExpr != nullptr;
+        batchExprs.emplace_back(std::move(batchExpr));
+    }
+    if (!anyCompiled) {
+        batchExprs.clear();
+    }
+    return batchExprs;
+}
+
+void ProjectExecutor::batchProject(const std::vector<std::unique_ptr<BatchExpression>>& exprs,
+                                   const std::vector<Expression*>& columns,
+                                   SequentialIter* iter,
+                                   size_t begin,
+                                   size_t end,
+                                   DataSet* ds) {
+    DCHECK_EQ(columns.size(), exprs.size());
+    QueryExpressionContext ctx(ectx_);
+    std::vector<BatchVector> vecs(exprs.size());
+    for (size_t first = begin; first < end; first += ColumnBatch::kDefaultSize) {
+        auto last = std::min(first + ColumnBatch::kDefaultSize, end);
+        for (size_t c = 0; c < exprs.size(); ++c) {
+            if (exprs[c] != nullptr) {
+                auto batch = iter->columnBatch(first, last, exprs[c]->colIndices());
+                vecs[c] = BatchVector();
+                exprs[c]->eval(batch, &vecs[c]);
+            }
+        }
+        // The iterator walks along with the rows of the block
+        for (size_t i = 0; i < last - first; ++i, iter->next()) {
+            Row row;
+            row.values.reserve(columns.size());
+            for (size_t c = 0; c < columns.size(); ++c) {
+                auto& vec = vecs[c];
+                if (exprs[c] != nullptr && vec.kind != Column::Kind::kNull &&
+                    !vec.isFallback(i)) {
+                    row.values.emplace_back(vec.value(i));
+                } else {
+                    row.values.emplace_back(columns[c]->eval(ctx(iter)));
+                }
+            }
+            ds->rows.emplace_back(std::move(row));
+        }
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -7,17 +7,42 @@
 #ifndef EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 #define EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 
+#include "common/expression/Expression.h"
 #include "executor/Executor.h"
 
 namespace nebula {
 namespace graph {
 
+class BatchExpression;
+
 class ProjectExecutor final : public Executor {
 public:
     ProjectExecutor(const PlanNode *node, QueryContext *qctx)
         : Executor("ProjectExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+private:
+    // Return empty if none of the columns could be evaluated by batch,
+    // the column which could not be compiled is nullptr.
+    std::vector<std::unique_ptr<BatchExpression>> compileBatchExprs(Iterator *iter);
+
+    // Project the morsels of the rows concurrently
+    folly::Future<Status> projectInParallel(std::shared_ptr<Iterator> iter);
+
+    // Project at most `numRows' rows from the current one of `iter'
+    void projectRows(const std::vector<Expression *> &columns,
+                     Iterator *iter,
+                     size_t numRows,
+                     DataSet *ds);
+
+    // Project the rows [begin, end), `iter' should be positioned at `begin'
+    void batchProject(const std::vector<std::unique_ptr<BatchExpression>> &exprs,
+                      const std::vector<Expression *> &columns,
+                      SequentialIter *iter,
+                      size_t begin,
+                      size_t end,
+                      DataSet *ds);
 };
 
 }   // namespace graph
@@ -77,5 +77,27 @@ Result SetExecutor::getRightInputData() const {
     return ectx_->getResult(right);
 }
 
+// static
+void SetExecutor::keepRows(Iterator *iter, const std::function<bool(const Row *)> &pred) {
+    if (iter->isSequentialIter() || iter->isPropIter()) {
+        std::vector<size_t> positions;
+        size_t pos = 0;
+        for (; iter->valid(); iter->next(), ++pos) {
+            if (pred(iter->row())) {
+                positions.emplace_back(pos);
+            }
+        }
+        static_cast<SequentialIter *>(iter)->select(std::move(positions));
+        return;
+    }
+    while (iter->valid()) {
+        if (pred(iter->row())) {
+            iter->next();
+        } else {
+            iter->unstableErase();
+        }
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -29,6 +29,10 @@ protected:
     SetExecutor(const std::string &name, const PlanNode *node, QueryContext *qctx)
         : Executor(name, node, qctx) {}
 
+    // Keep the rows of `iter' which `pred' holds on. The sequential iterator only
+    // selects them, so the input rows shared with the other executors are untouched.
+    static void keepRows(Iterator *iter, const std::function<bool(const Row *)> &pred);
+
     std::vector<std::string> colNames_;
 };
 
@@ -5,8 +5,12 @@
  */
 
 #include "executor/query/SortExecutor.h"
+
+#include <numeric>
+
 #include "planner/plan/Query.h"
 #include "util/ScopedTimer.h"
+#include "util/SortKey.h"
 
 namespace nebula {
 namespace graph {
@@ -27,27 +31,66 @@ folly::Future<Status> SortExecutor::execute() {
         return Status::Error(ss.str());
     }
 
-    auto &factors = sort->factors();
-    auto comparator = [&factors] (const Row &lhs, const Row &rhs) {
-        for (auto &item : factors) {
-            auto index = item.first;
-            auto orderType = item.second;
-            if (lhs[index] == rhs[index]) {
-                continue;
-            }
-
-            if (orderType == OrderFactor::OrderType::ASCEND) {
-                return lhs[index] < rhs[index];
-            } else if (orderType == OrderFactor::OrderType::DESCEND) {
-                return lhs[index] > rhs[index];
-            }
-        }
-        return false;
+    // Sort the indices of rows by the encoded keys, then select the rows in the order.
+    // The input rows may be shared with the others, so they are never moved.
+    auto seqIter = static_cast<SequentialIter*>(iter);
+    auto size = seqIter->size();
+    auto comparator = std::make_shared<RowIndexComparator>(
+        seqIter->rows(), seqIter->selection(), sort->factors());
+    auto indices = std::make_shared<std::vector<size_t>>(size);
+    auto sortRange = [comparator, indices](size_t begin, size_t end) -> Range {
+        comparator->prepare(begin, end);
+        auto first = indices->begin() + begin;
+        auto last = indices->begin() + end;
+        std::iota(first, last, begin);
+        auto &cmp = *comparator;
+        std::sort(first, last, [&cmp](size_t lhs, size_t rhs) { return cmp(lhs, rhs); });
+        return std::make_pair(begin, end);
     };
 
-    auto seqIter = static_cast<SequentialIter*>(iter);
-    std::sort(seqIter->begin(), seqIter->end(), comparator);
-    return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).finish());
+    if (numJobs(size) <= 1) {
+        sortRange(0, size);
+        seqIter->select(std::move(*indices));
+        return finish(
+            ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).finish());
+    }
+
+    // Sort the disjoint ranges concurrently, then merge them
+    return runMultiJobs<Range>(size, std::move(sortRange))
+        .thenValue([this, comparator, indices, result = std::move(result)](
+                       std::vector<Range> &&ranges) mutable {
+            SCOPED_TIMER(&execTime_);
+            auto merged = mergeRanges(ranges, *indices, *comparator);
+            static_cast<SequentialIter *>(result.iterRef())->select(std::move(merged));
+            otherStats_.emplace("jobs", folly::to<std::string>(ranges.size()));
+            return finish(
+                ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).finish());
+        });
+}
+
+// static
+std::vector<size_t> SortExecutor::mergeRanges(const std::vector<Range> &ranges,
+                                              const std::vector<size_t> &indices,
+                                              const RowIndexComparator &comparator) {
+    // k-way merge with a heap on the heads of the ranges, the top is the least head
+    std::vector<Range> heads(ranges.begin(), ranges.end());
+    auto greater = [&indices, &comparator](const Range &lhs, const Range &rhs) {
+        return comparator(indices[rhs.first], indices[lhs.first]);
+    };
+    std::make_heap(heads.begin(), heads.end(), greater);
+    std::vector<size_t> merged;
+    merged.reserve(indices.size());
+    while (!heads.empty()) {
+        std::pop_heap(heads.begin(), heads.end(), greater);
+        auto &head = heads.back();
+        merged.emplace_back(indices[head.first]);
+        if (++head.first < head.second) {
+            std::push_heap(heads.begin(), heads.end(), greater);
+        } else {
+            heads.pop_back();
+        }
+    }
+    return merged;
 }
 
 }   // namespace graph
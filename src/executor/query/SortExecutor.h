@@ -12,12 +12,22 @@
 namespace nebula {
 namespace graph {
 
+class RowIndexComparator;
+
 class SortExecutor final : public Executor {
 public:
     SortExecutor(const PlanNode *node, QueryContext *qctx)
         : Executor("SortExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+private:
+    using Range = std::pair<size_t, size_t>;
+
+    // Merge the sorted ranges of `indices' which cover the whole vector
+    static std::vector<size_t> mergeRanges(const std::vector<Range> &ranges,
+                                           const std::vector<size_t> &indices,
+                                           const RowIndexComparator &comparator);
 };
 
 }   // namespace graph
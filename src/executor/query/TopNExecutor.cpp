@@ -5,6 +5,9 @@
  */
 
 #include "executor/query/TopNExecutor.h"
+
+#include <numeric>
+
 #include "planner/plan/Query.h"
 #include "util/ScopedTimer.h"
 
@@ -26,24 +29,6 @@ folly::Future<Status> TopNExecutor::execute() {
         return Status::Error(ss.str());
     }
 
-    auto &factors = topn->factors();
-    comparator_ = [&factors] (const Row &lhs, const Row &rhs) {
-        for (auto &item : factors) {
-            auto index = item.first;
-            auto orderType = item.second;
-            if (lhs[index] == rhs[index]) {
-                continue;
-            }
-
-            if (orderType == OrderFactor::OrderType::ASCEND) {
-                return lhs[index] < rhs[index];
-            } else if (orderType == OrderFactor::OrderType::DESCEND) {
-                return lhs[index] > rhs[index];
-            }
-        }
-        return false;
-    };
-
     offset_ = topn->offset();
     auto count = topn->count();
     auto size = iter->size();
@@ -63,32 +48,68 @@ folly::Future<Status> TopNExecutor::execute() {
             .value(result.valuePtr()).iter(std::move(result).iter()).finish());
     }
 
-    executeTopN<SequentialIter>(iter);
-    iter->eraseRange(maxCount_, size);
-    return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).finish());
+    // Select the top rows in the order, the input rows may be shared with the others
+    auto seqIter = static_cast<SequentialIter*>(iter);
+    comparator_ = std::make_unique<RowIndexComparator>(
+        seqIter->rows(), seqIter->selection(), topn->factors());
+    if (numJobs(size) <= 1) {
+        seqIter->select(collect(topN(0, size)));
+        return finish(
+            ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).finish());
+    }
+
+    // Select the candidates of the disjoint ranges concurrently, then select among them
+    auto scatter = [this](size_t begin, size_t end) {
+        return topN(begin, end);
+    };
+    return runMultiJobs<std::vector<size_t>>(size, std::move(scatter))
+        .thenValue([this, result = std::move(result)](
+                       std::vector<std::vector<size_t>> &&candidates) mutable {
+            SCOPED_TIMER(&execTime_);
+            std::vector<size_t> indices;
+            indices.reserve(candidates.size() * heapSize_);
+            for (auto &part : candidates) {
+                indices.insert(indices.end(), part.begin(), part.end());
+            }
+            auto cmp = [this](size_t lhs, size_t rhs) {
+                return (*comparator_)(lhs, rhs);
+            };
+            auto heapSize = std::min<size_t>(heapSize_, indices.size());
+            std::partial_sort(indices.begin(), indices.begin() + heapSize, indices.end(), cmp);
+            indices.resize(heapSize);
+            auto *seqIter = static_cast<SequentialIter *>(result.iterRef());
+            seqIter->select(collect(std::move(indices)));
+            otherStats_.emplace("jobs", folly::to<std::string>(candidates.size()));
+            return finish(
+                ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).finish());
+        });
 }
 
-template<typename U>
-void TopNExecutor::executeTopN(Iterator *iter) {
-    auto uIter = static_cast<U*>(iter);
-    std::vector<Row> heap(uIter->begin(), uIter->begin()+heapSize_);
-    std::make_heap(heap.begin(), heap.end(), comparator_);
-    auto it = uIter->begin() + heapSize_;
-    while (it != uIter->end()) {
-        if (comparator_(*it, heap[0])) {
-            std::pop_heap(heap.begin(), heap.end(), comparator_);
-            heap.pop_back();
-            heap.push_back(*it);
-            std::push_heap(heap.begin(), heap.end(), comparator_);
+std::vector<size_t> TopNExecutor::topN(size_t begin, size_t end) const {
+    comparator_->prepare(begin, end);
+    // Keep the indices rather than the copies of the rows in the heap
+    auto cmp = [this](size_t lhs, size_t rhs) {
+        return (*comparator_)(lhs, rhs);
+    };
+    auto heapSize = std::min<size_t>(heapSize_, end - begin);
+    std::vector<size_t> heap(heapSize);
+    std::iota(heap.begin(), heap.end(), begin);
+    std::make_heap(heap.begin(), heap.end(), cmp);
+    for (auto i = begin + heapSize; i < end; ++i) {
+        if (cmp(i, heap[0])) {
+            std::pop_heap(heap.begin(), heap.end(), cmp);
+            heap.back() = i;
+            std::push_heap(heap.begin(), heap.end(), cmp);
         }
-        ++it;
     }
-    std::sort_heap(heap.begin(), heap.end(), comparator_);
+    std::sort_heap(heap.begin(), heap.end(), cmp);
+    return heap;
+}
 
-    auto beg = uIter->begin();
-    for (int i = 0; i < maxCount_; ++i) {
-        beg[i] = heap[offset_+i];
-    }
+std::vector<size_t> TopNExecutor::collect(std::vector<size_t> &&indices) const {
+    indices.erase(indices.begin(), indices.begin() + offset_);
+    indices.resize(maxCount_);
+    return std::move(indices);
 }
 
 }   // namespace graph
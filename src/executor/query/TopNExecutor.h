@@ -8,6 +8,7 @@
 #define EXECUTOR_QUERY_TOPNEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/SortKey.h"
 
 namespace nebula {
 namespace graph {
@@ -20,13 +21,16 @@ public:
     folly::Future<Status> execute() override;
 
 private:
-    template<typename U>
-    void executeTopN(Iterator *iter);
+    // Select the indices of the first `heapSize_' rows of [begin, end) in order
+    std::vector<size_t> topN(size_t begin, size_t end) const;
+
+    // Skip the first `offset_' of the selected indices
+    std::vector<size_t> collect(std::vector<size_t> &&indices) const;
 
     int64_t offset_;
     int64_t maxCount_;
     int64_t heapSize_;
-    std::function<bool(const Row&, const Row&)> comparator_;
+    std::unique_ptr<RowIndexComparator> comparator_;
 };
 
 }   // namespace graph
@@ -24,16 +24,10 @@ folly::Future<Status> UnionExecutor::execute() {
     ds.colNames = std::move(colNames_);
 
     DCHECK(left->isSequentialIter());
-    auto leftIter = static_cast<SequentialIter*>(left.get());
-    ds.rows.insert(ds.rows.end(),
-                   std::make_move_iterator(leftIter->begin()),
-                   std::make_move_iterator(leftIter->end()));
+    static_cast<SequentialIter*>(left.get())->appendRows(&ds.rows);
 
     DCHECK(right->isSequentialIter());
-    auto rightIter = static_cast<SequentialIter*>(right.get());
-    ds.rows.insert(ds.rows.end(),
-                   std::make_move_iterator(rightIter->begin()),
-                   std::make_move_iterator(rightIter->end()));
+    static_cast<SequentialIter*>(right.get())->appendRows(&ds.rows);
 
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
@@ -20,13 +20,37 @@ folly::Future<Status> UnwindExecutor::execute() {
     auto &inputRes = ectx_->getResult(unwind->inputVar());
     auto iter = inputRes.iter();
     bool emptyInput = inputRes.valuePtr()->type() == Value::Type::DATASET ? false : true;
-    QueryExpressionContext ctx(ectx_);
-    auto *unwindExpr = unwind->unwindExpr();
+    if (splittable(iter.get())) {
+        auto kernel = [this, unwind, emptyInput](Iterator *morsel, size_t begin, size_t end) {
+            DataSet ds;
+            JobExprs unwindExpr(qctx_, {unwind->unwindExpr()});
+            unwindRows(unwindExpr[0], emptyInput, morsel, end - begin, &ds);
+            return ds;
+        };
+        return runMorsels<DataSet>(std::move(iter), std::move(kernel))
+            .thenValue([this, unwind](std::vector<DataSet> &&morsels) {
+                SCOPED_TIMER(&execTime_);
+                otherStats_.emplace("jobs", folly::to<std::string>(morsels.size()));
+                auto ds = concatMorsels(std::move(morsels), unwind->colNames());
+                return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+            });
+    }
 
     DataSet ds;
     ds.colNames = unwind->colNames();
-    for (; iter->valid(); iter->next()) {
-        const Value& list = unwindExpr->eval(ctx(iter.get()));
+    unwindRows(unwind->unwindExpr(), emptyInput, iter.get(), iter->size(), &ds);
+    VLOG(1) << "Unwind result is: " << ds;
+    return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+}
+
+void UnwindExecutor::unwindRows(Expression *unwindExpr,
+                                bool emptyInput,
+                                Iterator *iter,
+                                size_t numRows,
+                                DataSet *ds) {
+    QueryExpressionContext ctx(ectx_);
+    for (size_t n = 0; n < numRows && iter->valid(); ++n, iter->next()) {
+        const Value& list = unwindExpr->eval(ctx(iter));
         std::vector<Value> vals = extractList(list);
         for (auto &v : vals) {
             Row row;
@@ -34,11 +58,9 @@ folly::Future<Status> UnwindExecutor::execute() {
                 row = *(iter->row());
             }
             row.values.emplace_back(std::move(v));
-            ds.rows.emplace_back(std::move(row));
+            ds->rows.emplace_back(std::move(row));
         }
     }
-    VLOG(1) << "Unwind result is: " << ds;
-    return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
 std::vector<Value> UnwindExecutor::extractList(const Value &val) {
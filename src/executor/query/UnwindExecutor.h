@@ -7,6 +7,7 @@
 #ifndef EXECUTOR_QUERY_UNWINDEXECUTOR_H_
 #define EXECUTOR_QUERY_UNWINDEXECUTOR_H_
 
+#include "common/expression/Expression.h"
 #include "executor/Executor.h"
 
 namespace nebula {
@@ -20,6 +21,13 @@ public:
     folly::Future<Status> execute() override;
 
 private:
+    // Unwind at most `numRows' rows from the current one of `iter'
+    void unwindRows(Expression *unwindExpr,
+                    bool emptyInput,
+                    Iterator *iter,
+                    size_t numRows,
+                    DataSet *ds);
+
     std::vector<Value> extractList(const Value &val);
 };
 
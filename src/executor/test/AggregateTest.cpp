@@ -9,6 +9,7 @@
 #include "context/QueryContext.h"
 #include "executor/query/AggregateExecutor.h"
 #include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -2185,5 +2186,60 @@ TEST_F(AggregateTest, BitXor) {
         TEST_AGG_4("BIT_XOR", "bit_xor", true)
     }
 }
+
+TEST_F(AggregateTest, Parallel) {
+    std::string input = "input_parallel_agg";
+    DataSet ds;
+    ds.colNames = {"key", "val"};
+    for (auto i = 0; i < 20000; ++i) {
+        Row row;
+        row.values.emplace_back(i % 97);
+        row.values.emplace_back(i % 7 == 0 ? Value::kNullValue : Value(i));
+        ds.rows.emplace_back(std::move(row));
+    }
+    qctx_->symTable()->newVariable(input);
+    qctx_->ectx()->setResult(input, ResultBuilder().value(Value(std::move(ds))).finish());
+
+    auto runAgg = [&input](const std::vector<std::string>& funcs) {
+        std::vector<Expression*> groupKeys;
+        std::vector<Expression*> groupItems;
+        groupKeys.emplace_back(InputPropertyExpression::make(pool_, "key"));
+        groupItems.emplace_back(InputPropertyExpression::make(pool_, "key"));
+        std::vector<std::string> colNames = {"key"};
+        for (auto& func : funcs) {
+            auto* arg = InputPropertyExpression::make(pool_, "val");
+            groupItems.emplace_back(AggregateExpression::make(pool_, func, arg, false));
+            colNames.emplace_back(func);
+        }
+        auto* agg =
+            Aggregate::make(qctx_.get(), nullptr, std::move(groupKeys), std::move(groupItems));
+        agg->setInputVar(input);
+        agg->setColNames(std::move(colNames));
+
+        auto aggExe = std::make_unique<AggregateExecutor>(agg, qctx_.get());
+        auto status = aggExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        auto& result = qctx_->ectx()->getResult(agg->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        return result.value().getDataSet();
+    };
+
+    gflags::FlagSaver saver;
+    std::vector<std::string> funcs = {"COUNT", "SUM", "MAX", "MIN", "COLLECT", "COLLECT_SET"};
+
+    FLAGS_max_job_size = 1;
+    auto serial = runAgg(funcs);
+    EXPECT_EQ(serial.rows.size(), 97);
+
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 1000;
+    auto parallel = runAgg(funcs);
+    EXPECT_EQ(parallel, serial);
+
+    // The undecomposable functions fall back to the serial aggregation
+    auto avg = runAgg({"AVG"});
+    FLAGS_max_job_size = 1;
+    EXPECT_EQ(avg, runAgg({"AVG"}));
+}
 }   // namespace graph
 }   // namespace nebula
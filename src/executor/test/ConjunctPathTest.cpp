@@ -520,6 +520,13 @@ protected:
         }
     }
 
+    // The node of the prefix tree of the paths, see ProduceAllPathsExecutor
+    static Row pathNode(const std::string& vid, Value edge, int64_t parent) {
+        Row row;
+        row.values = {vid, std::move(edge), parent};
+        return row;
+    }
+
     void allPathInit() {
         qctx_->symTable()->newVariable("all_paths_forward1");
         qctx_->symTable()->newVariable("all_paths_backward1");
@@ -530,93 +537,43 @@ protected:
             // 1->2
             // 1->3
             DataSet ds;
-            ds.colNames = {kVid, kPathStr};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("1", {"2"}, 1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"2", std::move(paths)};
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                Row row;
-                List paths;
-                Path path = createPath("1", {"3"}, 1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"3", std::move(paths)};
-                ds.rows.emplace_back(std::move(row));
-            }
+            ds.colNames = {kVid, kEdgeStr, kParentStr};
+            ds.rows.emplace_back(pathNode("2", Edge("1", "2", 1, "edge1", 0, {}), -1));
+            ds.rows.emplace_back(pathNode("3", Edge("1", "3", 1, "edge1", 0, {}), -1));
             qctx_->ectx()->setResult("all_paths_forward1", ResultBuilder().value(ds).finish());
         }
         {
             // 4->7
             DataSet ds2;
-            ds2.colNames = {kVid, kPathStr};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("4", {"7"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"7", std::move(paths)};
-                ds2.rows.emplace_back(std::move(row));
-            }
+            ds2.colNames = {kVid, kEdgeStr, kParentStr};
+            ds2.rows.emplace_back(pathNode("7", Edge("4", "7", -1, "edge1", 0, {}), -1));
             qctx_->ectx()->setResult("all_paths_backward1", ResultBuilder().value(ds2).finish());
         }
         {
             // 2
             DataSet ds1;
-            ds1.colNames = {kVid, kPathStr};
-            {
-                Row row;
-                List paths;
-                Path path;
-                path.src = Vertex("2", {});
-                paths.values.emplace_back(std::move(path));
-                row.values = {"2", std::move(paths)};
-                ds1.rows.emplace_back(std::move(row));
-            }
+            ds1.colNames = {kVid, kEdgeStr, kParentStr};
+            ds1.rows.emplace_back(pathNode("2", Value::kEmpty, -1));
             qctx_->ectx()->setResult("all_paths_backward2", ResultBuilder().value(ds1).finish());
 
             // 2->7
             DataSet ds2;
-            ds2.colNames = {kVid, kPathStr};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("2", {"7"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"7", std::move(paths)};
-                ds2.rows.emplace_back(std::move(row));
-            }
+            ds2.colNames = {kVid, kEdgeStr, kParentStr};
+            ds2.rows.emplace_back(pathNode("7", Edge("2", "7", -1, "edge1", 0, {}), 0));
             qctx_->ectx()->setResult("all_paths_backward2", ResultBuilder().value(ds2).finish());
         }
         {
             // 4->3
             DataSet ds2;
-            ds2.colNames = {kVid, kPathStr};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("4", {"3"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"3", std::move(paths)};
-                ds2.rows.emplace_back(std::move(row));
-            }
+            ds2.colNames = {kVid, kEdgeStr, kParentStr};
+            ds2.rows.emplace_back(pathNode("3", Edge("4", "3", -1, "edge1", 0, {}), -1));
             qctx_->ectx()->setResult("all_paths_backward3", ResultBuilder().value(ds2).finish());
         }
         {
             // 5->4
             DataSet ds;
-            ds.colNames = {kVid, kPathStr};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("5", {"4"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"4", std::move(paths)};
-                ds.rows.emplace_back(std::move(row));
-            }
+            ds.colNames = {kVid, kEdgeStr, kParentStr};
+            ds.rows.emplace_back(pathNode("4", Edge("5", "4", -1, "edge1", 0, {}), -1));
             qctx_->ectx()->setResult("all_paths_backward4", ResultBuilder().value(ds).finish());
         }
     }
@@ -795,6 +752,70 @@ TEST_F(ConjunctPathTest, BiBFSThreeStepsPath) {
     }
 }
 
+TEST_F(ConjunctPathTest, BiBFSExpandSmallerSide) {
+    auto* conjunct = ConjunctPath::make(qctx_.get(),
+                                        StartNode::make(qctx_.get()),
+                                        StartNode::make(qctx_.get()),
+                                        ConjunctPath::PathKind::kBiBFS,
+                                        5);
+    conjunct->setLeftVar("forward1");
+    conjunct->setRightVar("backward4");
+    conjunct->setColNames({kPathStr});
+
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
+
+    {
+        auto future = conjunctExe->execute();
+        auto status = std::move(future).get();
+        EXPECT_TRUE(status.ok());
+
+        // Only the backward side with one vid is expanded in the next round
+        auto& forward = qctx_->ectx()->getResult("forward1");
+        EXPECT_TRUE(forward.value().getDataSet().rows.empty());
+        auto& backward = qctx_->ectx()->getResult("backward4");
+        DataSet expected;
+        expected.colNames = {kVid, kEdgeStr};
+        Row row;
+        row.values = {"4", Value::kEmpty};
+        expected.rows.emplace_back(std::move(row));
+        EXPECT_EQ(backward.value().getDataSet(), expected);
+    }
+
+    {
+        {
+            // Nothing from the forward side
+            DataSet ds1;
+            ds1.colNames = {kVid, kEdgeStr};
+            qctx_->ectx()->setResult("forward1", ResultBuilder().value(ds1).finish());
+        }
+        {
+            // 2->4@0
+            DataSet ds1;
+            ds1.colNames = {kVid, kEdgeStr};
+            Row row;
+            row.values = {"2", Edge("4", "2", -1, "edge1", 0, {})};
+            ds1.rows.emplace_back(std::move(row));
+            qctx_->ectx()->setResult("backward4", ResultBuilder().value(ds1).finish());
+        }
+        auto future = conjunctExe->execute();
+        auto status = std::move(future).get();
+        EXPECT_TRUE(status.ok());
+        auto& result = qctx_->ectx()->getResult(conjunct->outputVar());
+
+        DataSet expected;
+        expected.colNames = {kPathStr};
+        Row row;
+        row.values.emplace_back(createPath("1", {"2", "4", "5"}, 1));
+        expected.rows.emplace_back(std::move(row));
+        EXPECT_EQ(result.value().getDataSet(), expected);
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+
+        // The search is over
+        EXPECT_TRUE(qctx_->ectx()->getResult("forward1").value().getDataSet().rows.empty());
+        EXPECT_TRUE(qctx_->ectx()->getResult("backward4").value().getDataSet().rows.empty());
+    }
+}
+
 TEST_F(ConjunctPathTest, BiBFSFourStepsPath) {
     auto* conjunct = ConjunctPath::make(qctx_.get(),
                                         StartNode::make(qctx_.get()),
@@ -980,23 +1001,9 @@ TEST_F(ConjunctPathTest, AllPathsThreeStepsPath) {
             // 1->2->4@0
             // 1->2->4@1
             DataSet ds1;
-            ds1.colNames = {kVid, kPathStr};
-
-            Row row;
-            List paths;
-            {
-                Path path = createPath("1", {"2", "4"}, 1);
-                paths.values.emplace_back(std::move(path));
-            }
-            {
-                Path path;
-                path.src = Vertex("1", {});
-                path.steps.emplace_back(Step(Vertex("2", {}), 1, "edge1", 0, {}));
-                path.steps.emplace_back(Step(Vertex("4", {}), 1, "edge1", 1, {}));
-                paths.values.emplace_back(std::move(path));
-            }
-            row.values = {"4", std::move(paths)};
-            ds1.rows.emplace_back(std::move(row));
+            ds1.colNames = {kVid, kEdgeStr, kParentStr};
+            ds1.rows.emplace_back(pathNode("4", Edge("2", "4", 1, "edge1", 0, {}), 0));
+            ds1.rows.emplace_back(pathNode("4", Edge("2", "4", 1, "edge1", 1, {}), 0));
             qctx_->ectx()->setResult("all_paths_forward1", ResultBuilder().value(ds1).finish());
         }
         auto future = conjunctExe->execute();
@@ -1057,41 +1064,16 @@ TEST_F(ConjunctPathTest, AllPathsFourStepsPath) {
             // 1->2->6@0
             // 1->2->6@1
             DataSet ds1;
-            ds1.colNames = {kVid, kPathStr};
-
-            Row row;
-            List paths;
-            {
-                Path path = createPath("1", {"2", "6"}, 1);
-                paths.values.emplace_back(std::move(path));
-            }
-            {
-                Path path;
-                path.src = Vertex("1", {});
-                path.steps.emplace_back(Step(Vertex("2", {}), 1, "edge1", 0, {}));
-                path.steps.emplace_back(Step(Vertex("6", {}), 1, "edge1", 1, {}));
-                paths.values.emplace_back(std::move(path));
-            }
-            row.values = {"6", std::move(paths)};
-            ds1.rows.emplace_back(std::move(row));
+            ds1.colNames = {kVid, kEdgeStr, kParentStr};
+            ds1.rows.emplace_back(pathNode("6", Edge("2", "6", 1, "edge1", 0, {}), 0));
+            ds1.rows.emplace_back(pathNode("6", Edge("2", "6", 1, "edge1", 1, {}), 0));
             qctx_->ectx()->setResult("all_paths_forward1", ResultBuilder().value(ds1).finish());
         }
         {
             // 5->4->6@0
             DataSet ds1;
-            ds1.colNames = {kVid, kPathStr};
-
-            Row row;
-            List paths;
-            {
-                Path path;
-                path.src = Vertex("5", {});
-                path.steps.emplace_back(Step(Vertex("4", {}), -1, "edge1", 0, {}));
-                path.steps.emplace_back(Step(Vertex("6", {}), -1, "edge1", 0, {}));
-                paths.values.emplace_back(std::move(path));
-            }
-            row.values = {"6", std::move(paths)};
-            ds1.rows.emplace_back(std::move(row));
+            ds1.colNames = {kVid, kEdgeStr, kParentStr};
+            ds1.rows.emplace_back(pathNode("6", Edge("4", "6", -1, "edge1", 0, {}), 0));
             qctx_->ectx()->setResult("all_paths_backward4", ResultBuilder().value(ds1).finish());
         }
         auto future = conjunctExe->execute();
@@ -9,6 +9,7 @@
 #include "context/QueryContext.h"
 #include "planner/plan/Query.h"
 #include "executor/query/DataCollectExecutor.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -299,5 +300,87 @@ TEST_F(DataCollectTest, PathWithProp) {
     EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
 
+TEST_F(DataCollectTest, MToN) {
+    // The rows {k, k + 1, k + 2} of the step k, from 0
+    auto makeHistory = [this](const std::string& var) {
+        qctx_->symTable()->newVariable(var);
+        for (int64_t k = 0; k < 3; ++k) {
+            DataSet ds({"v"});
+            for (int64_t i = k; i < k + 3; ++i) {
+                ds.rows.emplace_back(Row({i}));
+            }
+            qctx_->ectx()->setResult(var, ResultBuilder().value(Value(std::move(ds))).finish());
+        }
+    };
+    auto collect = [this](const std::string& var, bool distinct) {
+        auto* dc = DataCollect::make(qctx_.get(), DataCollect::DCKind::kMToN);
+        dc->setInputVars({var});
+        dc->setMToN(StepClause(2, 3));
+        dc->setDistinct(distinct);
+        dc->setColNames({"v"});
+        auto dcExe = std::make_unique<DataCollectExecutor>(dc, qctx_.get());
+        EXPECT_TRUE(dcExe->execute().get().ok());
+        auto& result = qctx_->ectx()->getResult(dc->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        return result.value().getDataSet();
+    };
+
+    // The rows of the steps 2 to 3 in order
+    makeHistory("m_to_n");
+    DataSet expected({"v"});
+    for (int64_t i : {1, 2, 3, 2, 3, 4}) {
+        expected.rows.emplace_back(Row({i}));
+    }
+    EXPECT_EQ(collect("m_to_n", false), expected);
+
+    // The first occurrences across the steps
+    makeHistory("m_to_n_distinct");
+    DataSet distinct({"v"});
+    for (int64_t i : {1, 2, 3, 4}) {
+        distinct.rows.emplace_back(Row({i}));
+    }
+    EXPECT_EQ(collect("m_to_n_distinct", true), distinct);
+}
+
+TEST_F(DataCollectTest, PathWithPropInParallel) {
+    DataSet paths;
+    paths.colNames = {"paths"};
+    for (auto i = 0; i < 1000; ++i) {
+        Vertex src("0", {});
+        Vertex dst("1", {});
+        Step step(std::move(dst), 15, "like", 0, {});
+        Row row;
+        row.values.emplace_back(Path(std::move(src), {std::move(step)}));
+        paths.rows.emplace_back(std::move(row));
+    }
+    qctx_->symTable()->newVariable("many_paths");
+    qctx_->ectx()->setResult("many_paths",
+                             ResultBuilder().value(Value(std::move(paths))).finish());
+
+    gflags::FlagSaver saver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 100;
+    auto* dc = DataCollect::make(qctx_.get(), DataCollect::DCKind::kPathProp);
+    dc->setInputVars({"vertices", "edges", "many_paths"});
+    dc->setColNames({"paths"});
+    auto dcExe = std::make_unique<DataCollectExecutor>(dc, qctx_.get());
+    EXPECT_TRUE(dcExe->execute().get().ok());
+    auto& result = qctx_->ectx()->getResult(dc->outputVar());
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+
+    // Every morsel attaches the props in the order of the paths
+    DataSet expected;
+    expected.colNames = {"paths"};
+    for (auto i = 0; i < 1000; ++i) {
+        Vertex src("0", {Tag("player", {{"age", Value(20)}, {"name", Value("0")}})});
+        Vertex dst("1", {Tag("player", {{"age", Value(21)}, {"name", Value("1")}})});
+        Step step(std::move(dst), 15, "like", 0, {{"likeness", 90}});
+        Row row;
+        row.values.emplace_back(Path(std::move(src), {std::move(step)}));
+        expected.rows.emplace_back(std::move(row));
+    }
+    EXPECT_EQ(result.value().getDataSet(), expected);
+}
+
 }  // namespace graph
 }  // namespace nebula
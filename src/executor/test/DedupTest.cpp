@@ -10,6 +10,7 @@
 #include "executor/query/DedupExecutor.h"
 #include "executor/test/QueryTestBase.h"
 #include "executor/query/ProjectExecutor.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -83,5 +84,181 @@ TEST_F(DedupTest, WrongTypeIterator) {
                        "YIELD DISTINCT $-.v_dst as name",
                        expected);
 }
+
+TEST_F(DedupTest, VidFrontier) {
+    qctx_->symTable()->newVariable("vids");
+    auto* dedupNode = Dedup::make(qctx_.get(), nullptr);
+    dedupNode->setInputVar("vids");
+    dedupNode->setOutputVar("vids");
+    dedupNode->setVidFrontier();
+    auto dedupExec = std::make_unique<DedupExecutor>(dedupNode, qctx_.get());
+
+    auto dedup = [&](std::vector<Value> vids) {
+        DataSet ds({kVid});
+        for (auto& vid : vids) {
+            ds.emplace_back(Row({std::move(vid)}));
+        }
+        qctx_->ectx()->setResult("vids", ResultBuilder().value(Value(std::move(ds))).finish());
+        EXPECT_TRUE(dedupExec->execute().get().ok());
+        std::vector<Value> result;
+        for (auto iter = qctx_->ectx()->getResult("vids").iter(); iter->valid(); iter->next()) {
+            result.emplace_back(iter->getColumn(0));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    EXPECT_EQ(std::vector<Value>({"a", "b", "c"}), dedup({"a", "b", "a", "c", "b"}));
+    // Deduplicated in each step only
+    EXPECT_EQ(std::vector<Value>({"a", "d"}), dedup({"d", "a", "d"}));
+    EXPECT_EQ(std::vector<Value>(), dedup({}));
+}
+
+TEST_F(DedupTest, TestSelection) {
+    DataSet ds({"v"});
+    for (int64_t i = 0; i < 100; ++i) {
+        ds.rows.emplace_back(Row({(i * 7) % 10}));
+    }
+    qctx_->symTable()->newVariable("input_selection");
+    qctx_->ectx()->setResult("input_selection", ResultBuilder().value(Value(ds)).finish());
+
+    auto runDedup = [this](const std::string& input, const std::string& output) {
+        qctx_->symTable()->newVariable(output);
+        auto* dedupNode = Dedup::make(qctx_.get(), nullptr);
+        dedupNode->setInputVar(input);
+        dedupNode->setOutputVar(output);
+        auto dedupExec = std::make_unique<DedupExecutor>(dedupNode, qctx_.get());
+        EXPECT_TRUE(dedupExec->execute().get().ok());
+        return qctx_->ectx()->getResult(output).value().getDataSet();
+    };
+
+    // The first occurrences are selected in order
+    DataSet expected({"v"});
+    for (int64_t i = 0; i < 10; ++i) {
+        expected.rows.emplace_back(Row({(i * 7) % 10}));
+    }
+    EXPECT_EQ(runDedup("input_selection", "dedup_once"), expected);
+    EXPECT_EQ(qctx_->ectx()->getResult("dedup_once").size(), 10u);
+    // Deduplicate the rows selected by the dedup before
+    EXPECT_EQ(runDedup("dedup_once", "dedup_twice"), expected);
+    // The input shared by the dedups is untouched
+    EXPECT_EQ(qctx_->ectx()->getResult("input_selection").value().getDataSet(), ds);
+}
+
+TEST_F(DedupTest, VidFrontierSteps) {
+    qctx_->symTable()->newVariable("frontier_in");
+    qctx_->symTable()->newVariable("frontier_out");
+    auto* dedupNode = Dedup::make(qctx_.get(), nullptr);
+    dedupNode->setInputVar("frontier_in");
+    dedupNode->setOutputVar("frontier_out");
+    dedupNode->setVidFrontier();
+    auto dedupExec = std::make_unique<DedupExecutor>(dedupNode, qctx_.get());
+
+    std::vector<std::vector<Value>> steps = {
+        {"a", "b", "a", "c"},
+        {"c", "d", "c", "a", "e"},
+        {"e", "e", "f"},
+    };
+    for (auto& step : steps) {
+        DataSet ds({kVid});
+        for (auto& vid : step) {
+            ds.emplace_back(Row({vid}));
+        }
+        qctx_->ectx()->setResult("frontier_in",
+                                 ResultBuilder().value(Value(std::move(ds))).finish());
+        EXPECT_TRUE(dedupExec->execute().get().ok());
+    }
+
+    // Each step selects the first occurrences of its own input in order, the vids
+    // of the former steps are kept again
+    std::vector<std::vector<Value>> expected = {
+        {"a", "b", "c"},
+        {"c", "d", "a", "e"},
+        {"e", "f"},
+    };
+    const auto& hist = qctx_->ectx()->getHistory("frontier_out");
+    ASSERT_EQ(expected.size(), hist.size());
+    for (size_t i = 0; i < hist.size(); ++i) {
+        std::vector<Value> result;
+        for (auto iter = hist[i].iter(); iter->valid(); iter->next()) {
+            result.emplace_back(iter->getColumn(0));
+        }
+        EXPECT_EQ(expected[i], result) << "step " << i;
+    }
+}
+
+TEST_F(DedupTest, VidFrontierMoving) {
+    qctx_->symTable()->newVariable("moving_vids");
+    auto* dedupNode = Dedup::make(qctx_.get(), nullptr);
+    dedupNode->setInputVar("moving_vids");
+    dedupNode->setOutputVar("moving_vids");
+    dedupNode->setVidFrontier();
+    auto dedupExec = std::make_unique<DedupExecutor>(dedupNode, qctx_.get());
+
+    // Each vid of [begin, end) appears twice
+    auto dedup = [&](int64_t begin, int64_t end) {
+        DataSet ds({kVid});
+        for (auto i = begin; i < end; ++i) {
+            ds.emplace_back(Row({i}));
+            ds.emplace_back(Row({i}));
+        }
+        qctx_->ectx()->setResult("moving_vids",
+                                 ResultBuilder().value(Value(std::move(ds))).finish());
+        EXPECT_TRUE(dedupExec->execute().get().ok());
+        std::vector<Value> result;
+        for (auto iter = qctx_->ectx()->getResult("moving_vids").iter(); iter->valid();
+             iter->next()) {
+            result.emplace_back(iter->getColumn(0));
+        }
+        return result;
+    };
+    auto range = [](int64_t begin, int64_t end) {
+        std::vector<Value> vids;
+        for (auto i = begin; i < end; ++i) {
+            vids.emplace_back(i);
+        }
+        return vids;
+    };
+    EXPECT_EQ(range(0, 100), dedup(0, 100));
+    // The overlapped, shrunk and moved frontiers are deduplicated by their own vids
+    EXPECT_EQ(range(50, 150), dedup(50, 150));
+    EXPECT_EQ(range(140, 150), dedup(140, 150));
+    EXPECT_EQ(range(1000, 1010), dedup(1000, 1010));
+    EXPECT_EQ(range(0, 0), dedup(0, 0));
+    EXPECT_EQ(range(0, 5), dedup(0, 5));
+}
+
+TEST_F(DedupTest, TestInParallel) {
+    DataSet ds({"a", "b"});
+    for (int64_t i = 0; i < 3000; ++i) {
+        Row row;
+        row.values.emplace_back(i % 17);
+        row.values.emplace_back(i % 3 == 0 ? Value::kNullValue : Value(i % 5 == 0 ? "x" : "y"));
+        ds.rows.emplace_back(std::move(row));
+    }
+    qctx_->symTable()->newVariable("input_parallel");
+    qctx_->ectx()->setResult("input_parallel", ResultBuilder().value(Value(ds)).finish());
+
+    gflags::FlagSaver saver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 500;
+    qctx_->symTable()->newVariable("dedup_parallel");
+    auto* dedupNode = Dedup::make(qctx_.get(), nullptr);
+    dedupNode->setInputVar("input_parallel");
+    dedupNode->setOutputVar("dedup_parallel");
+    auto dedupExec = std::make_unique<DedupExecutor>(dedupNode, qctx_.get());
+    EXPECT_TRUE(dedupExec->execute().get().ok());
+
+    // The first occurrences are kept in order
+    DataSet expected({"a", "b"});
+    std::unordered_set<Row> unique;
+    for (auto& row : ds.rows) {
+        if (unique.emplace(row).second) {
+            expected.rows.emplace_back(row);
+        }
+    }
+    auto& result = qctx_->ectx()->getResult("dedup_parallel");
+    EXPECT_EQ(result.value().getDataSet(), expected);
+}
+
 }  // namespace graph
 }  // namespace nebula
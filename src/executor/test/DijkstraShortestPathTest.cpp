@@ -0,0 +1,169 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "context/QueryContext.h"
+#include "executor/algo/DijkstraShortestPathExecutor.h"
+#include "planner/plan/Algo.h"
+
+namespace nebula {
+namespace graph {
+class DijkstraShortestPathTest : public testing::Test {
+protected:
+    void SetUp() override {
+        qctx_ = std::make_unique<QueryContext>();
+        qctx_->symTable()->newVariable("input");
+        qctx_->symTable()->newVariable("from");
+        qctx_->symTable()->newVariable("to");
+        /*
+         *  0->1 (1), 0->2 (4)
+         *  1->2 (1), 1->3 (5)
+         *  2->3 (1)
+         */
+        edges_["0"] = {{"1", 1}, {"2", 4}};
+        edges_["1"] = {{"2", 1}, {"3", 5}};
+        edges_["2"] = {{"3", 1}};
+    }
+
+    // Set the neighbors of the vids fetched last round to the input
+    void setNeighbors(const std::string& fromVar) {
+        DataSet ds;
+        ds.colNames = {kVid, "_stats", "_edge:+like:_type:_dst:_rank:weight", "_expr"};
+        for (auto& row : qctx_->ectx()->getResult(fromVar).value().getDataSet().rows) {
+            const auto& vid = row.values[0];
+            Row neighbors;
+            neighbors.values.emplace_back(vid);
+            neighbors.values.emplace_back(Value());
+            List edges;
+            for (auto& dst : edges_[vid.getStr()]) {
+                List edge;
+                edge.values.emplace_back(1);
+                edge.values.emplace_back(dst.first);
+                edge.values.emplace_back(0);
+                edge.values.emplace_back(dst.second);
+                edges.values.emplace_back(std::move(edge));
+            }
+            neighbors.values.emplace_back(std::move(edges));
+            neighbors.values.emplace_back(Value());
+            ds.rows.emplace_back(std::move(neighbors));
+        }
+        List datasets;
+        datasets.values.emplace_back(std::move(ds));
+        ResultBuilder builder;
+        builder.value(std::move(datasets)).iter(Iterator::Kind::kGetNeighbors);
+        qctx_->ectx()->setResult("input", builder.finish());
+    }
+
+    static DataSet vids(const std::vector<std::string>& vids) {
+        DataSet ds;
+        ds.colNames = {kVid};
+        for (auto& vid : vids) {
+            Row row;
+            row.values.emplace_back(vid);
+            ds.rows.emplace_back(std::move(row));
+        }
+        return ds;
+    }
+
+    // Run the rounds of the loop until no vid to fetch, return the paths found
+    std::vector<Value> search(size_t steps, size_t* rounds) {
+        auto* dijkstra = DijkstraShortestPath::make(qctx_.get(), nullptr, "weight", steps);
+        dijkstra->setInputVar("input");
+        dijkstra->setFromVidsVar("from");
+        dijkstra->setToVidsVar("to");
+        dijkstra->setColNames({kPathStr});
+        auto exe = std::make_unique<DijkstraShortestPathExecutor>(dijkstra, qctx_.get());
+
+        std::vector<Value> paths;
+        *rounds = 0;
+        while (!qctx_->ectx()->getResult("from").value().getDataSet().rows.empty()) {
+            setNeighbors("from");
+            auto status = exe->execute().get();
+            EXPECT_TRUE(status.ok());
+            ++*rounds;
+            auto& result = qctx_->ectx()->getResult(dijkstra->outputVar());
+            for (auto& row : result.value().getDataSet().rows) {
+                paths.emplace_back(row.values[0]);
+            }
+        }
+        return paths;
+    }
+
+    static Value path(const std::vector<std::string>& vids) {
+        Path path;
+        path.src = Vertex(vids.front(), {});
+        for (size_t i = 1; i < vids.size(); ++i) {
+            path.steps.emplace_back(Step(Vertex(vids[i], {}), 1, "like", 0, {}));
+        }
+        return Value(std::move(path));
+    }
+
+    std::unique_ptr<QueryContext> qctx_;
+    std::unordered_map<std::string, std::vector<std::pair<std::string, int64_t>>> edges_;
+};
+
+TEST_F(DijkstraShortestPathTest, Shortest) {
+    qctx_->ectx()->setResult("from", ResultBuilder().value(Value(vids({"0"}))).finish());
+    qctx_->ectx()->setResult("to", ResultBuilder().value(Value(vids({"3"}))).finish());
+
+    size_t rounds = 0;
+    auto paths = search(5, &rounds);
+    std::vector<Value> expected = {path({"0", "1", "2", "3"})};
+    EXPECT_EQ(expected, paths);
+    // {0}, {1, 2}, {3}
+    EXPECT_EQ(3u, rounds);
+}
+
+TEST_F(DijkstraShortestPathTest, WithinSteps) {
+    qctx_->ectx()->setResult("from", ResultBuilder().value(Value(vids({"0"}))).finish());
+    qctx_->ectx()->setResult("to", ResultBuilder().value(Value(vids({"3"}))).finish());
+
+    size_t rounds = 0;
+    auto paths = search(2, &rounds);
+    std::vector<Value> expected = {path({"0", "2", "3"})};
+    EXPECT_EQ(expected, paths);
+    // The neighbors of the vids at the last step are not fetched
+    EXPECT_EQ(2u, rounds);
+}
+
+TEST_F(DijkstraShortestPathTest, MultiplePairs) {
+    edges_["0"].emplace_back("3", 3);
+    qctx_->ectx()->setResult("from", ResultBuilder().value(Value(vids({"0", "1"}))).finish());
+    qctx_->ectx()->setResult("to", ResultBuilder().value(Value(vids({"2", "3"}))).finish());
+
+    size_t rounds = 0;
+    auto paths = search(5, &rounds);
+    std::sort(paths.begin(), paths.end());
+    // 0->1->2->3 and 0->3 are of the same weight, the fewer hops wins
+    std::vector<Value> expected = {
+        path({"0", "1", "2"}),
+        path({"0", "3"}),
+        path({"1", "2"}),
+        path({"1", "2", "3"}),
+    };
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, paths);
+}
+
+TEST_F(DijkstraShortestPathTest, NegativeWeight) {
+    edges_["0"] = {{"1", -1}};
+    qctx_->ectx()->setResult("from", ResultBuilder().value(Value(vids({"0"}))).finish());
+    qctx_->ectx()->setResult("to", ResultBuilder().value(Value(vids({"1"}))).finish());
+
+    auto* dijkstra = DijkstraShortestPath::make(qctx_.get(), nullptr, "weight", 5);
+    dijkstra->setInputVar("input");
+    dijkstra->setFromVidsVar("from");
+    dijkstra->setToVidsVar("to");
+    dijkstra->setColNames({kPathStr});
+    auto exe = std::make_unique<DijkstraShortestPathExecutor>(dijkstra, qctx_.get());
+    setNeighbors("from");
+    auto status = exe->execute().get();
+    EXPECT_FALSE(status.ok());
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,202 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "context/QueryContext.h"
+#include "executor/query/ExpandExecutor.h"
+#include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+class ExpandTest : public testing::Test {
+protected:
+    void SetUp() override {
+        qctx_ = std::make_unique<QueryContext>();
+        meta::cpp2::Session session;
+        session.set_session_id(0);
+        session.set_user_name("root");
+        auto clientSession = ClientSession::create(std::move(session), nullptr);
+        SpaceInfo spaceInfo;
+        spaceInfo.name = "test_space";
+        spaceInfo.id = 1;
+        spaceInfo.spaceDesc.set_space_name("test_space");
+        clientSession->setSpace(std::move(spaceInfo));
+        auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+        rctx->setSession(std::move(clientSession));
+        qctx_->setRCtx(std::move(rctx));
+    }
+
+    Expand* makeExpand(uint32_t steps, std::vector<std::string> vids) {
+        DataSet ds;
+        ds.colNames = {"id"};
+        for (auto& vid : vids) {
+            ds.rows.emplace_back(Row({std::move(vid)}));
+        }
+        qctx_->symTable()->newVariable("input_expand");
+        qctx_->ectx()->setResult("input_expand",
+                                 ResultBuilder().value(Value(std::move(ds))).finish());
+
+        auto* pool = qctx_->objPool();
+        auto* expand = Expand::make(qctx_.get(),
+                                    nullptr,
+                                    1,
+                                    InputPropertyExpression::make(pool, "id"),
+                                    std::make_unique<std::vector<storage::cpp2::EdgeProp>>(),
+                                    steps);
+        expand->setInputVar("input_expand");
+        expand->setColNames({kVid});
+        return expand;
+    }
+
+    // The response of the neighbors of `edges', from the src to the dst
+    static storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse> makeResponse(
+        const std::vector<std::pair<std::string, std::string>>& edges) {
+        DataSet ds({kVid, "_stats", "_edge:+like:_dst", "_expr"});
+        for (auto& edge : edges) {
+            List dsts;
+            dsts.values.emplace_back(List({edge.second}));
+            ds.rows.emplace_back(Row({edge.first, Value::kEmpty, std::move(dsts), Value::kEmpty}));
+        }
+        storage::cpp2::GetNeighborsResponse resp;
+        resp.set_vertices(std::move(ds));
+        storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse> rpcResp(1);
+        rpcResp.responses().emplace_back(std::move(resp));
+        return rpcResp;
+    }
+
+    static std::vector<Value> vidsOf(const std::vector<Row>& rows) {
+        std::vector<Value> vids;
+        for (auto& row : rows) {
+            vids.emplace_back(row.values.front());
+        }
+        return vids;
+    }
+
+    static std::vector<Row> rowsOf(const std::vector<std::string>& vids) {
+        std::vector<Row> rows;
+        for (auto& vid : vids) {
+            rows.emplace_back(Row({vid}));
+        }
+        return rows;
+    }
+
+    // The number of the vertices of each live step
+    static std::map<size_t, size_t> sizesOf(const ExpandExecutor& executor) {
+        std::map<size_t, size_t> sizes;
+        for (auto& step : executor.steps_) {
+            sizes.emplace(step.first, step.second.frontier.size());
+        }
+        return sizes;
+    }
+
+    std::unique_ptr<QueryContext> qctx_;
+};
+
+TEST_F(ExpandTest, EmptyInput) {
+    auto* expand = makeExpand(3, {});
+    ExpandExecutor executor(expand, qctx_.get());
+    auto status = executor.execute().get();
+    ASSERT_TRUE(status.ok()) << status;
+
+    auto& result = qctx_->ectx()->getResult(expand->outputVar());
+    ASSERT_TRUE(result.value().isDataSet());
+    DataSet expected({kVid});
+    EXPECT_EQ(expected, result.value().getDataSet());
+    EXPECT_EQ(Result::State::kSuccess, result.state());
+}
+
+TEST_F(ExpandTest, HandleResponse) {
+    gflags::FlagSaver saver;
+    FLAGS_expand_batch_size = 1;
+    auto* expand = makeExpand(3, {"a", "b"});
+    ExpandExecutor executor(expand, qctx_.get());
+    executor.start(rowsOf({"a", "b"}));
+
+    // The sources may be in the next frontier as well
+    auto next = executor.handleResponse(0, makeResponse({{"a", "b"}, {"a", "c"}, {"b", "c"}}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ(std::vector<Value>({"b", "c"}), vidsOf(next.value()));
+
+    // The vertices in the frontier already are not expanded again
+    next = executor.handleResponse(0, makeResponse({{"b", "c"}, {"b", "d"}}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ(std::vector<Value>({"d"}), vidsOf(next.value()));
+
+    next = executor.handleResponse(1, makeResponse({{"b", "a"}, {"d", "e"}}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ(std::vector<Value>({"a", "e"}), vidsOf(next.value()));
+
+    // The destinations of the last step are only collected
+    next = executor.handleResponse(2, makeResponse({{"a", "b"}, {"e", "f"}}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_TRUE(next.value().empty());
+
+    // The sources are dropped once both of their requests are responded
+    EXPECT_EQ((std::map<size_t, size_t>{{1, 3}, {2, 2}, {3, 2}}), sizesOf(executor));
+}
+
+TEST_F(ExpandTest, ReleaseSteps) {
+    gflags::FlagSaver saver;
+    FLAGS_expand_batch_size = 1;
+    auto* expand = makeExpand(3, {"a"});
+    ExpandExecutor executor(expand, qctx_.get());
+    executor.start(rowsOf({"a"}));
+
+    auto next = executor.handleResponse(0, makeResponse({{"a", "b"}, {"a", "c"}}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ((std::map<size_t, size_t>{{1, 2}}), sizesOf(executor));
+
+    // The step 1 is kept until the response of "c" as well
+    next = executor.handleResponse(1, makeResponse({{"b", "d"}}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ((std::map<size_t, size_t>{{1, 2}, {2, 1}}), sizesOf(executor));
+    next = executor.handleResponse(1, makeResponse({}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ((std::map<size_t, size_t>{{2, 1}}), sizesOf(executor));
+
+    // The last step is kept as the output
+    next = executor.handleResponse(2, makeResponse({{"d", "e"}}));
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ((std::map<size_t, size_t>{{3, 1}}), sizesOf(executor));
+
+    // Nothing is allocated for the steps not reached
+    auto* huge = makeExpand(2000000000, {"a"});
+    ExpandExecutor hugeExecutor(huge, qctx_.get());
+    hugeExecutor.start(rowsOf({"a"}));
+    EXPECT_EQ((std::map<size_t, size_t>{{0, 1}}), sizesOf(hugeExecutor));
+}
+
+TEST_F(ExpandTest, PartialSuccess) {
+    gflags::FlagSaver saver;
+    auto* expand = makeExpand(2, {"a"});
+    ExpandExecutor executor(expand, qctx_.get());
+    executor.start(rowsOf({"a"}));
+
+    auto makeFailed = []() {
+        auto resp = makeResponse({{"a", "b"}});
+        storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse> rpcResp(2);
+        rpcResp.responses() = std::move(resp.responses());
+        rpcResp.markFailure();
+        rpcResp.emplaceFailedPart(1, nebula::cpp2::ErrorCode::E_LEADER_CHANGED);
+        return rpcResp;
+    };
+
+    FLAGS_accept_partial_success = false;
+    auto next = executor.handleResponse(0, makeFailed());
+    EXPECT_FALSE(next.ok());
+
+    FLAGS_accept_partial_success = true;
+    next = executor.handleResponse(0, makeFailed());
+    ASSERT_TRUE(next.ok()) << next.status();
+    EXPECT_EQ(std::vector<Value>({"b"}), vidsOf(next.value()));
+    EXPECT_EQ(Result::State::kPartialSuccess, executor.state_);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -10,6 +10,7 @@
 #include "executor/query/ProjectExecutor.h"
 #include "executor/test/QueryTestBase.h"
 #include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
 #include "util/ExpressionUtils.h"
 
 namespace nebula {
@@ -88,5 +89,208 @@ TEST_F(FilterTest, TestEmpty) {
                         "YIELD $^.person.name AS name WHERE study.start_year >= 2010",
                         expected);
 }
+
+TEST_F(FilterTest, TestBatchEval) {
+    // Cover several batches with null, empty and overflowed cells
+    DataSet ds({"age", "city", "score"});
+    for (int64_t i = 0; i < 3000; ++i) {
+        Row row;
+        row.values.emplace_back(i % 7 == 0 ? Value::kNullValue : Value(i % 100));
+        row.values.emplace_back(i % 11 == 0 ? Value::kEmpty : Value(i % 2 == 0 ? "x" : "y"));
+        row.values.emplace_back(i % 13 == 0 ? Value(std::numeric_limits<int64_t>::max())
+                                            : Value(i * 10));
+        ds.rows.emplace_back(std::move(row));
+    }
+    qctx_->symTable()->newVariable("input_large");
+
+    size_t runs = 0;
+    auto runFilter = [this, &ds, &runs](const std::string& sentence, bool batch) {
+        // The filter erases the rows of its input in place
+        qctx_->ectx()->setResult("input_large", ResultBuilder().value(Value(ds)).finish());
+        FLAGS_enable_batch_eval = batch;
+        auto outputVar = folly::stringPrintf("filter_large_%lu", runs++);
+        qctx_->symTable()->newVariable(outputVar);
+        auto* filterNode = Filter::make(
+            qctx_.get(), nullptr, getYieldFilter(sentence, qctx_.get()), true);
+        filterNode->setInputVar("input_large");
+        filterNode->setOutputVar(outputVar);
+        auto filterExec = std::make_unique<FilterExecutor>(filterNode, qctx_.get());
+        EXPECT_TRUE(filterExec->execute().get().ok());
+        FLAGS_enable_batch_eval = true;
+        return qctx_->ectx()->getResult(outputVar).value().getDataSet();
+    };
+
+    for (auto& sentence : {
+             "YIELD $-.age WHERE $-.age > 30 AND $-.city == \"x\"",
+             "YIELD $-.age WHERE $-.age + 1 <= 50 OR NOT ($-.city != \"y\")",
+             "YIELD $-.age WHERE $-.score * 2 > 100 XOR $-.age < 10",
+             "YIELD $-.age WHERE $-.score + $-.age >= 20000",
+         }) {
+        auto expected = runFilter(sentence, false);
+        auto result = runFilter(sentence, true);
+        EXPECT_EQ(result, expected) << sentence;
+        EXPECT_FALSE(result.rows.empty()) << sentence;
+    }
+}
+
+TEST_F(FilterTest, TestInParallel) {
+    DataSet ds({"age", "city"});
+    for (int64_t i = 0; i < 3000; ++i) {
+        Row row;
+        row.values.emplace_back(i % 7 == 0 ? Value::kNullValue : Value(i % 100));
+        row.values.emplace_back(i % 2 == 0 ? "x" : "y");
+        ds.rows.emplace_back(std::move(row));
+    }
+    qctx_->symTable()->newVariable("input_parallel");
+
+    size_t runs = 0;
+    auto runFilter = [this, &ds, &runs](const std::string& sentence) {
+        qctx_->ectx()->setResult("input_parallel", ResultBuilder().value(Value(ds)).finish());
+        auto outputVar = folly::stringPrintf("filter_parallel_%lu", runs++);
+        qctx_->symTable()->newVariable(outputVar);
+        auto* filterNode = Filter::make(
+            qctx_.get(), nullptr, getYieldFilter(sentence, qctx_.get()), true);
+        filterNode->setInputVar("input_parallel");
+        filterNode->setOutputVar(outputVar);
+        auto filterExec = std::make_unique<FilterExecutor>(filterNode, qctx_.get());
+        EXPECT_TRUE(filterExec->execute().get().ok());
+        return qctx_->ectx()->getResult(outputVar).value().getDataSet();
+    };
+
+    gflags::FlagSaver saver;
+    for (auto batch : {true, false}) {
+        FLAGS_enable_batch_eval = batch;
+        for (auto& sentence : {
+                 "YIELD $-.age WHERE $-.age > 30 AND $-.city == \"x\"",
+                 "YIELD $-.age WHERE udf_is_in($-.age, 1, 2, 3)",
+             }) {
+            FLAGS_max_job_size = 1;
+            auto serial = runFilter(sentence);
+            FLAGS_max_job_size = 4;
+            FLAGS_min_batch_size = 500;
+            auto parallel = runFilter(sentence);
+            EXPECT_EQ(parallel, serial) << sentence;
+            EXPECT_FALSE(parallel.rows.empty()) << sentence;
+        }
+    }
+}
+
+TEST_F(FilterTest, TestClonesReused) {
+    DataSet ds({"age"});
+    for (int64_t i = 0; i < 3000; ++i) {
+        ds.rows.emplace_back(Row({i}));
+    }
+    qctx_->symTable()->newVariable("input_reused");
+    qctx_->symTable()->newVariable("filter_reused");
+    auto* filterNode = Filter::make(
+        qctx_.get(), nullptr, getYieldFilter("YIELD $-.age WHERE $-.age > 30", qctx_.get()));
+    filterNode->setInputVar("input_reused");
+    filterNode->setOutputVar("filter_reused");
+    std::vector<Expression*> condition{filterNode->condition()};
+
+    gflags::FlagSaver saver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 500;
+    auto runFilter = [this, &ds, filterNode]() {
+        qctx_->ectx()->setResult("input_reused", ResultBuilder().value(Value(ds)).finish());
+        auto filterExec = std::make_unique<FilterExecutor>(filterNode, qctx_.get());
+        EXPECT_TRUE(filterExec->execute().get().ok());
+        EXPECT_EQ(qctx_->ectx()->getResult("filter_reused").size(), 2969);
+    };
+    runFilter();
+    auto clones = qctx_->lendClones(condition);
+    EXPECT_NE(clones.front(), condition.front());
+    qctx_->giveBackClones(condition, clones);
+
+    // Executing the node again, e.g. in a loop, evaluates the clones made before
+    runFilter();
+    runFilter();
+    auto again = qctx_->lendClones(condition);
+    EXPECT_EQ(again, clones);
+    qctx_->giveBackClones(condition, again);
+}
+
+TEST_F(FilterTest, TestSelection) {
+    DataSet ds({"age"});
+    for (int64_t i = 0; i < 100; ++i) {
+        ds.rows.emplace_back(Row({i}));
+    }
+    qctx_->symTable()->newVariable("input_selection");
+    qctx_->ectx()->setResult("input_selection", ResultBuilder().value(Value(ds)).finish());
+
+    auto runFilter = [this](const std::string& input,
+                            const std::string& output,
+                            const std::string& sentence) {
+        qctx_->symTable()->newVariable(output);
+        auto* filterNode =
+            Filter::make(qctx_.get(), nullptr, getYieldFilter(sentence, qctx_.get()), false);
+        filterNode->setInputVar(input);
+        filterNode->setOutputVar(output);
+        auto filterExec = std::make_unique<FilterExecutor>(filterNode, qctx_.get());
+        EXPECT_TRUE(filterExec->execute().get().ok());
+        return qctx_->ectx()->getResult(output).value().getDataSet();
+    };
+
+    // Filter the rows selected by the filter before
+    runFilter("input_selection", "filter_odd", "YIELD $-.age WHERE $-.age % 2 == 1");
+    auto result = runFilter("filter_odd", "filter_big", "YIELD $-.age WHERE $-.age > 90");
+
+    // The rows are kept in order even if the filter needn't be stable
+    DataSet expected({"age"});
+    for (int64_t i = 91; i < 100; i += 2) {
+        expected.rows.emplace_back(Row({i}));
+    }
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(qctx_->ectx()->getResult("filter_odd").size(), 50);
+    // The input shared by the filters is untouched
+    EXPECT_EQ(qctx_->ectx()->getResult("input_selection").value().getDataSet(), ds);
+}
+
+TEST_F(FilterTest, TestSharedInput) {
+    // One variable feeds a Filter, a Sort and a Union
+    DataSet ds({"age"});
+    for (int64_t i = 0; i < 10; ++i) {
+        ds.rows.emplace_back(Row({i}));
+    }
+    qctx_->symTable()->newVariable("input_shared");
+    qctx_->ectx()->setResult("input_shared", ResultBuilder().value(Value(ds)).finish());
+
+    qctx_->symTable()->newVariable("filter_shared");
+    auto* filterNode = Filter::make(
+        qctx_.get(), nullptr, getYieldFilter("YIELD $-.age WHERE $-.age < 3", qctx_.get()));
+    filterNode->setInputVar("input_shared");
+    filterNode->setOutputVar("filter_shared");
+    EXPECT_TRUE(Executor::create(filterNode, qctx_.get())->execute().get().ok());
+
+    auto* sortNode = Sort::make(qctx_.get(), nullptr, {{0, OrderFactor::OrderType::DESCEND}});
+    sortNode->setInputVar("input_shared");
+    EXPECT_TRUE(Executor::create(sortNode, qctx_.get())->execute().get().ok());
+
+    auto* unionNode = Union::make(qctx_.get(), filterNode, sortNode);
+    unionNode->setLeftVar("filter_shared");
+    unionNode->setRightVar("input_shared");
+    EXPECT_TRUE(Executor::create(unionNode, qctx_.get())->execute().get().ok());
+
+    DataSet filtered({"age"});
+    DataSet sorted({"age"});
+    DataSet unioned({"age"});
+    for (int64_t i = 0; i < 3; ++i) {
+        filtered.rows.emplace_back(Row({i}));
+        unioned.rows.emplace_back(Row({i}));
+    }
+    for (int64_t i = 0; i < 10; ++i) {
+        sorted.rows.emplace_back(Row({9 - i}));
+        unioned.rows.emplace_back(Row({i}));
+    }
+    auto* ectx = qctx_->ectx();
+    EXPECT_EQ(ectx->getResult("filter_shared").value().getDataSet(), filtered);
+    EXPECT_EQ(ectx->getResult(sortNode->outputVar()).value().getDataSet(), sorted);
+    EXPECT_EQ(ectx->getResult(unionNode->outputVar()).value().getDataSet(), unioned);
+    // The input is read by all of them and left untouched
+    EXPECT_EQ(ectx->getResult("input_shared").value().getDataSet(), ds);
+    EXPECT_EQ(ectx->getResult("filter_shared").valuePtr(),
+              ectx->getResult(sortNode->outputVar()).valuePtr());
+}
+
 }   // namespace graph
 }   // namespace nebula
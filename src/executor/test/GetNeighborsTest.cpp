@@ -9,6 +9,7 @@
 #include "context/QueryContext.h"
 #include "planner/plan/Query.h"
 #include "executor/query/GetNeighborsExecutor.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -45,6 +46,53 @@ protected:
         qctx_->setRCtx(std::move(rctx));
     }
 
+    GetNeighbors* makeGetNeighbors(const std::string& inputVar, int64_t limit) {
+        auto* pool = qctx_->objPool();
+        auto* gn = GetNeighbors::make(
+                qctx_.get(),
+                nullptr,
+                0,
+                InputPropertyExpression::make(pool, "id"),
+                std::vector<EdgeType>(),
+                storage::cpp2::EdgeDirection::OUT_EDGE,
+                nullptr,
+                std::make_unique<std::vector<storage::cpp2::EdgeProp>>(),
+                nullptr,
+                nullptr);
+        gn->setInputVar(inputVar);
+        gn->setLimit(limit);
+        return gn;
+    }
+
+    // The response of `srcs', each of which has an edge to itself
+    static storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse> makeResponse(
+        const std::vector<std::string>& srcs, size_t failedParts = 0) {
+        DataSet ds({kVid, "_stats", "_edge:+like:_dst", "_expr"});
+        for (auto& src : srcs) {
+            List edges;
+            edges.values.emplace_back(List({src}));
+            ds.rows.emplace_back(Row({src, Value::kEmpty, std::move(edges), Value::kEmpty}));
+        }
+        storage::cpp2::GetNeighborsResponse resp;
+        resp.set_vertices(std::move(ds));
+        storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse> rpcResp(
+            1 + failedParts);
+        rpcResp.responses().emplace_back(std::move(resp));
+        for (size_t i = 0; i < failedParts; ++i) {
+            rpcResp.markFailure();
+            rpcResp.emplaceFailedPart(i + 1, nebula::cpp2::ErrorCode::E_LEADER_CHANGED);
+        }
+        return rpcResp;
+    }
+
+    static std::vector<Value> vidsOf(const std::vector<Row>& rows) {
+        std::vector<Value> vids;
+        for (auto& row : rows) {
+            vids.emplace_back(row.values.front());
+        }
+        return vids;
+    }
+
 protected:
     std::unique_ptr<QueryContext> qctx_;
 };
@@ -83,5 +131,95 @@ TEST_F(GetNeighborsTest, BuildRequestDataSet) {
     }
     EXPECT_EQ(reqDs, expected);
 }
+
+TEST_F(GetNeighborsTest, EmptyInput) {
+    DataSet ds;
+    ds.colNames = {"id"};
+    qctx_->symTable()->newVariable("empty_gn");
+    qctx_->ectx()->setResult("empty_gn", ResultBuilder().value(Value(std::move(ds))).finish());
+
+    auto* gn = makeGetNeighbors("empty_gn", 2);
+    GetNeighborsExecutor gnExe(gn, qctx_.get());
+    auto status = gnExe.execute().get();
+    ASSERT_TRUE(status.ok()) << status;
+    auto& result = qctx_->ectx()->getResult(gn->outputVar());
+    EXPECT_EQ(Value(List()), result.value());
+    EXPECT_EQ(0u, result.iter()->size());
+}
+
+TEST_F(GetNeighborsTest, Rounds) {
+    auto* gn = makeGetNeighbors("input_gn", 2);
+    GetNeighborsExecutor gnExe(gn, qctx_.get());
+    auto makeRounds = [&gnExe](size_t numVids) {
+        auto reqDs = gnExe.buildRequestDataSet();
+        reqDs.rows.resize(numVids);
+        auto rounds = std::make_shared<GetNeighborsExecutor::Rounds>();
+        rounds->colNames = std::move(reqDs.colNames);
+        rounds->vids = std::move(reqDs.rows);
+        rounds->roundSize = 2;
+        return rounds;
+    };
+    {
+        // The last round takes the rest, fewer than the doubled round size
+        auto rounds = makeRounds(5);
+        EXPECT_EQ(std::vector<Value>({"0", "1"}), vidsOf(gnExe.nextRound(rounds.get())));
+        auto more = gnExe.handleRound(rounds.get(), makeResponse({}));
+        ASSERT_TRUE(more.ok()) << more.status();
+        EXPECT_TRUE(more.value());
+
+        EXPECT_EQ(std::vector<Value>({"2", "3", "4"}), vidsOf(gnExe.nextRound(rounds.get())));
+        more = gnExe.handleRound(rounds.get(), makeResponse({"3"}));
+        ASSERT_TRUE(more.ok()) << more.status();
+        // Not enough rows, but no more vertices
+        EXPECT_FALSE(more.value());
+        EXPECT_EQ(2u, rounds->numRounds);
+        EXPECT_EQ(1, rounds->numRows);
+
+        ASSERT_TRUE(gnExe.finishRounds(rounds.get()).ok());
+        auto& result = qctx_->ectx()->getResult(gn->outputVar());
+        EXPECT_EQ(Result::State::kSuccess, result.state());
+        EXPECT_EQ(1u, result.iter()->size());
+    }
+    {
+        // Stop once there are enough rows
+        auto rounds = makeRounds(10);
+        EXPECT_EQ(2u, gnExe.nextRound(rounds.get()).size());
+        auto more = gnExe.handleRound(rounds.get(), makeResponse({"0", "1"}));
+        ASSERT_TRUE(more.ok()) << more.status();
+        EXPECT_FALSE(more.value());
+        EXPECT_EQ(2u, rounds->next);
+    }
+}
+
+TEST_F(GetNeighborsTest, ErrorInRound) {
+    gflags::FlagSaver saver;
+    auto* gn = makeGetNeighbors("input_gn", 5);
+    GetNeighborsExecutor gnExe(gn, qctx_.get());
+    auto reqDs = gnExe.buildRequestDataSet();
+    auto rounds = std::make_shared<GetNeighborsExecutor::Rounds>();
+    rounds->colNames = std::move(reqDs.colNames);
+    rounds->vids = std::move(reqDs.rows);
+    rounds->roundSize = 1;
+
+    gnExe.nextRound(rounds.get());
+    auto more = gnExe.handleRound(rounds.get(), makeResponse({"0"}));
+    ASSERT_TRUE(more.ok()) << more.status();
+    EXPECT_TRUE(more.value());
+
+    // The partial success is kept in the state of the rounds
+    FLAGS_accept_partial_success = true;
+    gnExe.nextRound(rounds.get());
+    more = gnExe.handleRound(rounds.get(), makeResponse({"1"}, 1));
+    ASSERT_TRUE(more.ok()) << more.status();
+    EXPECT_TRUE(more.value());
+    EXPECT_EQ(Result::State::kPartialSuccess, rounds->state);
+
+    // A failed round in the middle fails the whole
+    FLAGS_accept_partial_success = false;
+    gnExe.nextRound(rounds.get());
+    more = gnExe.handleRound(rounds.get(), makeResponse({"3"}, 1));
+    EXPECT_FALSE(more.ok());
+    EXPECT_LT(rounds->next, rounds->vids.size());
+}
 }  // namespace graph
 }  // namespace nebula
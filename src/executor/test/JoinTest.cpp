@@ -11,6 +11,7 @@
 #include "executor/query/InnerJoinExecutor.h"
 #include "executor/query/LeftJoinExecutor.h"
 #include "executor/test/QueryTestBase.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -558,5 +559,139 @@ TEST_F(JoinTest, InnerJoinAndLeftjoin) {
     EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
 
+TEST_F(JoinTest, LeftJoinOnSmallerLhs) {
+    auto runLeftJoin = [this](const std::string& right,
+                              const std::string& probeProp,
+                              std::vector<std::string> rightColNames,
+                              const DataSet& expected) {
+        std::vector<std::string> colNames = {"col1"};
+        colNames.insert(colNames.end(), rightColNames.begin(), rightColNames.end());
+        auto* join = LeftJoin::make(qctx_.get(),
+                                    nullptr,
+                                    {"var3", 0},
+                                    {right, 0},
+                                    {VariablePropertyExpression::make(pool_, "var3", "col1")},
+                                    {VariablePropertyExpression::make(pool_, right, probeProp)});
+        join->setColNames(colNames);
+        auto joinExe = std::make_unique<LeftJoinExecutor>(join, qctx_.get());
+        EXPECT_TRUE(joinExe->execute().get().ok());
+        auto& result = qctx_->ectx()->getResult(join->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        EXPECT_EQ(result.value().getDataSet(), expected);
+    };
+
+    {
+        // $var3 left join $var2 on $var3.col1 = $var2.src
+        DataSet expected({"col1", "src", "dst"});
+        expected.emplace_back(Row({"11", "11", "0"}));
+        runLeftJoin("var2", "src", {"src", "dst"}, expected);
+    }
+    {
+        // $var3 left join $var1 on $var3.col1 = $var1._vid
+        DataSet expected({"col1", kVid, "tag_prop", "edge_prop", kDst});
+        expected.emplace_back(
+            Row({"11", Value::kEmpty, Value::kEmpty, Value::kEmpty, Value::kEmpty}));
+        runLeftJoin("var1", kVid, {kVid, "tag_prop", "edge_prop", kDst}, expected);
+    }
+}
+
+TEST_F(JoinTest, ParallelJoin) {
+    DataSet lhs({"k", "a"});
+    for (int64_t i = 0; i < 3000; ++i) {
+        lhs.emplace_back(Row({i % 500, i}));
+    }
+    DataSet rhs({"k2", "b"});
+    for (int64_t i = 0; i < 1000; ++i) {
+        rhs.emplace_back(Row({i % 700, i}));
+    }
+    qctx_->symTable()->newVariable("big_lhs");
+    qctx_->ectx()->setResult("big_lhs", ResultBuilder().value(Value(lhs)).finish());
+    qctx_->symTable()->newVariable("big_rhs");
+    qctx_->ectx()->setResult("big_rhs", ResultBuilder().value(Value(rhs)).finish());
+
+    // The rows are in the order of the lhs, then in the order of the rhs
+    DataSet innerExpected({"k", "a", "k2", "b"});
+    DataSet leftExpected({"k", "a", "k2", "b"});
+    for (auto& lRow : lhs.rows) {
+        bool matched = false;
+        for (auto& rRow : rhs.rows) {
+            if (lRow[0] == rRow[0]) {
+                matched = true;
+                innerExpected.emplace_back(Row({lRow[0], lRow[1], rRow[0], rRow[1]}));
+                leftExpected.emplace_back(Row({lRow[0], lRow[1], rRow[0], rRow[1]}));
+            }
+        }
+        if (!matched) {
+            leftExpected.emplace_back(Row({lRow[0], lRow[1], Value::kEmpty, Value::kEmpty}));
+        }
+    }
+    // The hash table is built on the smaller lhs
+    DataSet smallerLhsExpected({"k2", "b", "k", "a"});
+    for (auto& lRow : rhs.rows) {
+        bool matched = false;
+        for (auto& rRow : lhs.rows) {
+            if (lRow[0] == rRow[0]) {
+                matched = true;
+                smallerLhsExpected.emplace_back(Row({lRow[0], lRow[1], rRow[0], rRow[1]}));
+            }
+        }
+        if (!matched) {
+            smallerLhsExpected.emplace_back(
+                Row({lRow[0], lRow[1], Value::kEmpty, Value::kEmpty}));
+        }
+    }
+
+    gflags::FlagSaver saver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 100;
+
+    {
+        // The single key
+        auto* join = InnerJoin::make(qctx_.get(),
+                                     nullptr,
+                                     {"big_lhs", 0},
+                                     {"big_rhs", 0},
+                                     {VariablePropertyExpression::make(pool_, "big_lhs", "k")},
+                                     {VariablePropertyExpression::make(pool_, "big_rhs", "k2")});
+        join->setColNames({"k", "a", "k2", "b"});
+        auto joinExe = std::make_unique<InnerJoinExecutor>(join, qctx_.get());
+        EXPECT_TRUE(joinExe->execute().get().ok());
+        auto& result = qctx_->ectx()->getResult(join->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        EXPECT_EQ(result.value().getDataSet(), innerExpected);
+    }
+    {
+        // The multiple keys
+        auto* join = LeftJoin::make(qctx_.get(),
+                                    nullptr,
+                                    {"big_lhs", 0},
+                                    {"big_rhs", 0},
+                                    {VariablePropertyExpression::make(pool_, "big_lhs", "k"),
+                                     VariablePropertyExpression::make(pool_, "big_lhs", "k")},
+                                    {VariablePropertyExpression::make(pool_, "big_rhs", "k2"),
+                                     VariablePropertyExpression::make(pool_, "big_rhs", "k2")});
+        join->setColNames({"k", "a", "k2", "b"});
+        auto joinExe = std::make_unique<LeftJoinExecutor>(join, qctx_.get());
+        EXPECT_TRUE(joinExe->execute().get().ok());
+        auto& result = qctx_->ectx()->getResult(join->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        EXPECT_EQ(result.value().getDataSet(), leftExpected);
+    }
+    {
+        auto* join = LeftJoin::make(qctx_.get(),
+                                    nullptr,
+                                    {"big_rhs", 0},
+                                    {"big_lhs", 0},
+                                    {VariablePropertyExpression::make(pool_, "big_rhs", "k2")},
+                                    {VariablePropertyExpression::make(pool_, "big_lhs", "k")});
+        join->setColNames({"k2", "b", "k", "a"});
+        auto joinExe = std::make_unique<LeftJoinExecutor>(join, qctx_.get());
+        EXPECT_TRUE(joinExe->execute().get().ok());
+        auto& result = qctx_->ectx()->getResult(join->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        EXPECT_EQ(result.value().getDataSet(), smallerLhsExpected);
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -0,0 +1,162 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "context/QueryContext.h"
+#include "executor/query/PipelineExecutor.h"
+#include "executor/test/QueryTestBase.h"
+#include "planner/plan/Logic.h"
+#include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
+#include "util/ExpressionUtils.h"
+
+DECLARE_bool(enable_lifetime_optimize);
+
+namespace nebula {
+namespace graph {
+
+class PipelineTest : public QueryTestBase {
+public:
+    void SetUp() override {
+        QueryTestBase::SetUp();
+        lifetimeOptimize_ = FLAGS_enable_lifetime_optimize;
+        pipelineExecution_ = FLAGS_enable_pipeline_execution;
+        FLAGS_enable_lifetime_optimize = true;
+        FLAGS_enable_pipeline_execution = true;
+    }
+
+    void TearDown() override {
+        FLAGS_enable_lifetime_optimize = lifetimeOptimize_;
+        FLAGS_enable_pipeline_execution = pipelineExecution_;
+    }
+
+protected:
+    // The variables are analyzed as the scheduler does
+    void setUserCount(const PlanNode* node, uint64_t count) {
+        node->outputVarPtr()->userCount.store(count, std::memory_order_relaxed);
+    }
+
+    void setUserCount(const std::string& var) {
+        qctx_->symTable()->getVar(var)->userCount.store(std::numeric_limits<uint64_t>::max(),
+                                                        std::memory_order_relaxed);
+    }
+
+    Expression* getFilter(const std::string& sentence) {
+        auto* filter = getYieldFilter(sentence, qctx_.get());
+        return ExpressionUtils::rewriteLabelAttr2EdgeProp(filter);
+    }
+
+private:
+    bool lifetimeOptimize_{false};
+    bool pipelineExecution_{false};
+};
+
+TEST_F(PipelineTest, FilterProjectFilterLimit) {
+    auto* cond1 = getFilter("YIELD $-.v_age AS age WHERE $-.v_age > 18");
+    auto* cond2 = getFilter("YIELD $-.start AS start WHERE $-.start < 2010");
+    auto* yield = getYieldSentence("YIELD $-.v_name AS name, $-.e_start_year AS start",
+                                   qctx_.get());
+
+    auto* start = StartNode::make(qctx_.get());
+    auto* filter1 = Filter::make(qctx_.get(), start, cond1);
+    filter1->setInputVar("input_sequential");
+    auto* project = Project::make(qctx_.get(), filter1, yield->yieldColumns());
+    project->setInputVar(filter1->outputVar());
+    project->setColNames({"name", "start"});
+    auto* filter2 = Filter::make(qctx_.get(), project, cond2);
+    filter2->setInputVar(project->outputVar());
+    filter2->setColNames({"name", "start"});
+    auto* limit = Limit::make(qctx_.get(), filter2, 1, 5);
+    limit->setInputVar(filter2->outputVar());
+    limit->setColNames({"name", "start"});
+
+    setUserCount("input_sequential");
+    setUserCount(filter1, 1);
+    setUserCount(project, 1);
+    setUserCount(filter2, 1);
+    setUserCount(limit, std::numeric_limits<uint64_t>::max());
+
+    auto* exec = Executor::create(limit, qctx_.get());
+    auto* pipeline = dynamic_cast<PipelineExecutor*>(exec);
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_EQ(pipeline->chain().size(), 4);
+    EXPECT_EQ(pipeline->depends().size(), 1);
+
+    EXPECT_TRUE(exec->execute().get().ok());
+    auto& result = qctx_->ectx()->getResult(limit->outputVar());
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+    DataSet expected({"name", "start"});
+    expected.emplace_back(Row({"Kate", 2009}));
+    expected.emplace_back(Row({"Lily", 2009}));
+    EXPECT_EQ(result.value().getDataSet(), expected);
+}
+
+TEST_F(PipelineTest, GetNeighbors) {
+    auto* cond = getFilter("YIELD $^.person.name AS name WHERE study.start_year >= 2010");
+    auto* yield = getYieldSentence("YIELD $^.person.name AS name", qctx_.get());
+    for (auto* col : yield->columns()) {
+        col->setExpr(ExpressionUtils::rewriteLabelAttr2EdgeProp(col->expr()));
+    }
+
+    auto* start = StartNode::make(qctx_.get());
+    auto* filter = Filter::make(qctx_.get(), start, cond);
+    filter->setInputVar("input_neighbor");
+    auto* project = Project::make(qctx_.get(), filter, yield->yieldColumns());
+    project->setInputVar(filter->outputVar());
+    project->setColNames({"name"});
+
+    setUserCount("input_neighbor");
+    setUserCount(filter, 1);
+    setUserCount(project, std::numeric_limits<uint64_t>::max());
+
+    auto* exec = Executor::create(project, qctx_.get());
+    ASSERT_NE(dynamic_cast<PipelineExecutor*>(exec), nullptr);
+    EXPECT_TRUE(exec->execute().get().ok());
+    DataSet expected({"name"});
+    expected.emplace_back(Row({"Ann"}));
+    expected.emplace_back(Row({"Ann"}));
+    expected.emplace_back(Row({"Tom"}));
+    EXPECT_EQ(qctx_->ectx()->getResult(project->outputVar()).value().getDataSet(), expected);
+}
+
+TEST_F(PipelineTest, NotFusible) {
+    auto* cond = getFilter("YIELD $-.v_age AS age WHERE $-.v_age > 18");
+    auto* yield = getYieldSentence("YIELD $-.v_name AS name", qctx_.get());
+
+    auto* start = StartNode::make(qctx_.get());
+    auto* project = Project::make(qctx_.get(), start, yield->yieldColumns());
+    project->setInputVar("input_sequential");
+    project->setColNames({"name"});
+    auto* limit = Limit::make(qctx_.get(), project, 0, 1);
+    limit->setInputVar(project->outputVar());
+    auto* filter = Filter::make(qctx_.get(), limit, cond);
+    filter->setInputVar(limit->outputVar());
+
+    // The output of project is used by others
+    setUserCount(project, 2);
+    setUserCount(limit, 1);
+    EXPECT_EQ(dynamic_cast<PipelineExecutor*>(Executor::create(filter, qctx_.get())), nullptr);
+    EXPECT_TRUE(PipelineExecutor::fusibleChain(filter).empty());
+
+    // Limit before the first project is not supported
+    setUserCount(project, 1);
+    auto chain = PipelineExecutor::fusibleChain(filter);
+    ASSERT_EQ(chain.size(), 3);
+    EXPECT_EQ(chain.front(), project);
+
+    auto* limit2 = Limit::make(qctx_.get(), start, 0, 1);
+    limit2->setInputVar("input_sequential");
+    project->setDep(0, limit2);
+    project->setInputVar(limit2->outputVar());
+    setUserCount(limit2, 1);
+    chain = PipelineExecutor::fusibleChain(filter);
+    ASSERT_EQ(chain.size(), 3);
+    EXPECT_EQ(chain.front(), project);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -29,6 +29,29 @@ protected:
         return false;
     }
 
+    // Build the paths of the last version of the prefix trees, by the dst
+    DataSet buildPaths(const std::string& var) {
+        const auto& hist = qctx_->ectx()->getHistory(var);
+        auto version = hist.size() - 1;
+        DataSet ds;
+        ds.colNames = {kDst, "_paths"};
+        std::unordered_map<Value, size_t> dsts;
+        const auto& nodes = hist.back().value().getDataSet().rows;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const auto& dst = nodes[i].values[ProduceAllPathsExecutor::kVidCol];
+            auto found = dsts.find(dst);
+            if (found == dsts.end()) {
+                found = dsts.emplace(dst, ds.rows.size()).first;
+                Row row;
+                row.values = {dst, List()};
+                ds.rows.emplace_back(std::move(row));
+            }
+            ds.rows[found->second].values[1].mutableList().values.emplace_back(
+                ProduceAllPathsExecutor::buildPath(hist, version, i));
+        }
+        return ds;
+    }
+
     static ::testing::AssertionResult verifyAllPaths(DataSet& result, DataSet& expected) {
         std::sort(expected.rows.begin(), expected.rows.end(), compareAllPathRow);
         for (auto& row : expected.rows) {
@@ -231,7 +254,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
 
     auto* allPathsNode = ProduceAllPaths::make(qctx_.get(), nullptr);
     allPathsNode->setInputVar("input");
-    allPathsNode->setColNames({kDst, "_paths"});
+    allPathsNode->setColNames({kVid, kEdgeStr, kParentStr});
 
     auto allPathsExe = std::make_unique<ProduceAllPathsExecutor>(allPathsNode, qctx_.get());
 
@@ -312,7 +335,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
             expected.rows.emplace_back(std::move(row));
         }
 
-        auto resultDs = result.value().getDataSet();
+        auto resultDs = buildPaths(allPathsNode->outputVar());
         EXPECT_TRUE(verifyAllPaths(resultDs, expected));
         EXPECT_EQ(result.state(), Result::State::kSuccess);
     }
@@ -401,7 +424,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
             expected.rows.emplace_back(std::move(row));
         }
 
-        auto resultDs = result.value().getDataSet();
+        auto resultDs = buildPaths(allPathsNode->outputVar());
         EXPECT_TRUE(verifyAllPaths(resultDs, expected));
         EXPECT_EQ(result.state(), Result::State::kSuccess);
     }
@@ -446,7 +469,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
             expected.rows.emplace_back(std::move(row));
         }
 
-        auto resultDs = result.value().getDataSet();
+        auto resultDs = buildPaths(allPathsNode->outputVar());
         EXPECT_TRUE(verifyAllPaths(resultDs, expected));
         EXPECT_EQ(result.state(), Result::State::kSuccess);
     }
@@ -455,7 +478,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
 TEST_F(ProduceAllPathsTest, EmptyInput) {
     auto* allPathsNode = ProduceAllPaths::make(qctx_.get(), nullptr);
     allPathsNode->setInputVar("empty_get_neighbors");
-    allPathsNode->setColNames({kDst, "_paths"});
+    allPathsNode->setColNames({kVid, kEdgeStr, kParentStr});
 
     auto allPathsExe = std::make_unique<ProduceAllPathsExecutor>(allPathsNode, qctx_.get());
     auto future = allPathsExe->execute();
@@ -464,7 +487,7 @@ TEST_F(ProduceAllPathsTest, EmptyInput) {
     auto& result = qctx_->ectx()->getResult(allPathsNode->outputVar());
 
     DataSet expected;
-    expected.colNames = {"_dst", "_paths"};
+    expected.colNames = {kVid, kEdgeStr, kParentStr};
     EXPECT_EQ(result.value().getDataSet(), expected);
     EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
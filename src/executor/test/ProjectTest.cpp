@@ -11,6 +11,7 @@
 #include "executor/test/QueryTestBase.h"
 #include "planner/plan/Logic.h"
 #include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -120,5 +121,74 @@ TEST_F(ProjectTest, EmptyInput) {
     EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
 
+TEST_F(ProjectTest, ProjectBatchEval) {
+    std::string input = "input_project";
+    auto yieldColumns = getYieldColumns(
+        "YIELD $input_project.vid AS vid, $input_project.col2 * 2 AS col2, "
+        "$input_project.vid + 0.5 AS col3, $input_project.vid >= 5 AS col4",
+        qctx_.get());
+    auto* project = Project::make(qctx_.get(), start_, yieldColumns);
+    project->setInputVar(input);
+    project->setColNames(std::vector<std::string>{"vid", "col2", "col3", "col4"});
+
+    auto proExe = Executor::create(project, qctx_.get());
+    auto status = proExe->execute().get();
+    EXPECT_TRUE(status.ok());
+    auto& result = qctx_->ectx()->getResult(project->outputVar());
+
+    DataSet expected;
+    expected.colNames = {"vid", "col2", "col3", "col4"};
+    for (auto i = 0; i < 10; ++i) {
+        Row row;
+        row.values.emplace_back(i);
+        row.values.emplace_back((i + 1) * 2);
+        row.values.emplace_back(i + 0.5);
+        row.values.emplace_back(i >= 5);
+        expected.rows.emplace_back(std::move(row));
+    }
+    EXPECT_EQ(result.value().getDataSet(), expected);
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+}
+
+TEST_F(ProjectTest, ProjectInParallel) {
+    DataSet ds;
+    ds.colNames = {"vid", "col2"};
+    for (auto i = 0; i < 1000; ++i) {
+        Row row;
+        row.values.emplace_back(i);
+        row.values.emplace_back(i % 3 == 0 ? Value::kNullValue : Value(i + 1));
+        ds.rows.emplace_back(std::move(row));
+    }
+    qctx_->symTable()->newVariable("input_parallel");
+    qctx_->ectx()->setResult("input_parallel", ResultBuilder().value(Value(ds)).finish());
+
+    auto runProject = [this]() {
+        auto yieldColumns = getYieldColumns(
+            "YIELD $input_parallel.vid AS vid, $input_parallel.col2 * 2 AS col2, "
+            "abs($input_parallel.vid - 500) AS col3",
+            qctx_.get());
+        auto* project = Project::make(qctx_.get(), start_, yieldColumns);
+        project->setInputVar("input_parallel");
+        project->setColNames(std::vector<std::string>{"vid", "col2", "col3"});
+        auto proExe = Executor::create(project, qctx_.get());
+        EXPECT_TRUE(proExe->execute().get().ok());
+        auto& result = qctx_->ectx()->getResult(project->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        return result.value().getDataSet();
+    };
+
+    gflags::FlagSaver saver;
+    for (auto batch : {true, false}) {
+        FLAGS_enable_batch_eval = batch;
+        FLAGS_max_job_size = 1;
+        auto serial = runProject();
+        EXPECT_EQ(serial.rows.size(), 1000u);
+        FLAGS_max_job_size = 4;
+        FLAGS_min_batch_size = 100;
+        auto parallel = runProject();
+        EXPECT_EQ(parallel, serial);
+    }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -51,6 +51,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
                      "Host",
                      "StartTime",
                      "DurationInUSec",
+                     "PeakMemoryInBytes",
                      "Status",
                      "Query"});
     DataSet expected = dataSet;
@@ -65,6 +66,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
         dateTime.microsec = 123;
         row.emplace_back(std::move(dateTime));
         row.emplace_back(100);
+        row.emplace_back(Value::kNullValue);
         row.emplace_back("RUNNING");
         row.emplace_back("");
         expected.rows.emplace_back(std::move(row));
@@ -80,6 +82,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
         dateTime.microsec = 123;
         row.emplace_back(std::move(dateTime));
         row.emplace_back(200);
+        row.emplace_back(Value::kNullValue);
         row.emplace_back("RUNNING");
         row.emplace_back("");
         expected.rows.emplace_back(std::move(row));
@@ -12,6 +12,7 @@
 #include "executor/test/QueryTestBase.h"
 #include "planner/plan/Logic.h"
 #include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -131,5 +132,35 @@ TEST_F(SortTest, sortTwoColDesDes_union) {
     factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
     SORT_RESUTL_CHECK("union_sequential", "union_sort_two_cols_des_des", true, factors, expected);
 }
+
+TEST_F(SortTest, sortParallel) {
+    DataSet ds({"a", "b"});
+    for (int64_t i = 0; i < 10000; ++i) {
+        ds.emplace_back(Row({(i * 7919) % 1000, i}));
+    }
+    // a ASC, b DESC
+    auto expected = ds;
+    std::sort(expected.rows.begin(), expected.rows.end(), [](const Row& lhs, const Row& rhs) {
+        return lhs[0] != rhs[0] ? lhs[0] < rhs[0] : lhs[1] > rhs[1];
+    });
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+    factors.emplace_back(std::make_pair(0, OrderFactor::OrderType::ASCEND));
+    factors.emplace_back(std::make_pair(1, OrderFactor::OrderType::DESCEND));
+
+    gflags::FlagSaver saver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 1000;
+
+    qctx_->symTable()->newVariable("input_parallel_sort");
+    qctx_->ectx()->setResult("input_parallel_sort", ResultBuilder().value(Value(ds)).finish());
+    auto start = StartNode::make(qctx_.get());
+    auto* sortNode = Sort::make(qctx_.get(), start, factors);
+    sortNode->setInputVar("input_parallel_sort");
+    auto sortExec = Executor::create(sortNode, qctx_.get());
+    EXPECT_TRUE(sortExec->execute().get().ok());
+    auto& sortResult = qctx_->ectx()->getResult(sortNode->outputVar());
+    EXPECT_EQ(sortResult.state(), Result::State::kSuccess);
+    EXPECT_EQ(sortResult.value().getDataSet(), expected);
+}
 }   // namespace graph
 }   // namespace nebula
@@ -12,6 +12,7 @@
 #include "executor/test/QueryTestBase.h"
 #include "planner/plan/Logic.h"
 #include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -113,5 +114,46 @@ TEST_F(TopNTest, topnTwoColDesAsc) {
     factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::ASCEND));
     TOPN_RESUTL_CHECK("input_sequential", "topn_two_cols_des_asc", true, factors, 1, 9, expected);
 }
+
+TEST_F(TopNTest, topnParallel) {
+    DataSet ds({"a", "b"});
+    for (int64_t i = 0; i < 10000; ++i) {
+        ds.emplace_back(Row({(i * 7919) % 1000, i}));
+    }
+    // a ASC, b DESC
+    auto expected = ds;
+    std::sort(expected.rows.begin(), expected.rows.end(), [](const Row& lhs, const Row& rhs) {
+        return lhs[0] != rhs[0] ? lhs[0] < rhs[0] : lhs[1] > rhs[1];
+    });
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+    factors.emplace_back(std::make_pair(0, OrderFactor::OrderType::ASCEND));
+    factors.emplace_back(std::make_pair(1, OrderFactor::OrderType::DESCEND));
+
+    gflags::FlagSaver saver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 1000;
+
+    auto runTopN = [&](int64_t offset, int64_t count) {
+        auto input = folly::to<std::string>("input_parallel_topn_", offset, "_", count);
+        qctx_->symTable()->newVariable(input);
+        qctx_->ectx()->setResult(input, ResultBuilder().value(Value(ds)).finish());
+        auto start = StartNode::make(qctx_.get());
+        auto* topnNode = TopN::make(qctx_.get(), start, factors, offset, count);
+        topnNode->setInputVar(input);
+        auto topnExec = Executor::create(topnNode, qctx_.get());
+        EXPECT_TRUE(topnExec->execute().get().ok());
+        auto& topnResult = qctx_->ectx()->getResult(topnNode->outputVar());
+        EXPECT_EQ(topnResult.state(), Result::State::kSuccess);
+
+        DataSet expectedTopN({"a", "b"});
+        for (auto i = offset; i < std::min<int64_t>(offset + count, expected.rows.size()); ++i) {
+            expectedTopN.emplace_back(Row(expected.rows[i]));
+        }
+        EXPECT_EQ(topnResult.value().getDataSet(), expectedTopN);
+    };
+    runTopN(0, 10);
+    runTopN(100, 3000);
+    runTopN(9990, 100);
+}
 }   // namespace graph
 }   // namespace nebula
@@ -11,6 +11,7 @@
 #include "executor/test/QueryTestBase.h"
 #include "planner/plan/Logic.h"
 #include "planner/plan/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -66,5 +67,46 @@ TEST_F(UnwindTest, UnwindList) {
     TEST_UNWIND(testSuite["case2"]);
 }
 
+TEST_F(UnwindTest, UnwindInParallel) {
+    DataSet ds;
+    ds.colNames = {"id", "items"};
+    for (auto i = 0; i < 1000; ++i) {
+        Row row;
+        row.values.emplace_back(i);
+        // Some rows unwind to nothing, the others to 1 or 2 rows
+        if (i % 4 == 0) {
+            row.values.emplace_back(Value::kNullValue);
+        } else if (i % 4 == 1) {
+            row.values.emplace_back(i);
+        } else {
+            row.values.emplace_back(List({i, i + 1}));
+        }
+        ds.rows.emplace_back(std::move(row));
+    }
+    qctx_->symTable()->newVariable("input_parallel");
+    qctx_->ectx()->setResult("input_parallel", ResultBuilder().value(Value(ds)).finish());
+
+    auto runUnwind = [this]() {
+        auto* unwind = Unwind::make(
+            qctx_.get(), start_, InputPropertyExpression::make(pool_, "items"), "item");
+        unwind->setInputVar("input_parallel");
+        unwind->setColNames(std::vector<std::string>{"id", "items", "item"});
+        auto unwExe = Executor::create(unwind, qctx_.get());
+        EXPECT_TRUE(unwExe->execute().get().ok());
+        auto& result = qctx_->ectx()->getResult(unwind->outputVar());
+        EXPECT_EQ(result.state(), Result::State::kSuccess);
+        return result.value().getDataSet();
+    };
+
+    gflags::FlagSaver saver;
+    FLAGS_max_job_size = 1;
+    auto serial = runUnwind();
+    EXPECT_EQ(serial.rows.size(), 1250u);
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 100;
+    auto parallel = runUnwind();
+    EXPECT_EQ(parallel, serial);
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -0,0 +1,286 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "optimizer/CostModel.h"
+
+#include <cmath>
+
+#include "common/base/ObjectPool.h"
+#include "common/meta/SchemaManager.h"
+#include "context/QueryContext.h"
+#include "planner/plan/PlanNode.h"
+#include "planner/plan/Query.h"
+#include "util/Statistics.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::Expand;
+using nebula::graph::Explore;
+using nebula::graph::Filter;
+using nebula::graph::GetNeighbors;
+using nebula::graph::IndexScan;
+using nebula::graph::Limit;
+using nebula::graph::PlanNode;
+using nebula::graph::SpaceStats;
+using nebula::graph::Statistics;
+using nebula::graph::TopN;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+double decodedSelectivity(const std::string& filter) {
+    if (filter.empty()) {
+        return 1.0;
+    }
+    ObjectPool pool;
+    return Statistics::selectivity(Expression::decode(&pool, filter));
+}
+
+double sortCost(double rows) {
+    return rows * std::log2(std::max(rows, 2.0));
+}
+
+}   // namespace
+
+CostModel::CostModel(graph::QueryContext* qctx) : qctx_(qctx) {}
+
+Estimate CostModel::estimate(const PlanNode* node,
+                             const std::vector<Estimate>& deps,
+                             const std::vector<Estimate>& bodies) const {
+    double inputRows = deps.empty() ? 1.0 : deps.front().rows;
+    double inputCost = 0.0;
+    for (auto& dep : deps) {
+        inputCost += dep.cost;
+    }
+
+    Estimate est;
+    est.rows = inputRows;
+    double cost = inputRows;
+    switch (node->kind()) {
+        case PlanNode::Kind::kStart: {
+            est.rows = 1.0;
+            cost = 0.0;
+            break;
+        }
+        case PlanNode::Kind::kGetNeighbors:
+        case PlanNode::Kind::kGetVertices:
+        case PlanNode::Kind::kGetEdges:
+        case PlanNode::Kind::kIndexScan:
+        case PlanNode::Kind::kTagIndexFullScan:
+        case PlanNode::Kind::kTagIndexPrefixScan:
+        case PlanNode::Kind::kTagIndexRangeScan:
+        case PlanNode::Kind::kEdgeIndexFullScan:
+        case PlanNode::Kind::kEdgeIndexPrefixScan:
+        case PlanNode::Kind::kEdgeIndexRangeScan: {
+            auto storage = estimateStorage(node, inputRows);
+            est.rows = storage.rows;
+            cost = storage.cost;
+            break;
+        }
+        case PlanNode::Kind::kExpand: {
+            // The dedup of each step is not estimated, as the GetNeighbors in a loop
+            auto expand = static_cast<const Expand*>(node);
+            auto d = degree(expand->space(), {});
+            cost = 0.0;
+            for (uint32_t i = 0; i < expand->steps(); ++i) {
+                est.rows *= d;
+                cost += kRpcCost + est.rows * kStorageRowCost;
+            }
+            break;
+        }
+        case PlanNode::Kind::kFilter: {
+            auto filter = static_cast<const Filter*>(node);
+            est.rows = inputRows * Statistics::selectivity(filter->condition());
+            break;
+        }
+        case PlanNode::Kind::kLimit: {
+            auto limit = static_cast<const Limit*>(node);
+            est.rows = std::min(inputRows, static_cast<double>(limit->offset() + limit->count()));
+            cost = est.rows;
+            break;
+        }
+        case PlanNode::Kind::kTopN: {
+            auto topN = static_cast<const TopN*>(node);
+            est.rows = std::min(inputRows, static_cast<double>(topN->offset() + topN->count()));
+            cost = inputRows * std::log2(std::max(est.rows, 2.0));
+            break;
+        }
+        case PlanNode::Kind::kSort: {
+            cost = sortCost(inputRows);
+            break;
+        }
+        case PlanNode::Kind::kDedup: {
+            cost = inputRows * kHashRowCost;
+            break;
+        }
+        case PlanNode::Kind::kAggregate: {
+            auto agg = static_cast<const Aggregate*>(node);
+            est.rows = agg->groupKeys().empty()
+                           ? 1.0
+                           : std::max(1.0, inputRows * Statistics::kEqualSelectivity);
+            cost = inputRows * kHashRowCost;
+            break;
+        }
+        case PlanNode::Kind::kInnerJoin:
+        case PlanNode::Kind::kLeftJoin: {
+            DCHECK_EQ(deps.size(), 2u);
+            auto left = deps[0].rows;
+            auto right = deps[1].rows;
+            // Assume the joins are from the foreign keys, i.e. the vids
+            est.rows = node->kind() == PlanNode::Kind::kLeftJoin ? left : std::max(left, right);
+            // The hash table is built on the smaller input
+            cost = std::min(left, right) * kHashBuildRowCost + std::max(left, right) * kHashRowCost;
+            break;
+        }
+        case PlanNode::Kind::kCartesianProduct: {
+            est.rows = 1.0;
+            for (auto& dep : deps) {
+                est.rows *= dep.rows;
+            }
+            cost = est.rows;
+            break;
+        }
+        case PlanNode::Kind::kUnion: {
+            est.rows = 0.0;
+            for (auto& dep : deps) {
+                est.rows += dep.rows;
+            }
+            cost = est.rows;
+            break;
+        }
+        case PlanNode::Kind::kIntersect:
+        case PlanNode::Kind::kMinus: {
+            DCHECK_EQ(deps.size(), 2u);
+            est.rows = node->kind() == PlanNode::Kind::kIntersect
+                           ? std::min(deps[0].rows, deps[1].rows)
+                           : deps[0].rows;
+            cost = (deps[0].rows + deps[1].rows) * kHashRowCost;
+            break;
+        }
+        case PlanNode::Kind::kLoop: {
+            if (bodies.empty()) {
+                break;
+            }
+            est.rows = bodies[0].rows * kLoopIterations;
+            cost = bodies[0].cost * kLoopIterations;
+            break;
+        }
+        case PlanNode::Kind::kSelect: {
+            // Either branch may run
+            est.rows = 0.0;
+            cost = 0.0;
+            for (auto& body : bodies) {
+                est.rows = std::max(est.rows, body.rows);
+                cost = std::max(cost, body.cost);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    est.rows = std::max(est.rows, 0.0);
+    est.cost = inputCost + cost;
+    return est;
+}
+
+Estimate CostModel::estimateStorage(const PlanNode* node, double inputRows) const {
+    auto explore = static_cast<const Explore*>(node);
+    Estimate est;
+    switch (node->kind()) {
+        case PlanNode::Kind::kGetNeighbors: {
+            auto gn = static_cast<const GetNeighbors*>(node);
+            est.rows = inputRows * degree(gn->space(), gn->edgeTypes()) *
+                       decodedSelectivity(gn->filter());
+            est.cost = kRpcCost + (inputRows + est.rows) * kStorageRowCost;
+            break;
+        }
+        case PlanNode::Kind::kGetVertices:
+        case PlanNode::Kind::kGetEdges: {
+            est.rows = inputRows * decodedSelectivity(explore->filter());
+            est.cost = kRpcCost + inputRows * kStorageRowCost;
+            break;
+        }
+        default: {
+            auto scan = static_cast<const IndexScan*>(node);
+            auto schemaRows = this->schemaRows(scan->space(), scan->schemaId(), scan->isEdge());
+            // The index query contexts are unioned
+            double sel = 0.0;
+            for (auto& ictx : scan->queryContext()) {
+                double s = decodedSelectivity(ictx.get_filter());
+                for (auto& hint : ictx.get_column_hints()) {
+                    s *= hint.get_scan_type() == storage::cpp2::ScanType::PREFIX
+                             ? Statistics::kEqualSelectivity
+                             : Statistics::kRangeSelectivity;
+                }
+                sel += s;
+            }
+            if (scan->queryContext().empty()) {
+                sel = 1.0;
+            }
+            est.rows = schemaRows * std::min(sel, 1.0);
+            est.cost = kRpcCost * std::max<size_t>(scan->queryContext().size(), 1) +
+                       est.rows * kStorageRowCost;
+            break;
+        }
+    }
+    if (explore->limit() >= 0) {
+        est.rows = std::min(est.rows, static_cast<double>(explore->limit()));
+    }
+    return est;
+}
+
+double CostModel::schemaRows(GraphSpaceID space, int32_t schemaId, bool isEdge) const {
+    auto spaceStats = stats(space);
+    if (spaceStats == nullptr) {
+        return isEdge ? Statistics::kDefaultVertices * Statistics::kDefaultDegree
+                      : Statistics::kDefaultVertices;
+    }
+    auto schemaMng = qctx_->schemaMng();
+    if (schemaMng != nullptr) {
+        auto name = isEdge ? schemaMng->toEdgeName(space, schemaId)
+                           : schemaMng->toTagName(space, schemaId);
+        if (name.ok()) {
+            auto rows = isEdge ? spaceStats->numEdges(name.value())
+                               : spaceStats->numVertices(name.value());
+            if (rows >= 0) {
+                return rows;
+            }
+        }
+    }
+    return isEdge ? spaceStats->edges : spaceStats->vertices;
+}
+
+double CostModel::degree(GraphSpaceID space, const std::vector<int32_t>& edgeTypes) const {
+    auto spaceStats = stats(space);
+    if (edgeTypes.empty() || spaceStats == nullptr) {
+        return Statistics::degree(spaceStats, "");
+    }
+    auto schemaMng = qctx_->schemaMng();
+    double degree = 0.0;
+    for (auto type : edgeTypes) {
+        std::string name;
+        if (schemaMng != nullptr) {
+            auto result = schemaMng->toEdgeName(space, std::abs(type));
+            if (result.ok()) {
+                name = std::move(result).value();
+            }
+        }
+        degree += Statistics::degree(spaceStats, name);
+    }
+    return degree;
+}
+
+const SpaceStats* CostModel::stats(GraphSpaceID space) const {
+    auto iter = stats_.find(space);
+    if (iter == stats_.end()) {
+        iter = stats_.emplace(space, Statistics::spaceStats(qctx_, space)).first;
+    }
+    return iter->second.get();
+}
+
+}   // namespace opt
+}   // namespace nebula
@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef OPTIMIZER_COSTMODEL_H_
+#define OPTIMIZER_COSTMODEL_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+namespace graph {
+class PlanNode;
+class QueryContext;
+struct SpaceStats;
+}   // namespace graph
+
+namespace opt {
+
+// The estimated output rows of a plan and the cost to produce them
+struct Estimate {
+    double  rows{1.0};
+    double  cost{0.0};
+};
+
+// Estimate the cardinality and cost of the plan nodes by the statistics of
+// the space, i.e. the vertex and edge counts per tag and edge type, and by the
+// default selectivities of the predicates.
+//
+// The cost is in the unit of handling a row in graphd, and the storage RPCs
+// weigh more than the rows processed locally.
+class CostModel final {
+public:
+    explicit CostModel(graph::QueryContext* qctx);
+
+    // Estimate `node' given the estimates of its dependencies and bodies.
+    // The cost of the dependencies and bodies is included.
+    Estimate estimate(const graph::PlanNode* node,
+                      const std::vector<Estimate>& deps,
+                      const std::vector<Estimate>& bodies = {}) const;
+
+    // The rows of the vertices with the tag, or of the edges with the edge type
+    double schemaRows(GraphSpaceID space, int32_t schemaId, bool isEdge) const;
+
+    static constexpr double kRpcCost = 100.0;
+    static constexpr double kStorageRowCost = 2.0;
+    static constexpr double kHashRowCost = 1.5;
+    static constexpr double kHashBuildRowCost = 3.0;
+    // The number of iterations assumed for a loop whose steps are unknown
+    static constexpr double kLoopIterations = 3.0;
+
+private:
+    Estimate estimateStorage(const graph::PlanNode* node, double inputRows) const;
+
+    double degree(GraphSpaceID space, const std::vector<int32_t>& edgeTypes) const;
+
+    // Return nullptr if the statistics of the space are not fetched yet
+    const graph::SpaceStats* stats(GraphSpaceID space) const;
+
+    graph::QueryContext*                                qctx_{nullptr};
+    // The statistics are kept for the plan to be estimated consistently
+    mutable std::unordered_map<GraphSpaceID,
+                               std::shared_ptr<const graph::SpaceStats>> stats_;
+};
+
+}   // namespace opt
+}   // namespace nebula
+
+#endif   // OPTIMIZER_COSTMODEL_H_
@@ -15,7 +15,9 @@ namespace nebula {
 namespace opt {
 
 OptContext::OptContext(graph::QueryContext *qctx)
-    : qctx_(DCHECK_NOTNULL(qctx)), objPool_(std::make_unique<ObjectPool>()) {}
+    : qctx_(DCHECK_NOTNULL(qctx)),
+      objPool_(std::make_unique<ObjectPool>()),
+      costModel_(std::make_unique<CostModel>(qctx)) {}
 
 void OptContext::addPlanNodeAndOptGroupNode(int64_t planNodeId, const OptGroupNode *optGroupNode) {
     auto pair = planNodeToOptGroupNodeMap_.emplace(planNodeId, optGroupNode);
@@ -11,6 +11,7 @@
 #include <unordered_map>
 
 #include "common/cpp/helpers.h"
+#include "optimizer/CostModel.h"
 
 namespace nebula {
 
@@ -44,6 +45,10 @@ public:
         changed_ = changed;
     }
 
+    const CostModel *costModel() const {
+        return costModel_.get();
+    }
+
     void addPlanNodeAndOptGroupNode(int64_t planNodeId, const OptGroupNode *optGroupNode);
     const OptGroupNode *findOptGroupNodeByPlanNodeId(int64_t planNodeId) const;
 
@@ -51,6 +56,7 @@ private:
     bool changed_{true};
     graph::QueryContext *qctx_{nullptr};
     std::unique_ptr<ObjectPool> objPool_;
+    std::unique_ptr<CostModel> costModel_;
     std::unordered_map<int64_t, const OptGroupNode *> planNodeToOptGroupNodeMap_;
 };
 
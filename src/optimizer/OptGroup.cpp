@@ -13,8 +13,10 @@
 #include "optimizer/OptRule.h"
 #include "planner/plan/Logic.h"
 #include "planner/plan/PlanNode.h"
+#include "planner/plan/Query.h"
 
 using nebula::graph::BinaryInputNode;
+using nebula::graph::Join;
 using nebula::graph::Loop;
 using nebula::graph::PlanNode;
 using nebula::graph::QueryContext;
@@ -45,10 +47,12 @@ OptGroup::OptGroup(OptContext *ctx) noexcept : ctx_(ctx) {
 void OptGroup::addGroupNode(OptGroupNode *groupNode) {
     DCHECK(groupNode != nullptr);
     DCHECK(groupNode->group() == this);
+    resetEstimate();
     groupNodes_.emplace_back(groupNode);
 }
 
 OptGroupNode *OptGroup::makeGroupNode(PlanNode *node) {
+    resetEstimate();
     groupNodes_.emplace_back(OptGroupNode::create(ctx_, node, this));
     return groupNodes_.back();
 }
@@ -80,6 +84,7 @@ Status OptGroup::explore(const OptRule *rule) {
         auto resStatus = rule->transform(ctx_, matched);
         NG_RETURN_IF_ERROR(resStatus);
         auto result = std::move(resStatus).value();
+        resetEstimate();
         if (result.eraseAll) {
             for (auto gnode : groupNodes_) {
                 gnode->node()->releaseSymbols();
@@ -122,23 +127,59 @@ Status OptGroup::exploreUntilMaxRound(const OptRule *rule) {
     return Status::OK();
 }
 
-std::pair<double, const OptGroupNode *> OptGroup::findMinCostGroupNode() const {
-    double minCost = std::numeric_limits<double>::max();
+std::pair<Estimate, const OptGroupNode *> OptGroup::findMinCostGroupNode() const {
+    if (minCostGroupNode_ != nullptr) {
+        return std::make_pair(minEstimate_, minCostGroupNode_);
+    }
+    Estimate minEstimate;
+    minEstimate.cost = std::numeric_limits<double>::max();
     const OptGroupNode *minGroupNode = nullptr;
     for (auto &groupNode : groupNodes_) {
-        double cost = groupNode->getCost();
-        if (minCost > cost) {
-            minCost = cost;
+        auto estimate = groupNode->estimate(ctx_->costModel());
+        if (minGroupNode == nullptr || minEstimate.cost > estimate.cost) {
+            minEstimate = estimate;
             minGroupNode = groupNode;
         }
     }
-    return std::make_pair(minCost, minGroupNode);
+    minCostGroupNode_ = minGroupNode;
+    minEstimate_ = minEstimate;
+    return std::make_pair(minEstimate, minGroupNode);
 }
 
-double OptGroup::getCost() const {
+Estimate OptGroup::estimate() const {
     return findMinCostGroupNode().first;
 }
 
+double OptGroup::getCost() const {
+    return estimate().cost;
+}
+
+const OptGroup *OptGroup::findProducer(const std::string &var) const {
+    std::unordered_set<const OptGroup *> visited;
+    return findProducer(var, &visited);
+}
+
+const OptGroup *OptGroup::findProducer(const std::string &var,
+                                       std::unordered_set<const OptGroup *> *visited) const {
+    if (!visited->emplace(this).second) {
+        return nullptr;
+    }
+    for (auto groupNode : groupNodes_) {
+        if (groupNode->node()->outputVar() == var) {
+            return this;
+        }
+    }
+    for (auto groupNode : groupNodes_) {
+        for (auto dep : groupNode->dependencies()) {
+            auto producer = dep->findProducer(var, visited);
+            if (producer != nullptr) {
+                return producer;
+            }
+        }
+    }
+    return nullptr;
+}
+
 const PlanNode *OptGroup::getPlan() const {
     const OptGroupNode *minGroupNode = findMinCostGroupNode().second;
     DCHECK(minGroupNode != nullptr);
@@ -188,8 +229,44 @@ Status OptGroupNode::explore(const OptRule *rule) {
     return Status::OK();
 }
 
-double OptGroupNode::getCost() const {
-    return node_->cost();
+Estimate OptGroupNode::estimate(const CostModel *model) const {
+    std::vector<Estimate> deps;
+    deps.reserve(dependencies_.size());
+    for (auto dep : dependencies_) {
+        deps.emplace_back(dep->estimate());
+    }
+    if (node_->kind() == PlanNode::Kind::kInnerJoin ||
+        node_->kind() == PlanNode::Kind::kLeftJoin) {
+        // The join reads both inputs from the variables but depends on one of them,
+        // so the rows are of the plans writing the variables, and the cost is of
+        // the dependencies.
+        auto join = static_cast<const Join *>(node_);
+        auto left = inputEstimate(join->leftVar().first);
+        auto right = inputEstimate(join->rightVar().first);
+        left.cost = 0.0;
+        for (auto &dep : deps) {
+            left.cost += dep.cost;
+        }
+        right.cost = 0.0;
+        deps = {left, right};
+    }
+    std::vector<Estimate> bodies;
+    bodies.reserve(bodies_.size());
+    for (auto body : bodies_) {
+        bodies.emplace_back(body->estimate());
+    }
+    return model->estimate(node_, deps, bodies);
+}
+
+Estimate OptGroupNode::inputEstimate(const std::string &var) const {
+    for (auto dep : dependencies_) {
+        auto producer = dep->findProducer(var);
+        if (producer != nullptr) {
+            return producer->estimate();
+        }
+    }
+    // Unknown, e.g. the input of the pipe
+    return Estimate();
 }
 
 const PlanNode *OptGroupNode::getPlan() const {
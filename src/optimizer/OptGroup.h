@@ -9,9 +9,12 @@
 
 #include <algorithm>
 #include <list>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "common/base/Status.h"
+#include "optimizer/CostModel.h"
 
 namespace nebula {
 namespace graph {
@@ -47,19 +50,35 @@ public:
 
     Status explore(const OptRule *rule);
     Status exploreUntilMaxRound(const OptRule *rule);
+    // The estimate of the cheapest group node, which is computed once the
+    // exploration is done
+    Estimate estimate() const;
     double getCost() const;
     const graph::PlanNode *getPlan() const;
 
+    // Find the group writing `var' in this group and its dependencies
+    const OptGroup *findProducer(const std::string &var) const;
+
 private:
     explicit OptGroup(OptContext *ctx) noexcept;
 
     static constexpr int16_t kMaxExplorationRound = 128;
 
-    std::pair<double, const OptGroupNode *> findMinCostGroupNode() const;
+    std::pair<Estimate, const OptGroupNode *> findMinCostGroupNode() const;
+
+    const OptGroup *findProducer(const std::string &var,
+                                 std::unordered_set<const OptGroup *> *visited) const;
+
+    void resetEstimate() {
+        minCostGroupNode_ = nullptr;
+    }
 
     OptContext *ctx_{nullptr};
     std::list<OptGroupNode *> groupNodes_;
     std::vector<const OptRule *> exploredRules_;
+    // Cached estimate of the cheapest group node
+    mutable const OptGroupNode *minCostGroupNode_{nullptr};
+    mutable Estimate minEstimate_;
 };
 
 class OptGroupNode final {
@@ -106,10 +125,14 @@ public:
     }
 
     Status explore(const OptRule *rule);
-    double getCost() const;
+    // Estimate the plan rooted at this group node with the cheapest dependencies
+    Estimate estimate(const CostModel *model) const;
     const graph::PlanNode *getPlan() const;
 
 private:
+    // The estimate of the input read from `var', which may not be a dependency
+    Estimate inputEstimate(const std::string &var) const;
+
     OptGroupNode(graph::PlanNode *node, const OptGroup *group) noexcept;
 
     graph::PlanNode *node_{nullptr};
@@ -36,6 +36,7 @@ StatusOr<const PlanNode *> Optimizer::findBestPlan(QueryContext *qctx) {
     auto rootGroup = std::move(status).value();
 
     NG_RETURN_IF_ERROR(doExploration(optCtx.get(), rootGroup));
+    qctx->plan()->setEstimatedCost(rootGroup->getCost());
     return rootGroup->getPlan();
 }
 
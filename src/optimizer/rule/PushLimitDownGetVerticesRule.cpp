@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "optimizer/rule/PushLimitDownGetVerticesRule.h"
+
+#include "optimizer/OptContext.h"
+#include "optimizer/OptGroup.h"
+#include "planner/plan/PlanNode.h"
+#include "planner/plan/Query.h"
+
+using nebula::graph::GetVertices;
+using nebula::graph::Limit;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::graph::QueryContext;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushLimitDownGetVerticesRule::kInstance =
+    std::unique_ptr<PushLimitDownGetVerticesRule>(new PushLimitDownGetVerticesRule());
+
+PushLimitDownGetVerticesRule::PushLimitDownGetVerticesRule() {
+    RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushLimitDownGetVerticesRule::pattern() const {
+    static Pattern pattern =
+        Pattern::create(graph::PlanNode::Kind::kLimit,
+                        {Pattern::create(graph::PlanNode::Kind::kProject,
+                                         {Pattern::create(graph::PlanNode::Kind::kGetVertices)})});
+    return pattern;
+}
+
+StatusOr<OptRule::TransformResult> PushLimitDownGetVerticesRule::transform(
+    OptContext *octx,
+    const MatchedResult &matched) const {
+    auto limitGroupNode = matched.node;
+    auto projGroupNode = matched.dependencies.front().node;
+    auto gvGroupNode = matched.dependencies.front().dependencies.front().node;
+
+    const auto limit = static_cast<const Limit *>(limitGroupNode->node());
+    const auto proj = static_cast<const Project *>(projGroupNode->node());
+    const auto gv = static_cast<const GetVertices *>(gvGroupNode->node());
+
+    int64_t limitRows = limit->offset() + limit->count();
+    if (gv->limit() >= 0 && limitRows >= gv->limit()) {
+        return TransformResult::noTransform();
+    }
+
+    auto newLimit = static_cast<Limit *>(limit->clone());
+    auto newLimitGroupNode = OptGroupNode::create(octx, newLimit, limitGroupNode->group());
+
+    auto newProj = static_cast<Project *>(proj->clone());
+    auto newProjGroup = OptGroup::create(octx);
+    auto newProjGroupNode = newProjGroup->makeGroupNode(newProj);
+
+    auto newGv = static_cast<GetVertices *>(gv->clone());
+    newGv->setLimit(limitRows);
+    auto newGvGroup = OptGroup::create(octx);
+    auto newGvGroupNode = newGvGroup->makeGroupNode(newGv);
+
+    newLimitGroupNode->dependsOn(newProjGroup);
+    newProjGroupNode->dependsOn(newGvGroup);
+    for (auto dep : gvGroupNode->dependencies()) {
+        newGvGroupNode->dependsOn(dep);
+    }
+
+    TransformResult result;
+    result.eraseAll = true;
+    result.newGroupNodes.emplace_back(newLimitGroupNode);
+    return result;
+}
+
+std::string PushLimitDownGetVerticesRule::toString() const {
+    return "PushLimitDownGetVerticesRule";
+}
+
+}   // namespace opt
+}   // namespace nebula
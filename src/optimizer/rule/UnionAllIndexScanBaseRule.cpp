@@ -87,6 +87,17 @@ StatusOr<TransformResult> UnionAllIndexScanBaseRule::transform(OptContext* ctx,
     auto scanNode = IndexScan::make(ctx->qctx(), nullptr);
     OptimizerUtils::copyIndexScanData(scan, scanNode);
     scanNode->setIndexQueryContext(std::move(idxCtxs));
+
+    // Scanning the index once per operand costs more than filtering the full scan when
+    // the operands are not selective
+    auto costModel = ctx->costModel();
+    auto unionEstimate = costModel->estimate(scanNode, {});
+    auto filterEstimate = costModel->estimate(filter, {costModel->estimate(scan, {})});
+    if (unionEstimate.cost >= filterEstimate.cost) {
+        scanNode->releaseSymbols();
+        return TransformResult::noTransform();
+    }
+
     scanNode->setOutputVar(filter->outputVar());
     scanNode->setColNames(filter->colNames());
     auto filterGroup = matched.node->group();
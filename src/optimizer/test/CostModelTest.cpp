@@ -0,0 +1,187 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "context/QueryContext.h"
+#include "optimizer/CostModel.h"
+#include "optimizer/OptContext.h"
+#include "optimizer/OptGroup.h"
+#include "planner/plan/Logic.h"
+#include "planner/plan/Query.h"
+#include "util/Statistics.h"
+
+using nebula::graph::Filter;
+using nebula::graph::GetNeighbors;
+using nebula::graph::InnerJoin;
+using nebula::graph::LeftJoin;
+using nebula::graph::Limit;
+using nebula::graph::QueryContext;
+using nebula::graph::Sort;
+using nebula::graph::SpaceStats;
+using nebula::graph::StartNode;
+using nebula::graph::Statistics;
+
+namespace nebula {
+namespace opt {
+
+TEST(CostModelTest, Selectivity) {
+    ObjectPool pool;
+    auto eq = RelationalExpression::makeEQ(&pool,
+                                           InputPropertyExpression::make(&pool, "a"),
+                                           ConstantExpression::make(&pool, 1));
+    auto gt = RelationalExpression::makeGT(&pool,
+                                           InputPropertyExpression::make(&pool, "b"),
+                                           ConstantExpression::make(&pool, 1));
+    EXPECT_DOUBLE_EQ(1.0, Statistics::selectivity(nullptr));
+    EXPECT_DOUBLE_EQ(Statistics::kEqualSelectivity, Statistics::selectivity(eq));
+    EXPECT_DOUBLE_EQ(Statistics::kRangeSelectivity, Statistics::selectivity(gt));
+    EXPECT_DOUBLE_EQ(1 - Statistics::kEqualSelectivity,
+                     Statistics::selectivity(UnaryExpression::makeNot(&pool, eq->clone())));
+
+    auto eqSel = Statistics::kEqualSelectivity;
+    auto gtSel = Statistics::kRangeSelectivity;
+    EXPECT_DOUBLE_EQ(eqSel * gtSel,
+                     Statistics::selectivity(
+                         LogicalExpression::makeAnd(&pool, eq->clone(), gt->clone())));
+    EXPECT_DOUBLE_EQ(eqSel + gtSel - eqSel * gtSel,
+                     Statistics::selectivity(
+                         LogicalExpression::makeOr(&pool, eq->clone(), gt->clone())));
+}
+
+TEST(CostModelTest, Cardinality) {
+    QueryContext qctx;
+    auto stats = std::make_shared<SpaceStats>();
+    stats->vertices = 1000;
+    stats->edges = 20000;
+    Statistics::setSpaceStats(1, stats);
+    CostModel model(&qctx);
+    auto pool = qctx.objPool();
+
+    auto start = StartNode::make(&qctx);
+    auto startEstimate = model.estimate(start, {});
+    EXPECT_DOUBLE_EQ(1.0, startEstimate.rows);
+    EXPECT_DOUBLE_EQ(0.0, startEstimate.cost);
+
+    // 10 vertices with the average degree 20
+    auto gn = GetNeighbors::make(&qctx, start, 1);
+    Estimate input;
+    input.rows = 10;
+    auto gnEstimate = model.estimate(gn, {input});
+    EXPECT_DOUBLE_EQ(200.0, gnEstimate.rows);
+    EXPECT_GT(gnEstimate.cost, CostModel::kRpcCost);
+
+    auto condition = RelationalExpression::makeEQ(pool,
+                                                  InputPropertyExpression::make(pool, "a"),
+                                                  ConstantExpression::make(pool, 1));
+    auto filter = Filter::make(&qctx, gn, condition);
+    auto filterEstimate = model.estimate(filter, {gnEstimate});
+    EXPECT_DOUBLE_EQ(20.0, filterEstimate.rows);
+    EXPECT_GT(filterEstimate.cost, gnEstimate.cost);
+
+    auto limit = Limit::make(&qctx, filter, 0, 5);
+    auto limitEstimate = model.estimate(limit, {filterEstimate});
+    EXPECT_DOUBLE_EQ(5.0, limitEstimate.rows);
+    EXPECT_GT(limitEstimate.cost, filterEstimate.cost);
+}
+
+TEST(CostModelTest, SpaceStats) {
+    // Nothing is fetched without meta, only the statistics set are read
+    QueryContext qctx;
+    auto stats = std::make_shared<SpaceStats>();
+    stats->vertices = 10;
+    Statistics::setSpaceStats(3, stats);
+    EXPECT_EQ(stats, Statistics::spaceStats(&qctx, 3));
+    EXPECT_EQ(nullptr, Statistics::spaceStats(&qctx, 4));
+    EXPECT_EQ(nullptr, Statistics::spaceStats(&qctx, -1));
+}
+
+TEST(CostModelTest, MinCostGroupNode) {
+    QueryContext qctx;
+    OptContext octx(&qctx);
+
+    auto start = StartNode::make(&qctx);
+    auto gn = GetNeighbors::make(&qctx, start, 2);
+    auto startGroup = OptGroup::create(&octx);
+    startGroup->makeGroupNode(start);
+    auto gnGroup = OptGroup::create(&octx);
+    gnGroup->makeGroupNode(gn)->dependsOn(startGroup);
+
+    // The sort costs more than the limit on the same input
+    auto sort = Sort::make(&qctx, gn);
+    auto limit = Limit::make(&qctx, gn, 0, 1);
+    auto group = OptGroup::create(&octx);
+    group->makeGroupNode(sort)->dependsOn(gnGroup);
+    group->makeGroupNode(limit)->dependsOn(gnGroup);
+
+    EXPECT_EQ(limit, group->getPlan());
+    EXPECT_DOUBLE_EQ(1.0, group->estimate().rows);
+    EXPECT_GT(group->getCost(), gnGroup->getCost());
+}
+
+TEST(CostModelTest, Join) {
+    QueryContext qctx;
+    CostModel model(&qctx);
+    qctx.symTable()->newVariable("a");
+    qctx.symTable()->newVariable("b");
+    auto start = StartNode::make(&qctx);
+    auto inner = InnerJoin::make(&qctx, start, {"a", 0}, {"b", 0});
+    auto left = LeftJoin::make(&qctx, start, {"a", 0}, {"b", 0});
+
+    Estimate small;
+    small.rows = 10;
+    Estimate large;
+    large.rows = 1000;
+    // The hash table is built on the smaller input whichever side it is
+    auto innerEstimate = model.estimate(inner, {small, large});
+    EXPECT_DOUBLE_EQ(1000.0, innerEstimate.rows);
+    EXPECT_DOUBLE_EQ(innerEstimate.cost, model.estimate(inner, {large, small}).cost);
+    EXPECT_DOUBLE_EQ(10 * CostModel::kHashBuildRowCost + 1000 * CostModel::kHashRowCost,
+                     innerEstimate.cost);
+
+    auto leftEstimate = model.estimate(left, {small, large});
+    EXPECT_DOUBLE_EQ(10.0, leftEstimate.rows);
+    EXPECT_DOUBLE_EQ(innerEstimate.cost, leftEstimate.cost);
+}
+
+TEST(CostModelTest, JoinInputs) {
+    QueryContext qctx;
+    OptContext octx(&qctx);
+
+    // The join depends on the rhs, which reads the lhs
+    auto start = StartNode::make(&qctx);
+    auto lhs = GetNeighbors::make(&qctx, start, 1);
+    auto rhs = GetNeighbors::make(&qctx, lhs, 1);
+    auto join = InnerJoin::make(&qctx, rhs, {lhs->outputVar(), 0}, {rhs->outputVar(), 0});
+    auto startGroup = OptGroup::create(&octx);
+    startGroup->makeGroupNode(start);
+    auto lhsGroup = OptGroup::create(&octx);
+    lhsGroup->makeGroupNode(lhs)->dependsOn(startGroup);
+    auto rhsGroup = OptGroup::create(&octx);
+    rhsGroup->makeGroupNode(rhs)->dependsOn(lhsGroup);
+    auto joinGroup = OptGroup::create(&octx);
+    joinGroup->makeGroupNode(join)->dependsOn(rhsGroup);
+
+    EXPECT_EQ(lhsGroup, rhsGroup->findProducer(lhs->outputVar()));
+    EXPECT_EQ(nullptr, lhsGroup->findProducer(rhs->outputVar()));
+
+    auto lhsRows = lhsGroup->estimate().rows;
+    auto rhsRows = rhsGroup->estimate().rows;
+    EXPECT_DOUBLE_EQ(std::max(lhsRows, rhsRows), joinGroup->estimate().rows);
+    // The cost of the lhs is counted once in the rhs
+    EXPECT_DOUBLE_EQ(rhsGroup->getCost() +
+                         std::min(lhsRows, rhsRows) * CostModel::kHashBuildRowCost +
+                         std::max(lhsRows, rhsRows) * CostModel::kHashRowCost,
+                     joinGroup->getCost());
+}
+
+}   // namespace opt
+}   // namespace nebula
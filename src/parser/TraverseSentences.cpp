@@ -213,6 +213,11 @@ std::string FindPathSentence::toString() const {
         buf += step_->toString();
         buf += " ";
     }
+    if (weight_ != nullptr) {
+        buf += "WEIGHT BY ";
+        buf += *weight_;
+        buf += " ";
+    }
     return buf;
 }
 
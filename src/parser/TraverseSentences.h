@@ -438,6 +438,10 @@ public:
         where_.reset(clause);
     }
 
+    void setWeight(std::string *weight) {
+        weight_.reset(weight);
+    }
+
     FromClause* from() const {
         return from_.get();
     }
@@ -470,6 +474,11 @@ public:
         return noLoop_;
     }
 
+    // The edge property as the weight of the shortest paths, nullptr if unweighted
+    const std::string* weight() const {
+        return weight_.get();
+    }
+
     std::string toString() const override;
 
 private:
@@ -481,6 +490,7 @@ private:
     std::unique_ptr<OverClause>     over_;
     std::unique_ptr<StepClause>     step_;
     std::unique_ptr<WhereClause>    where_;
+    std::unique_ptr<std::string>    weight_;
 };
 
 class LimitSentence final : public Sentence {
@@ -1858,6 +1858,22 @@ TEST_F(ParserTest, FindPath) {
         auto result = parse(query);
         ASSERT_TRUE(result.ok()) << result.status();
     }
+    {
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like "
+                            "UPTO 10 STEPS WEIGHT BY likeness";
+        auto result = parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like WEIGHT BY weight";
+        auto result = parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        std::string query = "FIND ALL PATH FROM \"1\" TO \"2\" OVER like WEIGHT BY likeness";
+        auto result = parse(query);
+        ASSERT_FALSE(result.ok());
+    }
 }
 
 TEST_F(ParserTest, Limit) {
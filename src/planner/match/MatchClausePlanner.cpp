@@ -14,6 +14,7 @@
 #include "planner/match/StartVidFinder.h"
 #include "planner/match/WhereClausePlanner.h"
 #include "util/ExpressionUtils.h"
+#include "util/Statistics.h"
 #include "visitor/RewriteVisitor.h"
 
 using JoinStrategyPos = nebula::graph::InnerJoinStrategy::JoinPos;
@@ -48,56 +49,107 @@ Status MatchClausePlanner::findStarts(MatchClauseContext* matchClauseCtx,
     auto& nodeInfos = matchClauseCtx->nodeInfos;
     auto& edgeInfos = matchClauseCtx->edgeInfos;
     auto& startVidFinders = StartVidFinder::finders();
-    bool foundStart = false;
+    // Without the statistics of the space, the first start found in the order of the
+    // finders is taken, otherwise the one with the fewest estimated rows
+    auto stats = Statistics::spaceStats(matchClauseCtx->qctx, matchClauseCtx->space.id);
+    std::unique_ptr<StartVidFinder> startFinder;
+    std::unique_ptr<NodeContext> startNodeCtx;
+    std::unique_ptr<EdgeContext> startEdgeCtx;
+    double startRows = std::numeric_limits<double>::max();
     // Find the start plan node
     for (auto& finder : startVidFinders) {
-        for (size_t i = 0; i < nodeInfos.size() && !foundStart; ++i) {
-            auto nodeCtx = NodeContext(matchClauseCtx, &nodeInfos[i]);
+        for (size_t i = 0; i < nodeInfos.size(); ++i) {
+            auto nodeCtx = std::make_unique<NodeContext>(matchClauseCtx, &nodeInfos[i]);
             auto nodeFinder = finder();
-            if (nodeFinder->match(&nodeCtx)) {
-                auto plan = nodeFinder->transform(&nodeCtx);
-                if (!plan.ok()) {
-                    return plan.status();
+            if (nodeFinder->match(nodeCtx.get())) {
+                auto rows = estimateStartRows(*nodeCtx, stats.get());
+                if (startFinder == nullptr || rows < startRows) {
+                    startFinder = std::move(nodeFinder);
+                    startNodeCtx = std::move(nodeCtx);
+                    startEdgeCtx.reset();
+                    startRows = rows;
+                    startIndex = i;
+                }
+                if (stats == nullptr) {
+                    break;
                 }
-                matchClausePlan = std::move(plan).value();
-                startIndex = i;
-                foundStart = true;
-                initialExpr_ = nodeCtx.initialExpr->clone();
-                VLOG(1) << "Find starts: " << startIndex << ", Pattern has " << edgeInfos.size()
-                        << " edges, root: " << matchClausePlan.root->outputVar()
-                        << ", colNames: " << folly::join(",", matchClausePlan.root->colNames());
-                break;
             }
 
-            if (i != nodeInfos.size() - 1) {
-                auto edgeCtx = EdgeContext(matchClauseCtx, &edgeInfos[i]);
+            if (i != nodeInfos.size() - 1 && (stats != nullptr || startFinder == nullptr)) {
+                auto edgeCtx = std::make_unique<EdgeContext>(matchClauseCtx, &edgeInfos[i]);
                 auto edgeFinder = finder();
-                if (edgeFinder->match(&edgeCtx)) {
-                    auto plan = edgeFinder->transform(&edgeCtx);
-                    if (!plan.ok()) {
-                        return plan.status();
+                if (edgeFinder->match(edgeCtx.get())) {
+                    auto rows = estimateStartRows(*edgeCtx, stats.get());
+                    if (startFinder == nullptr || rows < startRows) {
+                        startFinder = std::move(edgeFinder);
+                        startEdgeCtx = std::move(edgeCtx);
+                        startNodeCtx.reset();
+                        startRows = rows;
+                        startIndex = i;
+                    }
+                    if (stats == nullptr) {
+                        break;
                     }
-                    matchClausePlan = std::move(plan).value();
-                    startFromEdge = true;
-                    startIndex = i;
-                    foundStart = true;
-                    initialExpr_ = edgeCtx.initialExpr->clone();
-                    break;
                 }
             }
         }
-        if (foundStart) {
+        if (startFinder != nullptr && stats == nullptr) {
             break;
         }
     }
-    if (!foundStart) {
+    if (startFinder == nullptr) {
         return Status::SemanticError("Can't solve the start vids from the sentence: %s",
                                      matchClauseCtx->sentence->toString().c_str());
     }
 
+    if (startNodeCtx != nullptr) {
+        auto plan = startFinder->transform(startNodeCtx.get());
+        NG_RETURN_IF_ERROR(plan);
+        matchClausePlan = std::move(plan).value();
+        initialExpr_ = startNodeCtx->initialExpr->clone();
+        VLOG(1) << "Find starts: " << startIndex << ", Pattern has " << edgeInfos.size()
+                << " edges, root: " << matchClausePlan.root->outputVar()
+                << ", colNames: " << folly::join(",", matchClausePlan.root->colNames())
+                << ", estimated rows: " << startRows;
+    } else {
+        auto plan = startFinder->transform(startEdgeCtx.get());
+        NG_RETURN_IF_ERROR(plan);
+        matchClausePlan = std::move(plan).value();
+        startFromEdge = true;
+        initialExpr_ = startEdgeCtx->initialExpr->clone();
+    }
+
     return Status::OK();
 }
 
+// static
+double MatchClausePlanner::estimateStartRows(const NodeContext& nodeCtx, const SpaceStats* stats) {
+    if (!nodeCtx.ids.values.empty()) {
+        return nodeCtx.ids.values.size();
+    }
+    double rows = Statistics::kDefaultVertices;
+    auto& labels = nodeCtx.info->labels;
+    if (stats != nullptr) {
+        auto num = labels.empty() ? -1 : stats->numVertices(*labels.back());
+        rows = num < 0 ? stats->vertices : num;
+    }
+    return rows * Statistics::selectivity(nodeCtx.scanInfo.filter);
+}
+
+// static
+double MatchClausePlanner::estimateStartRows(const EdgeContext& edgeCtx, const SpaceStats* stats) {
+    double rows = Statistics::kDefaultVertices * Statistics::kDefaultDegree;
+    auto& types = edgeCtx.info->types;
+    if (stats != nullptr) {
+        auto num = types.empty() ? -1 : stats->numEdges(*types.back());
+        rows = num < 0 ? stats->edges : num;
+    }
+    if (edgeCtx.scanInfo.direction == MatchEdge::Direction::BOTH) {
+        rows *= 2;
+    }
+    return rows * Statistics::selectivity(edgeCtx.scanInfo.filter);
+}
+
 Status MatchClausePlanner::expand(const std::vector<NodeInfo>& nodeInfos,
                                   const std::vector<EdgeInfo>& edgeInfos,
                                   MatchClauseContext* matchClauseCtx,
@@ -11,6 +11,8 @@
 
 namespace nebula {
 namespace graph {
+struct SpaceStats;
+
 /*
  * The MatchClausePlanner was designed to generate plan for match clause;
  */
@@ -26,6 +28,10 @@ private:
                       size_t& startIndex,
                       SubPlan& matchClausePlan);
 
+    // Estimate the rows of the start vids, by the default statistics if `stats' is null
+    static double estimateStartRows(const NodeContext& nodeCtx, const SpaceStats* stats);
+    static double estimateStartRows(const EdgeContext& edgeCtx, const SpaceStats* stats);
+
     Status expand(const std::vector<NodeInfo>& nodeInfos,
                   const std::vector<EdgeInfo>& edgeInfos,
                   MatchClauseContext* matchClauseCtx,
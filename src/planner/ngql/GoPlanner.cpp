@@ -8,6 +8,7 @@
 #include "validator/Validator.h"
 #include "planner/plan/Logic.h"
 #include "planner/plan/Algo.h"
+#include "service/GraphFlags.h"
 #include "util/SchemaUtil.h"
 #include "util/QueryUtil.h"
 #include "util/ExpressionUtils.h"
@@ -389,6 +390,26 @@ SubPlan GoPlanner::oneStepPlan(SubPlan& startVidPlan) {
 SubPlan GoPlanner::nStepsPlan(SubPlan& startVidPlan) {
     auto qctx = goCtx_->qctx;
 
+    if (!goCtx_->joinInput && FLAGS_enable_pipelined_expand) {
+        // The vertices of the steps before the last are only deduped, so expand them
+        // without the barrier between the steps. So does the piped GO unless it refers
+        // to the input columns, which the Loop joins back by tracking the start vids.
+        auto* expand = Expand::make(qctx,
+                                    startVidPlan.root,
+                                    goCtx_->space.id,
+                                    goCtx_->from.src,
+                                    buildEdgeProps(true),
+                                    goCtx_->steps.steps() - 1);
+        expand->setInputVar(goCtx_->vidsVar);
+        expand->setOutputVar(goCtx_->vidsVar);
+        expand->setColNames({kVid});
+
+        SubPlan subPlan;
+        subPlan.root = lastStep(expand, nullptr);
+        subPlan.tail = startVidPlan.tail == nullptr ? expand : startVidPlan.tail;
+        return subPlan;
+    }
+
     auto* start = StartNode::make(qctx);
     auto* gn = GetNeighbors::make(qctx, start, goCtx_->space.id);
     gn->setSrc(goCtx_->from.src);
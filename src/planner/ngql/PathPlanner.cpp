@@ -77,17 +77,24 @@ void PathPlanner::buildStart(Starts& starts, std::string& vidsVar, bool reverse)
     }
 }
 
-// loopSteps{0} <= ((steps + 1) / 2)  && (pathVar is Empty || size(pathVar) == 0)
+// loopSteps{0} <= steps && (pathVar is Empty || size(pathVar) == 0) &&
+// (size(fromVidsVar) != 0 || size(toVidsVar) != 0)
+// Each round expands one side at least, and the sides to expand are chosen by
+// the conjunct, which clears both inputs once the search is over.
 Expression* PathPlanner::singlePairLoopCondition(uint32_t steps, const std::string& pathVar) {
     auto loopSteps = pathCtx_->qctx->vctx()->anonVarGen()->getVar();
     pathCtx_->qctx->ectx()->setValue(loopSteps, 0);
     auto* pool = pathCtx_->qctx->objPool();
 
-    auto step = ExpressionUtils::stepCondition(pool, loopSteps, ((steps + 1) / 2));
+    auto step = ExpressionUtils::stepCondition(pool, loopSteps, steps);
     auto empty = ExpressionUtils::equalCondition(pool, pathVar, Value::kEmpty);
     auto zero = ExpressionUtils::zeroCondition(pool, pathVar);
     auto* noFound = LogicalExpression::makeOr(pool, empty, zero);
-    return LogicalExpression::makeAnd(pool, step, noFound);
+    auto* forward = ExpressionUtils::neZeroCondition(pool, pathCtx_->fromVidsVar);
+    auto* backward = ExpressionUtils::neZeroCondition(pool, pathCtx_->toVidsVar);
+    auto* expanding = LogicalExpression::makeOr(pool, forward, backward);
+    return LogicalExpression::makeAnd(
+        pool, LogicalExpression::makeAnd(pool, step, noFound), expanding);
 }
 
 // loopSteps{0} <= (steps + 1) / 2
@@ -138,25 +145,24 @@ SubPlan PathPlanner::buildRuntimeVidPlan() {
 PlanNode* PathPlanner::allPairStartVidDataSet(PlanNode* dep, const std::string& inputVar) {
     auto* pool = pathCtx_->qctx->objPool();
 
+    // The starts are the roots of the prefix trees of the paths,
+    // see ProduceAllPathsExecutor
     // col 0 is vid
     auto* vid = new YieldColumn(ColumnExpression::make(pool, 0), kVid);
-    // col 1 is list<path(only contain src)>
-    auto* pathExpr = PathBuildExpression::make(pool);
-    pathExpr->add(ColumnExpression::make(pool, 0));
-
-    auto* exprList = ExpressionList::make(pool);
-    exprList->add(pathExpr);
-    auto* listExpr = ListExpression::make(pool, exprList);
-    auto* path = new YieldColumn(listExpr, kPathStr);
+    // col 1 is the edge to the vid, none for the start
+    auto* edge = new YieldColumn(ConstantExpression::make(pool, Value::kEmpty), kEdgeStr);
+    // col 2 is the parent, none for the start
+    auto* parent = new YieldColumn(ConstantExpression::make(pool, -1), kParentStr);
 
     auto* columns = pool->add(new YieldColumns());
     columns->addColumn(vid);
-    columns->addColumn(path);
+    columns->addColumn(edge);
+    columns->addColumn(parent);
 
     auto* project = Project::make(pathCtx_->qctx, dep, columns);
     project->setInputVar(inputVar);
     project->setOutputVar(inputVar);
-    project->setColNames({kVid, kPathStr});
+    project->setColNames({kVid, kEdgeStr, kParentStr});
 
     return project;
 }
@@ -299,7 +305,7 @@ PlanNode* PathPlanner::allPairPath(PlanNode* dep, bool reverse) {
 
     auto* path = ProduceAllPaths::make(qctx, pathDep);
     path->setOutputVar(vidsVar);
-    path->setColNames({kVid, kPathStr});
+    path->setColNames({kVid, kEdgeStr, kParentStr});
     return path;
 }
 
@@ -331,6 +337,48 @@ SubPlan PathPlanner::allPairPlan(PlanNode* dep) {
     return subPlan;
 }
 
+/*
+ *  The neighbors of a batch of the vids chosen by the Dijkstra are fetched in
+ *  each round, see DijkstraShortestPathExecutor. The Dijkstra sets the next
+ *  batch to fromVidsVar, and empty once the search is over.
+ */
+SubPlan PathPlanner::weightedPlan(PlanNode* dep) {
+    auto qctx = pathCtx_->qctx;
+    auto* pool = qctx->objPool();
+
+    auto* gn = GetNeighbors::make(qctx, dep, pathCtx_->space.id);
+    gn->setSrc(ColumnExpression::make(pool, 0));
+    gn->setEdgeProps(buildEdgeProps(false));
+    gn->setInputVar(pathCtx_->fromVidsVar);
+    gn->setDedup();
+
+    PlanNode* pathDep = gn;
+    if (pathCtx_->filter != nullptr) {
+        auto* filterExpr = pathCtx_->filter->clone();
+        pathDep = Filter::make(qctx, gn, filterExpr);
+    }
+
+    auto* dijkstra =
+        DijkstraShortestPath::make(qctx, pathDep, pathCtx_->weightProp, pathCtx_->steps.steps());
+    dijkstra->setFromVidsVar(pathCtx_->fromVidsVar);
+    dijkstra->setToVidsVar(pathCtx_->toVidsVar);
+    dijkstra->setColNames({kPathStr});
+
+    SubPlan loopDepPlan = buildRuntimeVidPlan();
+    auto* loopCondition = ExpressionUtils::neZeroCondition(pool, pathCtx_->fromVidsVar);
+    auto* loop = Loop::make(qctx, loopDepPlan.root, dijkstra, loopCondition);
+
+    auto* dc = DataCollect::make(qctx, DataCollect::DCKind::kAllPaths);
+    dc->addDep(loop);
+    dc->setInputVars({dijkstra->outputVar()});
+    dc->setColNames({"path"});
+
+    SubPlan subPlan;
+    subPlan.root = dc;
+    subPlan.tail = loopDepPlan.tail == nullptr ? loop : loopDepPlan.tail;
+    return subPlan;
+}
+
 PlanNode* PathPlanner::multiPairPath(PlanNode* dep, bool reverse) {
     const auto& vidsVar = reverse ? pathCtx_->toVidsVar : pathCtx_->fromVidsVar;
     auto qctx = pathCtx_->qctx;
@@ -520,6 +568,10 @@ StatusOr<SubPlan> PathPlanner::transform(AstContext* astCtx) {
 
     SubPlan subPlan;
     do {
+        if (pathCtx_->isWeight) {
+            subPlan = weightedPlan(pt);
+            break;
+        }
         if (!pathCtx_->isShortest || pathCtx_->noLoop) {
             subPlan = allPairPlan(pt);
             break;
@@ -35,6 +35,8 @@ private:
 
     SubPlan allPairPlan(PlanNode* dep);
 
+    SubPlan weightedPlan(PlanNode* dep);
+
     PlanNode* singlePairPath(PlanNode* dep, bool reverse);
 
     PlanNode* multiPairPath(PlanNode* dep, bool reverse);
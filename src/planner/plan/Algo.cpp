@@ -35,6 +35,15 @@ std::unique_ptr<PlanNodeDescription> ConjunctPath::explain() const {
     return desc;
 }
 
+std::unique_ptr<PlanNodeDescription> DijkstraShortestPath::explain() const {
+    auto desc = SingleInputNode::explain();
+    addDescription("weight", weightProp_, desc.get());
+    addDescription("steps", util::toJson(steps_), desc.get());
+    addDescription("fromVidsVar", fromVidsVar_, desc.get());
+    addDescription("toVidsVar", toVidsVar_, desc.get());
+    return desc;
+}
+
 std::unique_ptr<PlanNodeDescription> ProduceAllPaths::explain() const {
     auto desc = SingleDependencyNode::explain();
     addDescription("noloop ", util::toJson(noLoop_), desc.get());
@@ -34,6 +34,58 @@ private:
         : SingleInputNode(qctx, Kind::kBFSShortest, input) {}
 };
 
+// The shortest paths weighted by an edge property, from each of the starts to
+// each of the ends, found by Dijkstra with the neighbors fetched in batches.
+// It sets the vids whose neighbors to fetch next to the input of the neighbors.
+class DijkstraShortestPath : public SingleInputNode {
+public:
+    static DijkstraShortestPath* make(QueryContext* qctx,
+                                      PlanNode* input,
+                                      std::string weightProp,
+                                      size_t steps) {
+        return qctx->objPool()->add(
+            new DijkstraShortestPath(qctx, input, std::move(weightProp), steps));
+    }
+
+    const std::string& weightProp() const {
+        return weightProp_;
+    }
+
+    size_t steps() const {
+        return steps_;
+    }
+
+    // The starts, and the vids to fetch the neighbors of in each round
+    const std::string& fromVidsVar() const {
+        return fromVidsVar_;
+    }
+
+    void setFromVidsVar(std::string var) {
+        fromVidsVar_ = std::move(var);
+    }
+
+    const std::string& toVidsVar() const {
+        return toVidsVar_;
+    }
+
+    void setToVidsVar(std::string var) {
+        toVidsVar_ = std::move(var);
+    }
+
+    std::unique_ptr<PlanNodeDescription> explain() const override;
+
+private:
+    DijkstraShortestPath(QueryContext* qctx, PlanNode* input, std::string weightProp, size_t steps)
+        : SingleInputNode(qctx, Kind::kDijkstraShortestPath, input),
+          weightProp_(std::move(weightProp)),
+          steps_(steps) {}
+
+    std::string weightProp_;
+    size_t      steps_{0};
+    std::string fromVidsVar_;
+    std::string toVidsVar_;
+};
+
 class ConjunctPath : public BinaryInputNode {
 public:
     enum class PathKind : uint8_t {
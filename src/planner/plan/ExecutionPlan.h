@@ -40,6 +40,15 @@ public:
         return &optimizeTimeInUs_;
     }
 
+    // The cost of the plan estimated by the optimizer, negative if not estimated
+    double estimatedCost() const {
+        return estimatedCost_;
+    }
+
+    void setEstimatedCost(double cost) {
+        estimatedCost_ = cost;
+    }
+
     void addProfileStats(int64_t planNodeId, ProfilingStats&& profilingStats);
 
     void describe(PlanDescription* planDesc);
@@ -54,6 +63,7 @@ private:
     void setPlanNodeDeps(const PlanNode* dep, PlanNodeDescription* planNodeDesc) const;
 
     int32_t optimizeTimeInUs_{0};
+    double estimatedCost_{-1.0};
     int64_t id_{-1};
     PlanNode* root_{nullptr};
     // plan description for explain and profile query
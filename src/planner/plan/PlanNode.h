@@ -26,6 +26,7 @@ public:
 
         // Query
         kGetNeighbors,
+        kExpand,
         kGetVertices,
         kGetEdges,
         // ------------------
@@ -52,6 +53,7 @@ public:
         kDedup,
         kAssign,
         kBFSShortest,
+        kDijkstraShortestPath,
         kProduceSemiShortestPath,
         kConjunctPath,
         kProduceAllPaths,
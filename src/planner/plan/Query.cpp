@@ -96,6 +96,32 @@ void GetNeighbors::cloneMembers(const GetNeighbors& g) {
     }
 }
 
+std::unique_ptr<PlanNodeDescription> Expand::explain() const {
+    auto desc = Explore::explain();
+    addDescription("src", src_ ? src_->toString() : "", desc.get());
+    addDescription(
+        "edgeProps", edgeProps_ ? folly::toJson(util::toJson(*edgeProps_)) : "", desc.get());
+    addDescription("steps", folly::to<std::string>(steps_), desc.get());
+    return desc;
+}
+
+PlanNode* Expand::clone() const {
+    auto* newExpand = qctx_->objPool()->add(new Expand(qctx_, nullptr, space_));
+    newExpand->cloneMembers(*this);
+    return newExpand;
+}
+
+void Expand::cloneMembers(const Expand& e) {
+    Explore::cloneMembers(e);
+
+    setSrc(e.src_->clone());
+    setSteps(e.steps_);
+    if (e.edgeProps_) {
+        auto edgeProps = *e.edgeProps_;
+        setEdgeProps(std::make_unique<decltype(edgeProps)>(std::move(edgeProps)));
+    }
+}
+
 std::unique_ptr<PlanNodeDescription> GetVertices::explain() const {
     auto desc = Explore::explain();
     addDescription("src", src_ ? src_->toString() : "", desc.get());
@@ -449,6 +475,15 @@ PlanNode* Dedup::clone() const {
 
 void Dedup::cloneMembers(const Dedup &l) {
     SingleInputNode::cloneMembers(l);
+    vidFrontier_ = l.vidFrontier_;
+}
+
+std::unique_ptr<PlanNodeDescription> Dedup::explain() const {
+    auto desc = SingleInputNode::explain();
+    if (vidFrontier_) {
+        addDescription("vidFrontier", util::toJson(vidFrontier_), desc.get());
+    }
+    return desc;
 }
 
 
@@ -232,6 +232,68 @@ private:
     bool                                     random_{false};
 };
 
+/**
+ * Expand the source vertices by the given steps, and output the deduped
+ * destinations of the last step. The neighbors of each part of a step are
+ * requested as soon as the response of the previous step carrying them arrives,
+ * instead of waiting for the whole previous step.
+ */
+class Expand final : public Explore {
+public:
+    static Expand* make(QueryContext* qctx,
+                        PlanNode* input,
+                        GraphSpaceID space,
+                        Expression* src,
+                        std::unique_ptr<std::vector<EdgeProp>>&& edgeProps,
+                        uint32_t steps) {
+        auto expand = qctx->objPool()->add(new Expand(qctx, input, space));
+        expand->setSrc(src);
+        expand->setEdgeProps(std::move(edgeProps));
+        expand->setSteps(steps);
+        return expand;
+    }
+
+    Expression* src() const {
+        return src_;
+    }
+
+    const std::vector<EdgeProp>* edgeProps() const {
+        return edgeProps_.get();
+    }
+
+    uint32_t steps() const {
+        return steps_;
+    }
+
+    void setSrc(Expression* src) {
+        src_ = src;
+    }
+
+    void setEdgeProps(std::unique_ptr<std::vector<EdgeProp>> edgeProps) {
+        edgeProps_ = std::move(edgeProps);
+    }
+
+    void setSteps(uint32_t steps) {
+        steps_ = steps;
+    }
+
+    PlanNode* clone() const override;
+    std::unique_ptr<PlanNodeDescription> explain() const override;
+
+private:
+    Expand(QueryContext* qctx, PlanNode* input, GraphSpaceID space)
+        : Explore(qctx, Kind::kExpand, input, space) {
+        setDedup();
+        setLimit(-1);
+    }
+
+    void cloneMembers(const Expand&);
+
+    Expression*                              src_{nullptr};
+    std::unique_ptr<std::vector<EdgeProp>>   edgeProps_;
+    uint32_t                                 steps_{1};
+};
+
 /**
  * Get property with given vertex keys.
  */
@@ -930,12 +992,26 @@ public:
         return qctx->objPool()->add(new Dedup(qctx, input));
     }
 
+    // Whether the input is a column of the vids to expand from, e.g. the next
+    // step of GO, which are deduplicated by the interned ids
+    bool isVidFrontier() const {
+        return vidFrontier_;
+    }
+
+    void setVidFrontier() {
+        vidFrontier_ = true;
+    }
+
     PlanNode* clone() const override;
 
+    std::unique_ptr<PlanNodeDescription> explain() const override;
+
 private:
     Dedup(QueryContext* qctx, PlanNode* input);
 
     void cloneMembers(const Dedup&);
+
+    bool vidFrontier_{false};
 };
 
 class DataCollect final : public VariableDependencyNode {
@@ -0,0 +1,249 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "service/AdmissionController.h"
+
+#include <algorithm>
+
+#include "common/base/Memory.h"
+#include "context/QueryContext.h"
+#include "parser/ExplainSentence.h"
+#include "parser/SequentialSentences.h"
+#include "parser/TraverseSentences.h"
+#include "planner/plan/ExecutionPlan.h"
+#include "service/GraphFlags.h"
+#include "stats/StatsDef.h"
+
+namespace nebula {
+namespace graph {
+
+AdmissionController::AdmissionController() {
+    worker_ = std::make_unique<thread::GenericWorker>();
+    CHECK(worker_->start("admission"));
+    worker_->addRepeatTask(kTickIntervalMs, &AdmissionController::tick, this);
+}
+
+AdmissionController::~AdmissionController() {
+    worker_->stop();
+    worker_->wait();
+}
+
+// static
+AdmissionController::Ticket AdmissionController::makeTicket(QueryContext* qctx,
+                                                            Sentence* sentence) {
+    Ticket ticket;
+    ticket.exempt = !isDataQuery(sentence);
+    auto* session = qctx->rctx()->session();
+    ticket.user = session->user();
+    ticket.space = qctx->vctx()->spaceChosen() ? qctx->vctx()->whichSpace().id
+                                               : session->space().id;
+    ticket.cost = std::max(qctx->plan()->estimatedCost(), 0.0);
+    ticket.priority = ticket.cost <= FLAGS_short_query_cost ? Priority::kShort : Priority::kLong;
+    return ticket;
+}
+
+// static
+bool AdmissionController::isDataQuery(Sentence* sentence) {
+    switch (sentence->kind()) {
+        case Sentence::Kind::kExplain:
+            return isDataQuery(static_cast<ExplainSentence*>(sentence)->seqSentences());
+        case Sentence::Kind::kSequential: {
+            auto sentences = static_cast<SequentialSentences*>(sentence)->sentences();
+            return std::any_of(sentences.begin(), sentences.end(), isDataQuery);
+        }
+        case Sentence::Kind::kPipe: {
+            auto* pipe = static_cast<PipedSentence*>(sentence);
+            return isDataQuery(pipe->left()) || isDataQuery(pipe->right());
+        }
+        case Sentence::Kind::kSet: {
+            auto* set = static_cast<SetSentence*>(sentence);
+            return isDataQuery(set->left()) || isDataQuery(set->right());
+        }
+        case Sentence::Kind::kAssignment:
+            return isDataQuery(static_cast<AssignmentSentence*>(sentence)->sentence());
+        case Sentence::Kind::kGo:
+        case Sentence::Kind::kFetchVertices:
+        case Sentence::Kind::kFetchEdges:
+        case Sentence::Kind::kLookup:
+        case Sentence::Kind::kMatch:
+        case Sentence::Kind::kFindPath:
+        case Sentence::Kind::kGetSubgraph:
+            return true;
+        default:
+            return false;
+    }
+}
+
+folly::SemiFuture<Status> AdmissionController::admit(const Ticket& ticket,
+                                                     std::function<bool()> killed) {
+    if (ticket.exempt) {
+        return folly::makeSemiFuture(Status::OK());
+    }
+    auto future = folly::SemiFuture<Status>::makeEmpty();
+    std::vector<std::pair<folly::Promise<Status>, Status>> results;
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto& queue = queues_[static_cast<size_t>(ticket.priority)];
+        auto seq = ++seq_;
+        queue.emplace_back(
+            Waiter{ticket, folly::Promise<Status>(), std::move(killed), seq, Clock::now()});
+        future = queue.back().promise.getSemiFuture();
+        ++numQueued_;
+        results = dispatch();
+        // Not admitted at once, the waiter is still the last one of its queue
+        queued = !queue.empty() && queue.back().seq == seq;
+        if (queued && FLAGS_max_queued_queries > 0 && numQueued_ > FLAGS_max_queued_queries) {
+            results.emplace_back(
+                std::move(queue.back().promise),
+                Status::Error("Too many queries(%lu) are waiting to run", numQueued_ - 1));
+            queue.pop_back();
+            --numQueued_;
+            queued = false;
+            stats::StatsManager::addValue(kNumRejectedQueries);
+        }
+    }
+    fulfill(std::move(results));
+    if (queued) {
+        stats::StatsManager::addValue(kNumQueuedQueries);
+    }
+    return future;
+}
+
+void AdmissionController::release(const Ticket& ticket) {
+    if (ticket.exempt) {
+        return;
+    }
+    std::vector<std::pair<folly::Promise<Status>, Status>> results;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        DCHECK_GT(running_, 0);
+        --running_;
+        // Avoid accumulating the rounding errors
+        runningCost_ = running_ == 0 ? 0.0 : runningCost_ - ticket.cost;
+        auto user = userRunning_.find(ticket.user);
+        if (user != userRunning_.end() && --user->second == 0) {
+            userRunning_.erase(user);
+        }
+        auto space = spaceRunning_.find(ticket.space);
+        if (space != spaceRunning_.end() && --space->second == 0) {
+            spaceRunning_.erase(space);
+        }
+        results = dispatch();
+    }
+    fulfill(std::move(results));
+}
+
+void AdmissionController::tick() {
+    if (FLAGS_admission_memory_watermark_ratio > 0) {
+        auto status = MemInfo::make();
+        if (status.ok()) {
+            auto mem = std::move(status).value();
+            memoryHigh_.store(mem->hitsHighWatermark(FLAGS_admission_memory_watermark_ratio));
+        }
+    } else {
+        memoryHigh_.store(false);
+    }
+
+    std::vector<std::pair<folly::Promise<Status>, Status>> results;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (numQueued_ == 0) {
+            return;
+        }
+        if (FLAGS_long_query_max_queued_ms > 0) {
+            auto deadline =
+                Clock::now() - std::chrono::milliseconds(FLAGS_long_query_max_queued_ms);
+            auto& longQueue = queues_[static_cast<size_t>(Priority::kLong)];
+            auto& shortQueue = queues_[static_cast<size_t>(Priority::kShort)];
+            // The long queue is in the order of the arrivals
+            while (!longQueue.empty() && longQueue.front().enqueued <= deadline) {
+                auto waiter = std::move(longQueue.front());
+                longQueue.pop_front();
+                waiter.ticket.priority = Priority::kShort;
+                auto pos = std::upper_bound(
+                    shortQueue.begin(), shortQueue.end(), waiter.seq,
+                    [](uint64_t seq, const Waiter& w) { return seq < w.seq; });
+                shortQueue.insert(pos, std::move(waiter));
+            }
+        }
+        results = dispatch();
+    }
+    fulfill(std::move(results));
+}
+
+bool AdmissionController::admissible(const Ticket& ticket, bool memoryHigh) const {
+    if (running_ == 0) {
+        return true;
+    }
+    if (FLAGS_max_running_queries > 0 && running_ >= FLAGS_max_running_queries) {
+        return false;
+    }
+    if (FLAGS_max_running_queries_per_user > 0) {
+        auto found = userRunning_.find(ticket.user);
+        if (found != userRunning_.end() && found->second >= FLAGS_max_running_queries_per_user) {
+            return false;
+        }
+    }
+    if (FLAGS_max_running_queries_per_space > 0) {
+        auto found = spaceRunning_.find(ticket.space);
+        if (found != spaceRunning_.end() &&
+            found->second >= FLAGS_max_running_queries_per_space) {
+            return false;
+        }
+    }
+    if (ticket.priority == Priority::kShort) {
+        return true;
+    }
+    if (FLAGS_max_running_query_cost > 0 &&
+        runningCost_ + ticket.cost > FLAGS_max_running_query_cost) {
+        return false;
+    }
+    return !memoryHigh;
+}
+
+void AdmissionController::take(const Ticket& ticket) {
+    ++running_;
+    runningCost_ += ticket.cost;
+    ++userRunning_[ticket.user];
+    if (ticket.space >= 0) {
+        ++spaceRunning_[ticket.space];
+    }
+}
+
+std::vector<std::pair<folly::Promise<Status>, Status>> AdmissionController::dispatch() {
+    bool memoryHigh = memoryHigh_.load();
+    std::vector<std::pair<folly::Promise<Status>, Status>> results;
+    for (auto& queue : queues_) {
+        // The query blocked by the slots of its user or space doesn't block the others
+        for (auto it = queue.begin(); it != queue.end();) {
+            if (it->killed != nullptr && it->killed()) {
+                results.emplace_back(std::move(it->promise),
+                                     Status::Error("Execution had been killed"));
+            } else if (admissible(it->ticket, memoryHigh)) {
+                take(it->ticket);
+                results.emplace_back(std::move(it->promise), Status::OK());
+            } else {
+                ++it;
+                continue;
+            }
+            it = queue.erase(it);
+            --numQueued_;
+        }
+    }
+    return results;
+}
+
+// static
+void AdmissionController::fulfill(
+    std::vector<std::pair<folly::Promise<Status>, Status>>&& results) {
+    for (auto& result : results) {
+        result.first.setValue(std::move(result.second));
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
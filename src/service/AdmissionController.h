@@ -0,0 +1,132 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef SERVICE_ADMISSIONCONTROLLER_H_
+#define SERVICE_ADMISSIONCONTROLLER_H_
+
+#include <folly/futures/Future.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/cpp/helpers.h"
+#include "common/thread/GenericWorker.h"
+#include "common/thrift/ThriftTypes.h"
+
+/**
+ * AdmissionController decides when the compiled queries start to run.
+ *
+ * A query takes a slot of graphd, of its user and of its space while running,
+ * and waits in a queue if any of them is used up. The queries whose estimated
+ * cost is small, e.g. the point lookups, are queued ahead of the others, and
+ * the others are held back as well once the sum of the estimated cost of the
+ * running queries or the used system memory exceeds its threshold.
+ *
+ * A query is always admitted if nothing is running, so that the queue never
+ * stalls, and a long query queued for too long is promoted to a short one, so
+ * that it is not starved by the short ones. A query is rejected if it could not
+ * be admitted at once while the queue is full, and is dropped from the queue
+ * once it is killed, e.g. by KILL QUERY or the expiration of its session.
+ *
+ * Only the queries reading the data, e.g. GO, FETCH, LOOKUP, MATCH, FIND PATH
+ * and GET SUBGRAPH, are admitted this way. The others, e.g. KILL QUERY, SHOW
+ * QUERIES and USE, run at once without any slot, so that they are never queued
+ * behind the queries they are to inspect or stop.
+ *
+ * Nothing is limited by default, and so all queries are admitted at once.
+ */
+
+namespace nebula {
+
+class Sentence;
+
+namespace graph {
+
+class QueryContext;
+
+class AdmissionController final : public cpp::NonCopyable, public cpp::NonMovable {
+public:
+    enum class Priority : uint8_t {
+        kShort = 0,
+        kLong,
+    };
+
+    struct Ticket {
+        std::string     user;
+        GraphSpaceID    space{-1};
+        double          cost{0.0};
+        Priority        priority{Priority::kShort};
+        // Admitted at once without taking any slot
+        bool            exempt{false};
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    AdmissionController();
+
+    ~AdmissionController();
+
+    // The ticket of the query of `sentence' compiled in `qctx'
+    static Ticket makeTicket(QueryContext* qctx, Sentence* sentence);
+
+    // Whether `sentence' reads the data, which is subject to the admission
+    static bool isDataQuery(Sentence* sentence);
+
+    // Fulfilled with OK once the query is admitted, or an error if it is rejected,
+    // or `killed' returns true while it is queued.
+    // The admitted query must be released once done.
+    folly::SemiFuture<Status> admit(const Ticket& ticket,
+                                    std::function<bool()> killed = nullptr);
+
+    void release(const Ticket& ticket);
+
+    // Drop the killed waiters, promote the aged long ones and sample the system memory,
+    // which is done by the worker periodically
+    void tick();
+
+private:
+    static constexpr size_t kNumPriorities = 2;
+    static constexpr size_t kTickIntervalMs = 100;
+
+    struct Waiter {
+        Ticket                      ticket;
+        folly::Promise<Status>      promise;
+        std::function<bool()>       killed;
+        uint64_t                    seq{0};
+        Clock::time_point           enqueued;
+    };
+
+    bool admissible(const Ticket& ticket, bool memoryHigh) const;
+
+    void take(const Ticket& ticket);
+
+    // Admit the waiters in the order of the priorities and then the arrivals,
+    // and return their promises with the results to fulfill out of the lock
+    std::vector<std::pair<folly::Promise<Status>, Status>> dispatch();
+
+    static void fulfill(std::vector<std::pair<folly::Promise<Status>, Status>>&& results);
+
+    std::unique_ptr<thread::GenericWorker>          worker_;
+    // Sampled by the worker rather than under the lock
+    std::atomic<bool>                               memoryHigh_{false};
+    std::mutex                                      lock_;
+    size_t                                          running_{0};
+    double                                          runningCost_{0.0};
+    std::unordered_map<std::string, size_t>         userRunning_;
+    std::unordered_map<GraphSpaceID, size_t>        spaceRunning_;
+    std::deque<Waiter>                              queues_[kNumPriorities];
+    size_t                                          numQueued_{0};
+    uint64_t                                        seq_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // SERVICE_ADMISSIONCONTROLLER_H_
@@ -52,6 +52,62 @@ DEFINE_int64(max_allowed_connections,
              "Max connections of the whole cluster");
 
 DEFINE_bool(enable_optimizer, false, "Whether to enable optimizer");
+DEFINE_uint32(space_stats_refresh_interval_secs, 300,
+              "Interval in seconds to refresh the space statistics used to estimate "
+              "the cardinality of plans");
+DEFINE_bool(enable_plan_cache, false,
+            "Whether to cache the plans of GO and FETCH with the literals as parameters");
+DEFINE_uint32(plan_cache_capacity, 1024, "Max number of the normalized queries in plan cache");
+DEFINE_uint32(plan_cache_instances, 16,
+              "Max number of the idle plans cached for each normalized query");
+DEFINE_uint32(plan_cache_schema_check_interval_ms, 1000,
+              "The interval in ms to check whether the schemas or indexes of a space changed, "
+              "the cached plans of the space are dropped once they did");
+
+DEFINE_bool(enable_batch_eval, true,
+            "Whether to evaluate the filter and project expressions over batches of rows");
+DEFINE_uint32(max_job_size, 8,
+              "The max number of the concurrent jobs one executor splits its input into, "
+              "1 to run the whole input in one job");
+DEFINE_uint32(min_batch_size, 8192, "The min number of the rows processed by each job");
+DEFINE_bool(enable_pipeline_execution, false,
+            "Whether to run the chains of filter, project and limit as pipelines of batches, "
+            "which requires enable_lifetime_optimize");
+DEFINE_uint32(pipeline_batch_size, 1024, "The number of rows pushed through a pipeline at once");
+DEFINE_uint32(shortest_path_batch_size, 1024,
+              "The max number of the vertices whose neighbors are fetched at once "
+              "by the weighted shortest path");
+DEFINE_bool(enable_pipelined_expand, true,
+            "Whether to expand the steps of GO without waiting for the whole previous step");
+DEFINE_uint32(expand_batch_size, 256,
+              "The max number of the vertices whose neighbors are requested at once "
+              "by the pipelined expansion of GO");
+DEFINE_int64(max_query_memory_mb, 0,
+             "Max memory in MB held by the intermediate results of a query, 0 for unlimited");
+DEFINE_int64(max_session_memory_mb, 0,
+             "Max memory in MB held by the running queries of a session, 0 for unlimited");
+
+DEFINE_uint32(max_running_queries, 0,
+              "Max number of the queries running at once in a graphd, the others are queued, "
+              "0 for unlimited");
+DEFINE_uint32(max_running_queries_per_user, 0,
+              "Max number of the queries of a user running at once, 0 for unlimited");
+DEFINE_uint32(max_running_queries_per_space, 0,
+              "Max number of the queries on a space running at once, 0 for unlimited");
+DEFINE_uint32(max_queued_queries, 1024,
+              "Max number of the queries waiting to run, the later ones are rejected, "
+              "0 for unlimited");
+DEFINE_double(short_query_cost, 10000,
+              "The queries whose estimated cost is at most this run ahead of the others");
+DEFINE_double(max_running_query_cost, 0,
+              "Max sum of the estimated cost of the running queries, beyond which only the "
+              "short queries are admitted, 0 for unlimited");
+DEFINE_double(admission_memory_watermark_ratio, 0,
+              "Only the short queries are admitted once the used system memory hits the ratio, "
+              "0 for disabled");
+DEFINE_uint32(long_query_max_queued_ms, 30000,
+              "The long queries queued for longer than this are run as the short ones, "
+              "0 for never");
 
 DEFINE_uint32(ft_request_retry_times, 3, "Retry times if fulltext request failed");
 
@@ -41,6 +41,33 @@ DECLARE_double(system_memory_high_watermark_ratio);
 
 // optimizer
 DECLARE_bool(enable_optimizer);
+DECLARE_uint32(space_stats_refresh_interval_secs);
+DECLARE_bool(enable_plan_cache);
+DECLARE_uint32(plan_cache_capacity);
+DECLARE_uint32(plan_cache_instances);
+DECLARE_uint32(plan_cache_schema_check_interval_ms);
+
+// executor
+DECLARE_bool(enable_batch_eval);
+DECLARE_uint32(max_job_size);
+DECLARE_uint32(min_batch_size);
+DECLARE_bool(enable_pipeline_execution);
+DECLARE_uint32(pipeline_batch_size);
+DECLARE_uint32(shortest_path_batch_size);
+DECLARE_bool(enable_pipelined_expand);
+DECLARE_uint32(expand_batch_size);
+DECLARE_int64(max_query_memory_mb);
+DECLARE_int64(max_session_memory_mb);
+
+// admission
+DECLARE_uint32(max_running_queries);
+DECLARE_uint32(max_running_queries_per_user);
+DECLARE_uint32(max_running_queries_per_space);
+DECLARE_uint32(max_queued_queries);
+DECLARE_double(short_query_cost);
+DECLARE_double(max_running_query_cost);
+DECLARE_double(admission_memory_watermark_ratio);
+DECLARE_uint32(long_query_max_queued_ms);
 
 DECLARE_int64(max_allowed_connections);
 
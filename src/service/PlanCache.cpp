@@ -0,0 +1,430 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "service/PlanCache.h"
+
+#include <folly/hash/Hash.h>
+
+#include <limits>
+#include <set>
+
+#include "parser/GQLParser.h"
+#include "parser/SequentialSentences.h"
+#include "service/GraphFlags.h"
+#include "validator/Validator.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Whether the query starts with the keyword in upper case
+bool startsWithWord(const std::string& query, folly::StringPiece word) {
+    if (query.size() < word.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < word.size(); ++i) {
+        if (std::toupper(static_cast<unsigned char>(query[i])) != word[i]) {
+            return false;
+        }
+    }
+    return query.size() == word.size() || !isIdentChar(query[word.size()]);
+}
+
+// Another value of the same type as the literal
+Value probeValue(const Value& value) {
+    if (value.isInt()) {
+        auto v = value.getInt();
+        return v == std::numeric_limits<int64_t>::max() ? v - 1 : v + 1;
+    }
+    return value.getStr() + "_";
+}
+
+std::string toLiteral(const Value& value, char quote) {
+    if (value.isInt()) {
+        return folly::to<std::string>(value.getInt());
+    }
+    return folly::to<std::string>(quote, value.getStr(), quote);
+}
+
+}   // namespace
+
+PlanCache::Key PlanCache::makeKey(const QueryContext* qctx) const {
+    Key key;
+    auto rctx = qctx->rctx();
+    key.space = rctx->session()->space().id;
+    if (key.space <= kInvalidSpaceID) {
+        return key;
+    }
+    auto query = normalize(rctx->query(), &key.literals);
+    // Only the GO and FETCH are cached
+    if (startsWithWord(query, "GO") || startsWithWord(query, "FETCH")) {
+        key.query = std::move(query);
+    }
+    return key;
+}
+
+std::unique_ptr<PlanCache::Compiled> PlanCache::checkout(QueryContext* qctx, Key* key) {
+    auto version = fingerprint(qctx, key->space);
+    VariantPtr variant;
+    Compiled compiled;
+    std::vector<VariantPtr> stale;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto iter = entries_.find(entryKey(*key));
+        if (iter == entries_.end()) {
+            return nullptr;
+        }
+        lru_.splice(lru_.begin(), lru_, iter->second.lru);
+        auto& variants = iter->second.variants;
+        for (auto it = variants.begin(); it != variants.end();) {
+            if ((*it)->fingerprint != version) {
+                // The schemas or indexes changed
+                stale.emplace_back(std::move(*it));
+                it = variants.erase(it);
+                continue;
+            }
+            if (variant == nullptr && !(*it)->idle.empty() && match(**it, *key)) {
+                variant = *it;
+                compiled = std::move(variant->idle.back());
+                variant->idle.pop_back();
+            }
+            ++it;
+        }
+    }
+    if (variant == nullptr) {
+        return nullptr;
+    }
+
+    auto inputs = variant->inputs;
+    for (auto& binding : variant->bindings) {
+        auto& ds = inputs[binding.var].mutableDataSet();
+        ds.rows[binding.row].values[binding.col] = key->literals[binding.literal].value;
+    }
+    auto ectx = compiled.qctx->ectx();
+    for (auto& input : inputs) {
+        ectx->setValue(input.first, std::move(input.second));
+    }
+    key->variant = std::move(variant);
+    return std::make_unique<Compiled>(std::move(compiled));
+}
+
+void PlanCache::prepare(QueryContext* qctx, const Sentence* sentence, Key* key) {
+    if (!key->cacheable() || sentence->kind() != Sentence::Kind::kSequential) {
+        return;
+    }
+    auto sentences = static_cast<const SequentialSentences*>(sentence)->sentences();
+    if (sentences.size() != 1) {
+        return;
+    }
+    auto kind = sentences.front()->kind();
+    if (kind != Sentence::Kind::kGo && kind != Sentence::Kind::kFetchVertices &&
+        kind != Sentence::Kind::kFetchEdges) {
+        return;
+    }
+
+    auto variant = std::make_shared<Variant>();
+    for (auto& var : qctx->ectx()->valueMap_) {
+        if (!var.second.empty()) {
+            variant->inputs.emplace(var.first, var.second.back().value());
+        }
+    }
+
+    // Bind each literal to the only cell of the inputs with the same value
+    std::set<std::tuple<std::string, size_t, size_t>> bound;
+    for (size_t i = 0; i < key->literals.size(); ++i) {
+        const auto& literal = key->literals[i];
+        std::vector<Binding> cells;
+        for (auto& input : variant->inputs) {
+            if (!input.second.isDataSet()) {
+                continue;
+            }
+            const auto& rows = input.second.getDataSet().rows;
+            for (size_t row = 0; row < rows.size(); ++row) {
+                const auto& values = rows[row].values;
+                for (size_t col = 0; col < values.size(); ++col) {
+                    if (values[col].type() == literal.value.type() &&
+                        values[col] == literal.value) {
+                        cells.emplace_back(Binding{i, input.first, row, col});
+                    }
+                }
+            }
+        }
+        if (cells.size() > 1) {
+            return;
+        }
+        if (cells.empty()) {
+            variant->fixed.emplace_back(literal.text);
+            continue;
+        }
+        auto& cell = cells.front();
+        if (!bound.emplace(cell.var, cell.row, cell.col).second) {
+            return;
+        }
+        variant->fixed.emplace_back();
+        variant->bindings.emplace_back(std::move(cell));
+    }
+
+    if (!variant->bindings.empty() && !verify(qctx, *key, *variant)) {
+        VLOG(1) << "Literals are not the inputs of the query: " << key->query;
+        return;
+    }
+    variant->fingerprint = fingerprint(qctx, key->space);
+    key->variant = std::move(variant);
+}
+
+// static
+bool PlanCache::verify(QueryContext* qctx, const Key& key, const Variant& variant) {
+    // Substitute the bound literals by the other values
+    std::vector<Value> probes(key.literals.size());
+    for (auto& binding : variant.bindings) {
+        probes[binding.literal] = probeValue(key.literals[binding.literal].value);
+    }
+    const auto& query = qctx->rctx()->query();
+    std::string probeQuery;
+    size_t last = 0;
+    for (size_t i = 0; i < key.literals.size(); ++i) {
+        const auto& literal = key.literals[i];
+        probeQuery.append(query, last, literal.offset - last);
+        if (variant.fixed[i].empty()) {
+            probeQuery.append(toLiteral(probes[i], literal.text.front()));
+        } else {
+            probeQuery.append(literal.text);
+        }
+        last = literal.offset + literal.text.size();
+    }
+    probeQuery.append(query, last, std::string::npos);
+
+    // The validators need the session of the request
+    QueryContext probe(qctx->releaseRCtx(),
+                       qctx->schemaMng(),
+                       qctx->indexMng(),
+                       qctx->getStorageClient(),
+                       qctx->getMetaClient(),
+                       qctx->getCharsetInfo());
+    auto status = [&probe, &probeQuery]() -> Status {
+        auto result = GQLParser(&probe).parse(probeQuery);
+        NG_RETURN_IF_ERROR(result);
+        auto sentence = std::move(result).value();
+        return Validator::validate(sentence.get(), &probe);
+    }();
+    qctx->setRCtx(probe.releaseRCtx());
+    if (!status.ok()) {
+        return false;
+    }
+
+    // Only the bound cells change with the literals
+    auto ectx = probe.ectx();
+    for (auto& input : variant.inputs) {
+        auto expected = input.second;
+        for (auto& binding : variant.bindings) {
+            if (binding.var == input.first) {
+                expected.mutableDataSet().rows[binding.row].values[binding.col] =
+                    probes[binding.literal];
+            }
+        }
+        if (!ectx->exist(input.first) || !(ectx->getValue(input.first) == expected)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PlanCache::checkin(Key key, Compiled compiled) {
+    auto variant = std::move(key.variant);
+    if (variant == nullptr || FLAGS_plan_cache_capacity == 0) {
+        return;
+    }
+    // Release the results before the plan gets idle
+    compiled.qctx->resetExecution();
+
+    std::vector<VariantPtr> evicted;
+    std::lock_guard<std::mutex> guard(lock_);
+    auto name = entryKey(key);
+    auto iter = entries_.find(name);
+    if (iter == entries_.end()) {
+        while (entries_.size() >= FLAGS_plan_cache_capacity) {
+            auto lruIter = entries_.find(lru_.back());
+            for (auto& v : lruIter->second.variants) {
+                evicted.emplace_back(std::move(v));
+            }
+            entries_.erase(lruIter);
+            lru_.pop_back();
+        }
+        lru_.emplace_front(name);
+        iter = entries_.emplace(std::move(name), Entry{{}, lru_.begin()}).first;
+    } else {
+        lru_.splice(lru_.begin(), lru_, iter->second.lru);
+    }
+
+    auto& variants = iter->second.variants;
+    auto found = std::find(variants.begin(), variants.end(), variant);
+    if (found == variants.end()) {
+        // The same query may be compiled by the concurrent requests
+        found = std::find_if(variants.begin(), variants.end(), [&variant](const VariantPtr& v) {
+            return v->fingerprint == variant->fingerprint && v->fixed == variant->fixed;
+        });
+    }
+    if (found == variants.end()) {
+        if (variants.size() >= kMaxVariants) {
+            return;
+        }
+        variants.emplace_back(std::move(variant));
+        found = variants.end() - 1;
+    }
+    if ((*found)->idle.size() < FLAGS_plan_cache_instances) {
+        (*found)->idle.emplace_back(std::move(compiled));
+    }
+}
+
+// static
+std::string PlanCache::normalize(const std::string& query, std::vector<Literal>* literals) {
+    std::string result;
+    result.reserve(query.size());
+    size_t i = 0;
+    while (i < query.size()) {
+        char c = query[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!result.empty() && result.back() != ' ') {
+                result.push_back(' ');
+            }
+            ++i;
+            continue;
+        }
+        if (c == '#' || folly::StringPiece(query).subpiece(i, 2) == "//" ||
+            folly::StringPiece(query).subpiece(i, 2) == "/*" ||
+            folly::StringPiece(query).subpiece(i, 2) == "--") {
+            // The comments
+            return "";
+        }
+        if (c == '"' || c == '\'' || c == '`') {
+            auto end = i + 1;
+            bool escaped = false;
+            while (end < query.size() && query[end] != c) {
+                if (query[end] == '\\') {
+                    escaped = true;
+                    ++end;
+                }
+                ++end;
+            }
+            if (end >= query.size()) {
+                return "";
+            }
+            auto text = query.substr(i, end - i + 1);
+            if (c == '`' || escaped) {
+                // The names and the escaped strings are kept as they are
+                result.append(text);
+            } else {
+                auto value = query.substr(i + 1, end - i - 1);
+                literals->emplace_back(Literal{std::move(text), Value(std::move(value)), i});
+                result.append("?s");
+            }
+            i = end + 1;
+            continue;
+        }
+        if (!isIdentChar(c)) {
+            result.push_back(c);
+            ++i;
+            continue;
+        }
+        auto end = i;
+        while (end < query.size() && (isIdentChar(query[end]) || query[end] == '.')) {
+            ++end;
+        }
+        auto text = query.substr(i, end - i);
+        bool digits = std::all_of(text.begin(), text.end(), [](char ch) {
+            return std::isdigit(static_cast<unsigned char>(ch));
+        });
+        // The decimal integers, but not the digits in the names like `$-.1'
+        bool isInt = digits && (text.size() == 1 || text[0] != '0') &&
+                     (i == 0 || (query[i - 1] != '.' && query[i - 1] != '$'));
+        auto value = folly::tryTo<int64_t>(text);
+        if (isInt && value.hasValue()) {
+            literals->emplace_back(Literal{std::move(text), Value(value.value()), i});
+            result.append("?i");
+        } else {
+            result.append(text);
+        }
+        i = end;
+    }
+    if (!result.empty() && result.back() == ' ') {
+        result.pop_back();
+    }
+    return result;
+}
+
+uint64_t PlanCache::fingerprint(const QueryContext* qctx, GraphSpaceID space) {
+    auto now = std::chrono::steady_clock::now();
+    auto interval = std::chrono::milliseconds(FLAGS_plan_cache_schema_check_interval_ms);
+    {
+        std::lock_guard<std::mutex> guard(fingerprintLock_);
+        auto found = fingerprints_.find(space);
+        if (found != fingerprints_.end() && now - found->second.checked < interval) {
+            return found->second.version;
+        }
+    }
+    // Out of the lock, the concurrent ones may compute it as well
+    auto version = computeFingerprint(qctx, space);
+    std::lock_guard<std::mutex> guard(fingerprintLock_);
+    fingerprints_[space] = Fingerprint{version, now};
+    return version;
+}
+
+// static
+uint64_t PlanCache::computeFingerprint(const QueryContext* qctx, GraphSpaceID space) {
+    // Sum up the hashes, to be independent of the order of the schemas
+    uint64_t version = 0;
+    auto tags = qctx->schemaMng()->getAllLatestVerTagSchema(space);
+    if (tags.ok()) {
+        for (auto& tag : tags.value()) {
+            version += folly::hash::hash_combine(0, tag.first, tag.second->getVersion());
+        }
+    }
+    auto edges = qctx->schemaMng()->getAllLatestVerEdgeSchema(space);
+    if (edges.ok()) {
+        for (auto& edge : edges.value()) {
+            version += folly::hash::hash_combine(1, edge.first, edge.second->getVersion());
+        }
+    }
+    auto tagIndexes = qctx->indexMng()->getTagIndexes(space);
+    if (tagIndexes.ok()) {
+        for (auto& index : tagIndexes.value()) {
+            version += folly::hash::hash_combine(2, index->get_index_id());
+        }
+    }
+    auto edgeIndexes = qctx->indexMng()->getEdgeIndexes(space);
+    if (edgeIndexes.ok()) {
+        for (auto& index : edgeIndexes.value()) {
+            version += folly::hash::hash_combine(3, index->get_index_id());
+        }
+    }
+    return version;
+}
+
+// static
+bool PlanCache::match(const Variant& variant, const Key& key) {
+    if (variant.fixed.size() != key.literals.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < variant.fixed.size(); ++i) {
+        if (!variant.fixed[i].empty() && variant.fixed[i] != key.literals[i].text) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// static
+std::string PlanCache::entryKey(const Key& key) {
+    return folly::to<std::string>(key.space, ':', key.query);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,149 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef SERVICE_PLANCACHE_H_
+#define SERVICE_PLANCACHE_H_
+
+#include <chrono>
+#include <list>
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/cpp/helpers.h"
+#include "common/datatypes/Value.h"
+#include "context/QueryContext.h"
+#include "parser/Sentence.h"
+
+/**
+ * PlanCache keeps the optimized plans of the queries, so that the queries
+ * differing only in the literals skip the parsing, validation and optimization.
+ *
+ * The queries are normalized by replacing the integer and string literals with
+ * parameters. A plan is reused for the other literals only if they are the
+ * constant inputs set by the validators, e.g. the start vids of GO and the keys
+ * of FETCH. The other literals are baked into the plan, so they must be the same.
+ *
+ * Since the expressions and variables of a plan keep the states of execution,
+ * each cached plan is executed by one query at a time. The plans are dropped
+ * once the schemas or indexes of the space change, which are checked at most
+ * once per plan_cache_schema_check_interval_ms for each space.
+ */
+
+namespace nebula {
+namespace graph {
+
+class PlanCache final : public cpp::NonCopyable, public cpp::NonMovable {
+public:
+    // The literal replaced by a parameter
+    struct Literal {
+        std::string     text;
+        Value           value;
+        // The position in the query
+        size_t          offset{0};
+    };
+
+    struct Variant;
+
+    struct Key {
+        GraphSpaceID                    space{-1};
+        std::string                     query;
+        std::vector<Literal>            literals;
+        // The variant which the compiled query belongs to
+        std::shared_ptr<Variant>        variant;
+
+        bool cacheable() const {
+            return !query.empty();
+        }
+    };
+
+    // The parsed and optimized query
+    struct Compiled {
+        std::unique_ptr<QueryContext>   qctx;
+        std::unique_ptr<Sentence>       sentence;
+    };
+
+    PlanCache() = default;
+
+    // Normalize the query of `qctx'. The key is not cacheable if the query
+    // has no chance to be cached.
+    Key makeKey(const QueryContext* qctx) const;
+
+    // Take out an idle compiled query of the key, with the literals bound.
+    // Return nullptr if missed.
+    std::unique_ptr<Compiled> checkout(QueryContext* qctx, Key* key);
+
+    // Prepare to cache the query just compiled, before the execution changes
+    // the inputs.
+    void prepare(QueryContext* qctx, const Sentence* sentence, Key* key);
+
+    // Put the compiled query back after executed
+    void checkin(Key key, Compiled compiled);
+
+    // Replace the integer and string literals with the parameters, and collapse
+    // the blanks. Return an empty string if failed to normalize, e.g. the query
+    // has comments.
+    static std::string normalize(const std::string& query, std::vector<Literal>* literals);
+
+private:
+    struct Binding {
+        size_t          literal;
+        std::string     var;
+        size_t          row;
+        size_t          col;
+    };
+
+    using VariantPtr = std::shared_ptr<Variant>;
+
+    struct Entry {
+        std::vector<VariantPtr>                 variants;
+        std::list<std::string>::iterator        lru;
+    };
+
+    struct Fingerprint {
+        uint64_t                                version{0};
+        std::chrono::steady_clock::time_point   checked;
+    };
+
+    // The version of the schemas and indexes of the space, cached for a while
+    uint64_t fingerprint(const QueryContext* qctx, GraphSpaceID space);
+
+    // Walk through all the schemas and indexes of the space
+    static uint64_t computeFingerprint(const QueryContext* qctx, GraphSpaceID space);
+
+    static bool match(const Variant& variant, const Key& key);
+
+    // Validate the query again with the other values of the bound literals, to
+    // make sure that they are only the inputs, e.g. not folded with the others.
+    static bool verify(QueryContext* qctx, const Key& key, const Variant& variant);
+
+    static std::string entryKey(const Key& key);
+
+    // The max number of variants per normalized query, e.g. for different steps
+    static constexpr size_t kMaxVariants = 8;
+
+    std::mutex                                      lock_;
+    std::unordered_map<std::string, Entry>          entries_;
+    // The least recently used is at the back
+    std::list<std::string>                          lru_;
+
+    std::mutex                                      fingerprintLock_;
+    std::unordered_map<GraphSpaceID, Fingerprint>   fingerprints_;
+};
+
+struct PlanCache::Variant {
+    // The raw texts of the literals baked into the plan, empty for the bound ones
+    std::vector<std::string>                        fixed;
+    std::vector<Binding>                            bindings;
+    // The constant inputs set by the validators
+    std::unordered_map<std::string, Value>          inputs;
+    uint64_t                                        fingerprint{0};
+    std::vector<Compiled>                           idle;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // SERVICE_PLANCACHE_H_
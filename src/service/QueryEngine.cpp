@@ -38,6 +38,8 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
         rulesets.emplace_back(&opt::RuleSet::QueryRules());
     }
     optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
+    planCache_ = std::make_unique<PlanCache>();
+    admission_ = std::make_unique<AdmissionController>();
 
     return Status::OK();
 }
@@ -49,7 +51,10 @@ void QueryEngine::execute(RequestContextPtr rctx) {
                                                storage_.get(),
                                                metaClient_,
                                                charsetInfo_);
-    auto* instance = new QueryInstance(std::move(ectx), optimizer_.get());
+    auto* instance = new QueryInstance(std::move(ectx),
+                                       optimizer_.get(),
+                                       FLAGS_enable_plan_cache ? planCache_.get() : nullptr,
+                                       admission_.get());
     instance->execute();
 }
 
@@ -17,12 +17,15 @@
 #include "common/network/NetworkUtils.h"
 #include "common/charset/Charset.h"
 #include "optimizer/Optimizer.h"
+#include "service/AdmissionController.h"
+#include "service/PlanCache.h"
 #include <folly/executors/IOThreadPoolExecutor.h>
 
 /**
  * QueryEngine is responsible to create and manage ExecutionPlan.
- * For the time being, we don't have the execution plan cache support,
- * instead we create a plan for each query, and destroy it upon finish.
+ * The plans of GO and FETCH are cached by the normalized queries if the plan
+ * cache is enabled, otherwise we create a plan for each query, and destroy it
+ * upon finish.
  */
 
 namespace nebula {
@@ -48,6 +51,8 @@ private:
     std::unique_ptr<meta::IndexManager>               indexManager_;
     std::unique_ptr<storage::GraphStorageClient>      storage_;
     std::unique_ptr<opt::Optimizer>                   optimizer_;
+    std::unique_ptr<PlanCache>                        planCache_;
+    std::unique_ptr<AdmissionController>              admission_;
     meta::MetaClient                                 *metaClient_;
     CharsetInfo*                                      charsetInfo_{nullptr};
 };
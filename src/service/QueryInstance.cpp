@@ -14,6 +14,8 @@
 #include "planner/plan/ExecutionPlan.h"
 #include "planner/plan/PlanNode.h"
 #include "scheduler/Scheduler.h"
+#include "service/GraphFlags.h"
+#include "service/PermissionCheck.h"
 #include "stats/StatsDef.h"
 #include "util/AstUtils.h"
 #include "util/ScopedTimer.h"
@@ -27,9 +29,14 @@ using nebula::opt::RuleSet;
 namespace nebula {
 namespace graph {
 
-QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx, Optimizer *optimizer) {
+QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx,
+                             Optimizer *optimizer,
+                             PlanCache *planCache,
+                             AdmissionController *admission) {
     qctx_ = std::move(qctx);
     optimizer_ = DCHECK_NOTNULL(optimizer);
+    planCache_ = planCache;
+    admission_ = admission;
     scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
     qctx_->rctx()->session()->addQuery(qctx_.get());
 }
@@ -46,6 +53,26 @@ void QueryInstance::execute() {
         return;
     }
 
+    if (admission_ == nullptr) {
+        schedule();
+        return;
+    }
+    // Wait for the slots, and then run on the workers rather than the thread
+    // of the query releasing them
+    ticket_ = AdmissionController::makeTicket(qctx(), sentence_.get());
+    admission_->admit(ticket_, [qctx = qctx()]() { return qctx->isKilled(); })
+        .via(qctx()->rctx()->runner())
+        .thenValue([this](Status s) {
+            if (!s.ok()) {
+                onError(std::move(s));
+                return;
+            }
+            admitted_ = true;
+            schedule();
+        });
+}
+
+void QueryInstance::schedule() {
     scheduler_->schedule()
         .thenValue([this](Status s) {
             if (s.ok()) {
@@ -64,6 +91,17 @@ void QueryInstance::execute() {
 
 Status QueryInstance::validateAndOptimize() {
     auto *rctx = qctx()->rctx();
+    if (planCache_ != nullptr) {
+        cacheKey_ = planCache_->makeKey(qctx());
+        if (cacheKey_.cacheable()) {
+            auto compiled = planCache_->checkout(qctx(), &cacheKey_);
+            if (compiled != nullptr) {
+                VLOG(1) << "Hit plan cache: " << rctx->query();
+                return reuse(std::move(*compiled));
+            }
+        }
+    }
+
     VLOG(1) << "Parsing query: " << rctx->query();
     auto result = GQLParser(qctx()).parse(rctx->query());
     NG_RETURN_IF_ERROR(result);
@@ -72,6 +110,27 @@ Status QueryInstance::validateAndOptimize() {
     NG_RETURN_IF_ERROR(Validator::validate(sentence_.get(), qctx()));
     NG_RETURN_IF_ERROR(findBestPlan());
 
+    if (planCache_ != nullptr) {
+        planCache_->prepare(qctx(), sentence_.get(), &cacheKey_);
+    }
+    return Status::OK();
+}
+
+Status QueryInstance::reuse(PlanCache::Compiled compiled) {
+    auto session = qctx_->rctx()->session();
+    session->deleteQuery(qctx_.get());
+    compiled.qctx->setRCtx(qctx_->releaseRCtx());
+    qctx_ = std::move(compiled.qctx);
+    sentence_ = std::move(compiled.sentence);
+    scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
+    session->addQuery(qctx_.get());
+
+    // The cached plans are only of the single sentences
+    if (FLAGS_enable_authorize) {
+        auto sentences = static_cast<SequentialSentences *>(sentence_.get())->sentences();
+        NG_RETURN_IF_ERROR(PermissionCheck::permissionCheck(
+            session, sentences.front(), qctx_->vctx(), cacheKey_.space));
+    }
     return Status::OK();
 }
 
@@ -85,7 +144,15 @@ bool QueryInstance::explainOrContinue() {
     return static_cast<const ExplainSentence *>(sentence_.get())->isProfile();
 }
 
+void QueryInstance::release() {
+    if (admitted_) {
+        admitted_ = false;
+        admission_->release(ticket_);
+    }
+}
+
 void QueryInstance::onFinish() {
+    release();
     auto rctx = qctx()->rctx();
     VLOG(1) << "Finish query: " << rctx->query();
     auto &spaceName = rctx->session()->space().name;
@@ -99,6 +166,11 @@ void QueryInstance::onFinish() {
     rctx->finish();
 
     rctx->session()->deleteQuery(qctx_.get());
+    if (cacheKey_.variant != nullptr) {
+        // Keep the plan for the coming queries, without the finished request
+        qctx_->setRCtx(nullptr);
+        planCache_->checkin(std::move(cacheKey_), {std::move(qctx_), std::move(sentence_)});
+    }
     // The `QueryInstance' is the root node holding all resources during the execution.
     // When the whole query process is done, it's safe to release this object, as long as
     // no other contexts have chances to access these resources later on,
@@ -107,6 +179,7 @@ void QueryInstance::onFinish() {
 }
 
 void QueryInstance::onError(Status status) {
+    release();
     LOG(ERROR) << status;
     auto *rctx = qctx()->rctx();
     switch (status.code()) {
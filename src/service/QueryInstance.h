@@ -13,6 +13,8 @@
 #include "optimizer/Optimizer.h"
 #include "parser/GQLParser.h"
 #include "scheduler/Scheduler.h"
+#include "service/AdmissionController.h"
+#include "service/PlanCache.h"
 
 /**
  * QueryInstance coordinates the execution process,
@@ -25,7 +27,10 @@ namespace graph {
 
 class QueryInstance final : public cpp::NonCopyable, public cpp::NonMovable {
 public:
-    explicit QueryInstance(std::unique_ptr<QueryContext> qctx, opt::Optimizer* optimizer);
+    explicit QueryInstance(std::unique_ptr<QueryContext> qctx,
+                           opt::Optimizer* optimizer,
+                           PlanCache* planCache = nullptr,
+                           AdmissionController* admission = nullptr);
     ~QueryInstance() = default;
 
     void execute();
@@ -54,11 +59,21 @@ private:
     void addSlowQueryStats(uint64_t latency) const;
     void fillRespData(ExecutionResponse* resp);
     Status findBestPlan();
+    // Execute the query compiled by the previous one
+    Status reuse(PlanCache::Compiled compiled);
+    void schedule();
+    // Give back the slots taken by the query if it was admitted
+    void release();
 
     std::unique_ptr<Sentence>                   sentence_;
     std::unique_ptr<QueryContext>               qctx_;
     std::unique_ptr<Scheduler>                  scheduler_;
     opt::Optimizer*                             optimizer_{nullptr};
+    PlanCache*                                  planCache_{nullptr};
+    PlanCache::Key                              cacheKey_;
+    AdmissionController*                        admission_{nullptr};
+    AdmissionController::Ticket                 ticket_;
+    bool                                        admitted_{false};
 };
 
 }   // namespace graph
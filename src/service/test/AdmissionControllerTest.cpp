@@ -0,0 +1,350 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "common/base/Base.h"
+#include "context/QueryContext.h"
+#include "parser/GQLParser.h"
+#include "service/AdmissionController.h"
+#include "service/GraphFlags.h"
+#include "stats/StatsDef.h"
+
+namespace nebula {
+namespace graph {
+
+using Ticket = AdmissionController::Ticket;
+using Priority = AdmissionController::Priority;
+
+class AdmissionControllerTest : public testing::Test {
+protected:
+    static Ticket ticket(const std::string& user,
+                         GraphSpaceID space = 1,
+                         double cost = 1.0,
+                         Priority priority = Priority::kShort) {
+        Ticket ticket;
+        ticket.user = user;
+        ticket.space = space;
+        ticket.cost = cost;
+        ticket.priority = priority;
+        return ticket;
+    }
+
+    static Ticket longTicket(const std::string& user, double cost) {
+        return ticket(user, 1, cost, Priority::kLong);
+    }
+
+    static bool admitted(folly::SemiFuture<Status>& future) {
+        return future.isReady() && future.value().ok();
+    }
+
+    static bool rejected(folly::SemiFuture<Status>& future) {
+        return future.isReady() && !future.value().ok();
+    }
+
+    AdmissionController admission_;
+};
+
+TEST_F(AdmissionControllerTest, AdmitAllByDefault) {
+    std::vector<folly::SemiFuture<Status>> futures;
+    for (auto i = 0; i < 10; ++i) {
+        futures.emplace_back(admission_.admit(longTicket("root", 1e9)));
+    }
+    for (auto& future : futures) {
+        EXPECT_TRUE(admitted(future));
+    }
+}
+
+TEST_F(AdmissionControllerTest, AlwaysAdmitIfNothingRunning) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries = 1;
+    FLAGS_max_running_query_cost = 10;
+
+    // Beyond the cost limit on its own
+    auto t = longTicket("root", 100);
+    auto future = admission_.admit(t);
+    EXPECT_TRUE(admitted(future));
+    admission_.release(t);
+    future = admission_.admit(t);
+    EXPECT_TRUE(admitted(future));
+    admission_.release(t);
+}
+
+TEST_F(AdmissionControllerTest, SlotsOfGraphd) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries = 2;
+
+    auto t = ticket("root");
+    auto f1 = admission_.admit(t);
+    auto f2 = admission_.admit(t);
+    auto f3 = admission_.admit(t);
+    auto f4 = admission_.admit(t);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_TRUE(admitted(f2));
+    EXPECT_FALSE(f3.isReady());
+    EXPECT_FALSE(f4.isReady());
+
+    // The release wakes up the waiters in the order of the arrivals
+    admission_.release(t);
+    EXPECT_TRUE(admitted(f3));
+    EXPECT_FALSE(f4.isReady());
+    admission_.release(t);
+    EXPECT_TRUE(admitted(f4));
+    admission_.release(t);
+    admission_.release(t);
+}
+
+TEST_F(AdmissionControllerTest, SlotsOfUser) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries_per_user = 1;
+
+    auto a = ticket("a");
+    auto b = ticket("b");
+    auto f1 = admission_.admit(a);
+    auto f2 = admission_.admit(a);
+    // Not blocked by the waiter of the other user
+    auto f3 = admission_.admit(b);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+    EXPECT_TRUE(admitted(f3));
+
+    admission_.release(b);
+    EXPECT_FALSE(f2.isReady());
+    admission_.release(a);
+    EXPECT_TRUE(admitted(f2));
+    admission_.release(a);
+}
+
+TEST_F(AdmissionControllerTest, SlotsOfSpace) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries_per_space = 1;
+
+    auto s1 = ticket("root", 1);
+    auto s2 = ticket("root", 2);
+    auto f1 = admission_.admit(s1);
+    auto f2 = admission_.admit(s1);
+    auto f3 = admission_.admit(s2);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+    EXPECT_TRUE(admitted(f3));
+
+    admission_.release(s1);
+    EXPECT_TRUE(admitted(f2));
+    admission_.release(s1);
+    admission_.release(s2);
+}
+
+TEST_F(AdmissionControllerTest, ShortBeforeLong) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries = 1;
+
+    auto s = ticket("root");
+    auto l = longTicket("root", 1e6);
+    auto f1 = admission_.admit(s);
+    auto f2 = admission_.admit(l);
+    auto f3 = admission_.admit(s);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+    EXPECT_FALSE(f3.isReady());
+
+    // The short one arriving later runs first
+    admission_.release(s);
+    EXPECT_FALSE(f2.isReady());
+    EXPECT_TRUE(admitted(f3));
+    admission_.release(s);
+    EXPECT_TRUE(admitted(f2));
+    admission_.release(l);
+}
+
+TEST_F(AdmissionControllerTest, CostLimit) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_query_cost = 100;
+
+    auto l1 = longTicket("root", 80);
+    auto l2 = longTicket("root", 50);
+    auto l3 = longTicket("root", 20);
+    auto s = ticket("root", 1, 10);
+    auto f1 = admission_.admit(l1);
+    auto f2 = admission_.admit(l2);
+    auto f3 = admission_.admit(l3);
+    // The short queries are not limited by the cost
+    auto f4 = admission_.admit(s);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+    EXPECT_TRUE(admitted(f3));
+    EXPECT_TRUE(admitted(f4));
+
+    admission_.release(l1);
+    EXPECT_TRUE(admitted(f2));
+    admission_.release(l2);
+    admission_.release(l3);
+    admission_.release(s);
+}
+
+TEST_F(AdmissionControllerTest, RejectIfQueueFull) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries_per_user = 1;
+    FLAGS_max_queued_queries = 1;
+
+    auto a = ticket("a");
+    auto b = ticket("b");
+    auto f1 = admission_.admit(a);
+    auto f2 = admission_.admit(a);
+    auto f3 = admission_.admit(a);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+    EXPECT_TRUE(rejected(f3));
+
+    // Still admitted at once while the queue is full
+    auto f4 = admission_.admit(b);
+    EXPECT_TRUE(admitted(f4));
+
+    admission_.release(a);
+    EXPECT_TRUE(admitted(f2));
+    // The queue has room again
+    auto f5 = admission_.admit(a);
+    EXPECT_FALSE(f5.isReady());
+    admission_.release(a);
+    EXPECT_TRUE(admitted(f5));
+    admission_.release(a);
+    admission_.release(b);
+}
+
+TEST_F(AdmissionControllerTest, DataQueriesOnly) {
+    QueryContext qctx;
+    auto isDataQuery = [&qctx](const std::string& query) {
+        auto result = GQLParser(&qctx).parse(query);
+        CHECK(result.ok()) << result.status();
+        return AdmissionController::isDataQuery(result.value().get());
+    };
+    EXPECT_TRUE(isDataQuery("GO FROM \"a\" OVER like"));
+    EXPECT_TRUE(isDataQuery("GO FROM \"a\" OVER like YIELD like._dst AS id | "
+                            "FETCH PROP ON player $-.id"));
+    EXPECT_TRUE(isDataQuery("$v = LOOKUP ON player; YIELD $v.VertexID"));
+    EXPECT_TRUE(isDataQuery("MATCH (v:player) RETURN v"));
+    EXPECT_TRUE(isDataQuery("PROFILE FIND SHORTEST PATH FROM \"a\" TO \"b\" OVER like"));
+    EXPECT_TRUE(isDataQuery("GET SUBGRAPH FROM \"a\""));
+    EXPECT_TRUE(isDataQuery("USE nba; GO FROM \"a\" OVER like"));
+    EXPECT_FALSE(isDataQuery("KILL QUERY (session=1, plan=2)"));
+    EXPECT_FALSE(isDataQuery("SHOW QUERIES"));
+    EXPECT_FALSE(isDataQuery("SHOW SPACES"));
+    EXPECT_FALSE(isDataQuery("USE nba"));
+    EXPECT_FALSE(isDataQuery("YIELD 1"));
+}
+
+TEST_F(AdmissionControllerTest, KillThroughSaturated) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries = 1;
+    FLAGS_max_queued_queries = 1;
+
+    auto t = ticket("root");
+    auto f1 = admission_.admit(t);
+    auto f2 = admission_.admit(t);
+    auto f3 = admission_.admit(t);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+    EXPECT_TRUE(rejected(f3));
+
+    // The KILL QUERY neither waits nor takes the slot of the query it stops
+    auto kill = ticket("root");
+    kill.exempt = true;
+    auto f4 = admission_.admit(kill);
+    EXPECT_TRUE(admitted(f4));
+    admission_.release(kill);
+    EXPECT_FALSE(f2.isReady());
+
+    admission_.release(t);
+    EXPECT_TRUE(admitted(f2));
+    admission_.release(t);
+}
+
+TEST_F(AdmissionControllerTest, KilledWhileQueued) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries = 1;
+
+    auto t = ticket("root");
+    std::atomic<bool> killed{false};
+    auto f1 = admission_.admit(t);
+    auto f2 = admission_.admit(t, [&killed]() { return killed.load(); });
+    auto f3 = admission_.admit(t);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+
+    killed = true;
+    admission_.tick();
+    EXPECT_TRUE(rejected(f2));
+    EXPECT_FALSE(f3.isReady());
+
+    // The killed one takes no slot
+    admission_.release(t);
+    EXPECT_TRUE(admitted(f3));
+    admission_.release(t);
+}
+
+TEST_F(AdmissionControllerTest, PromoteAgedLongQueries) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_query_cost = 100;
+    FLAGS_long_query_max_queued_ms = 1;
+
+    auto l1 = longTicket("root", 80);
+    auto l2 = longTicket("root", 50);
+    auto f1 = admission_.admit(l1);
+    auto f2 = admission_.admit(l2);
+    EXPECT_TRUE(admitted(f1));
+    EXPECT_FALSE(f2.isReady());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    admission_.tick();
+    EXPECT_TRUE(admitted(f2));
+    admission_.release(l1);
+    admission_.release(l2);
+}
+
+TEST_F(AdmissionControllerTest, ConcurrentAdmitAndRelease) {
+    gflags::FlagSaver saver;
+    FLAGS_max_running_queries = 4;
+    FLAGS_max_queued_queries = 0;
+
+    constexpr auto kNumThreads = 8;
+    constexpr auto kNumQueries = 100;
+    std::atomic<size_t> running{0};
+    std::atomic<size_t> maxRunning{0};
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&, i]() {
+            auto t = ticket(folly::stringPrintf("user%d", i));
+            for (auto j = 0; j < kNumQueries; ++j) {
+                auto status = admission_.admit(t).get();
+                ASSERT_TRUE(status.ok());
+                auto n = ++running;
+                auto max = maxRunning.load();
+                while (n > max && !maxRunning.compare_exchange_weak(max, n)) {
+                }
+                --running;
+                admission_.release(t);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(maxRunning.load(), 4);
+}
+
+}   // namespace graph
+}   // namespace nebula
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    nebula::initCounters();
+
+    return RUN_ALL_TESTS();
+}
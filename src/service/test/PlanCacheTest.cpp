@@ -0,0 +1,225 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "context/QueryContext.h"
+#include "parser/GQLParser.h"
+#include "planner/PlannersRegister.h"
+#include "service/GraphFlags.h"
+#include "service/PlanCache.h"
+#include "validator/Validator.h"
+#include "validator/test/MockIndexManager.h"
+#include "validator/test/MockSchemaManager.h"
+
+namespace nebula {
+namespace graph {
+
+class PlanCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        meta::cpp2::Session session;
+        session.set_session_id(0);
+        session.set_user_name("root");
+        session_ = ClientSession::create(std::move(session), nullptr);
+        SpaceInfo spaceInfo;
+        spaceInfo.name = "test_space";
+        spaceInfo.id = 1;
+        spaceInfo.spaceDesc.set_space_name("test_space");
+        session_->setSpace(std::move(spaceInfo));
+        schemaMng_ = CHECK_NOTNULL(MockSchemaManager::makeUnique());
+        indexMng_ = CHECK_NOTNULL(MockIndexManager::makeUnique());
+        PlannersRegister::registPlanners();
+    }
+
+    std::unique_ptr<QueryContext> buildContext(const std::string& query) {
+        auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+        rctx->setSession(session_);
+        rctx->setQuery(query);
+        auto qctx = std::make_unique<QueryContext>();
+        qctx->setRCtx(std::move(rctx));
+        qctx->setSchemaManager(schemaMng_.get());
+        qctx->setIndexManager(indexMng_.get());
+        qctx->setCharsetInfo(CharsetInfo::instance());
+        return qctx;
+    }
+
+    // Compile the query as a miss of the cache does, and cache it as executed
+    ::testing::AssertionResult compile(const std::string& query,
+                                       PlanCache::Key* key = nullptr) {
+        auto qctx = buildContext(query);
+        auto k = cache_.makeKey(qctx.get());
+        if (!k.cacheable()) {
+            return ::testing::AssertionFailure() << "Not cacheable: " << query;
+        }
+        if (cache_.checkout(qctx.get(), &k) != nullptr) {
+            return ::testing::AssertionFailure() << "Unexpected hit: " << query;
+        }
+        auto result = GQLParser(qctx.get()).parse(query);
+        if (!result.ok()) {
+            return ::testing::AssertionFailure() << result.status();
+        }
+        auto sentence = std::move(result).value();
+        auto status = Validator::validate(sentence.get(), qctx.get());
+        if (!status.ok()) {
+            return ::testing::AssertionFailure() << status;
+        }
+        cache_.prepare(qctx.get(), sentence.get(), &k);
+        if (k.variant == nullptr) {
+            return ::testing::AssertionFailure() << "Not prepared: " << query;
+        }
+        if (key != nullptr) {
+            *key = k;
+        }
+        // The results of the execution
+        qctx->ectx()->setValue("__result", Value(1));
+        qctx->markKilled();
+        qctx->setRCtx(nullptr);
+        cache_.checkin(std::move(k), {std::move(qctx), std::move(sentence)});
+        return ::testing::AssertionSuccess();
+    }
+
+    std::unique_ptr<PlanCache::Compiled> checkout(const std::string& query,
+                                                  PlanCache::Key* key) {
+        auto qctx = buildContext(query);
+        *key = cache_.makeKey(qctx.get());
+        auto compiled = cache_.checkout(qctx.get(), key);
+        if (compiled != nullptr) {
+            compiled->qctx->setRCtx(qctx->releaseRCtx());
+        }
+        return compiled;
+    }
+
+    void checkin(PlanCache::Key key, std::unique_ptr<PlanCache::Compiled> compiled) {
+        compiled->qctx->setRCtx(nullptr);
+        cache_.checkin(std::move(key), std::move(*compiled));
+    }
+
+    std::shared_ptr<ClientSession>        session_;
+    std::unique_ptr<MockSchemaManager>    schemaMng_;
+    std::unique_ptr<MockIndexManager>     indexMng_;
+    PlanCache                             cache_;
+};
+
+TEST_F(PlanCacheTest, Normalize) {
+    std::vector<PlanCache::Literal> literals;
+    EXPECT_EQ("GO ?i STEPS FROM ?s OVER like YIELD like._dst",
+              PlanCache::normalize("GO  2 STEPS FROM \"Tim\"\n OVER like YIELD like._dst",
+                                   &literals));
+    ASSERT_EQ(2u, literals.size());
+    EXPECT_EQ(Value(2), literals[0].value);
+    EXPECT_EQ(Value("Tim"), literals[1].value);
+    EXPECT_EQ("\"Tim\"", literals[1].text);
+
+    // The names are kept
+    literals.clear();
+    EXPECT_EQ("GO FROM $-.id OVER `like`",
+              PlanCache::normalize("GO FROM $-.id OVER `like`", &literals));
+    EXPECT_TRUE(literals.empty());
+
+    // The comments are not normalized
+    literals.clear();
+    EXPECT_EQ("", PlanCache::normalize("GO FROM \"Tim\" OVER like # comment", &literals));
+}
+
+TEST_F(PlanCacheTest, HitWithOtherInputs) {
+    PlanCache::Key prepared;
+    ASSERT_TRUE(compile("GO FROM \"Tim\" OVER like", &prepared));
+    ASSERT_FALSE(prepared.variant->bindings.empty());
+
+    PlanCache::Key key;
+    auto compiled = checkout("GO FROM \"Tony\" OVER like", &key);
+    ASSERT_NE(nullptr, compiled);
+    // The start vid is bound to the literal of the query
+    auto ectx = compiled->qctx->ectx();
+    for (auto& binding : prepared.variant->bindings) {
+        ASSERT_TRUE(ectx->exist(binding.var));
+        const auto& value = ectx->getValue(binding.var);
+        ASSERT_TRUE(value.isDataSet());
+        EXPECT_EQ(Value("Tony"), value.getDataSet().rows[binding.row].values[binding.col]);
+    }
+
+    // Taken out, so missed until checked in again
+    PlanCache::Key other;
+    EXPECT_EQ(nullptr, checkout("GO FROM \"Tim\" OVER like", &other));
+    checkin(std::move(key), std::move(compiled));
+    EXPECT_NE(nullptr, checkout("GO FROM \"Tim\" OVER like", &other));
+}
+
+TEST_F(PlanCacheTest, Miss) {
+    ASSERT_TRUE(compile("GO FROM \"Tim\" OVER like"));
+
+    PlanCache::Key key;
+    // Other queries
+    EXPECT_EQ(nullptr, checkout("GO FROM \"Tim\" OVER like REVERSELY", &key));
+    EXPECT_EQ(nullptr, checkout("GO FROM \"Tim\" OVER like YIELD like._dst", &key));
+    // Not cached
+    EXPECT_FALSE(cache_.makeKey(buildContext("YIELD 1").get()).cacheable());
+
+    // The steps are baked into the plan
+    ASSERT_TRUE(compile("GO 2 STEPS FROM \"Tim\" OVER like"));
+    EXPECT_EQ(nullptr, checkout("GO 3 STEPS FROM \"Tim\" OVER like", &key));
+    EXPECT_NE(nullptr, checkout("GO 2 STEPS FROM \"Tony\" OVER like", &key));
+}
+
+TEST_F(PlanCacheTest, InvalidateOnSchemaChange) {
+    gflags::FlagSaver saver;
+    FLAGS_plan_cache_schema_check_interval_ms = 0;
+
+    ASSERT_TRUE(compile("GO FROM \"Tim\" OVER like"));
+
+    // ALTER TAG person
+    auto person = std::make_shared<meta::NebulaSchemaProvider>(1);
+    person->addField("name", meta::cpp2::PropertyType::STRING);
+    person->addField("age", meta::cpp2::PropertyType::INT8);
+    person->addField("email", meta::cpp2::PropertyType::STRING);
+    schemaMng_->setTagSchema(1, 2, std::move(person));
+
+    // The plan compiled on the old schema is dropped
+    PlanCache::Key key;
+    EXPECT_EQ(nullptr, checkout("GO FROM \"Tim\" OVER like", &key));
+    ASSERT_TRUE(compile("GO FROM \"Tim\" OVER like"));
+    EXPECT_NE(nullptr, checkout("GO FROM \"Tony\" OVER like", &key));
+}
+
+TEST_F(PlanCacheTest, FingerprintCached) {
+    gflags::FlagSaver saver;
+    FLAGS_plan_cache_schema_check_interval_ms = 3600 * 1000;
+
+    ASSERT_TRUE(compile("GO FROM \"Tim\" OVER like"));
+    auto person = std::make_shared<meta::NebulaSchemaProvider>(1);
+    person->addField("name", meta::cpp2::PropertyType::STRING);
+    schemaMng_->setTagSchema(1, 2, std::move(person));
+
+    // The schemas are not walked through again within the interval
+    PlanCache::Key key;
+    EXPECT_NE(nullptr, checkout("GO FROM \"Tony\" OVER like", &key));
+}
+
+TEST_F(PlanCacheTest, ResetExecution) {
+    ASSERT_TRUE(compile("GO FROM \"Tim\" OVER like"));
+
+    PlanCache::Key key;
+    auto compiled = checkout("GO FROM \"Tony\" OVER like", &key);
+    ASSERT_NE(nullptr, compiled);
+    auto* qctx = compiled->qctx.get();
+    // Neither the results nor the states of the last execution are left
+    EXPECT_FALSE(qctx->ectx()->exist("__result"));
+    EXPECT_FALSE(qctx->isKilled());
+    EXPECT_NE(nullptr, qctx->plan()->root());
+}
+
+}   // namespace graph
+}   // namespace nebula
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
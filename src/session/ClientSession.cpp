@@ -85,6 +85,24 @@ void ClientSession::markQueryKilled(nebula::ExecutionPlanID epId) {
     VLOG(1) << "Mark query killed in meta, epId: " << epId;
 }
 
+int64_t ClientSession::memory() {
+    folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
+    int64_t memory = 0;
+    for (auto& context : contexts_) {
+        memory += context.second->ectx()->memory();
+    }
+    return memory;
+}
+
+int64_t ClientSession::peakMemory(nebula::ExecutionPlanID epId) {
+    folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
+    auto context = contexts_.find(epId);
+    if (context == contexts_.end()) {
+        return -1;
+    }
+    return context->second->ectx()->peakMemory();
+}
+
 void ClientSession::markAllQueryKilled() {
     folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
     for (auto& context : contexts_) {
@@ -140,6 +140,12 @@ public:
 
     void markAllQueryKilled();
 
+    // The estimated memory held by the running queries
+    int64_t memory();
+
+    // The peak memory of the running query, -1 if not found
+    int64_t peakMemory(nebula::ExecutionPlanID epId);
+
 private:
     ClientSession() = default;
 
@@ -20,6 +20,8 @@ stats::CounterId kNumSlowQueries;
 stats::CounterId kNumQueryErrors;
 stats::CounterId kQueryLatencyUs;
 stats::CounterId kSlowQueryLatencyUs;
+stats::CounterId kNumQueuedQueries;
+stats::CounterId kNumRejectedQueries;
 
 void initCounters() {
     kNumQueries = stats::StatsManager::registerStats("num_queries", "rate, sum");
@@ -29,6 +31,8 @@ void initCounters() {
         "query_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
     kSlowQueryLatencyUs = stats::StatsManager::registerHisto(
         "slow_query_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
+    kNumQueuedQueries = stats::StatsManager::registerStats("num_queued_queries", "rate, sum");
+    kNumRejectedQueries = stats::StatsManager::registerStats("num_rejected_queries", "rate, sum");
 }
 
 }  // namespace nebula
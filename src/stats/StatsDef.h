@@ -20,6 +20,8 @@ extern stats::CounterId kNumSlowQueries;
 extern stats::CounterId kNumQueryErrors;
 extern stats::CounterId kQueryLatencyUs;
 extern stats::CounterId kSlowQueryLatencyUs;
+extern stats::CounterId kNumQueuedQueries;
+extern stats::CounterId kNumRejectedQueries;
 
 void initCounters();
 
@@ -20,6 +20,7 @@ constexpr char kEdgeStr[]     = "_edge";
 constexpr char kEdgesStr[]    = "_edges";
 constexpr char kPathStr[]     = "_path";
 constexpr char kCostStr[]     = "_cost";
+constexpr char kParentStr[]   = "_parent";
 
 /**
  * An utility to generate an anonymous column name.
@@ -0,0 +1,58 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/Arena.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+char* alignUp(char* ptr, size_t align) {
+    DCHECK_EQ(align & (align - 1), 0);
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    return reinterpret_cast<char*>((addr + align - 1) & ~(static_cast<uintptr_t>(align) - 1));
+}
+
+}   // namespace
+
+void* Arena::allocate(size_t size, size_t align) {
+    if (ptr_ != nullptr) {
+        auto* ptr = alignUp(ptr_, align);
+        if (ptr + size <= end_) {
+            ptr_ = ptr + size;
+            return ptr;
+        }
+    }
+    return allocateInNewChunk(size, align);
+}
+
+void* Arena::allocateInNewChunk(size_t size, size_t align) {
+    auto chunkSize = std::max(nextChunkSize_, size + align);
+    nextChunkSize_ = std::min(nextChunkSize_ * 2, kMaxChunkSize);
+    chunks_.emplace_back(new char[chunkSize]);
+    size_ += chunkSize;
+
+    auto* ptr = alignUp(chunks_.back().get(), align);
+    auto* end = chunks_.back().get() + chunkSize;
+    // Keep carving the chunk with more room left, the oversized one is used up
+    if (ptr_ == nullptr || end - (ptr + size) > end_ - ptr_) {
+        ptr_ = ptr + size;
+        end_ = end;
+    }
+    return ptr;
+}
+
+void Arena::reset() {
+    chunks_.clear();
+    ptr_ = nullptr;
+    end_ = nullptr;
+    nextChunkSize_ = kMinChunkSize;
+    size_ = 0;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_ARENA_H_
+#define UTIL_ARENA_H_
+
+#include "common/base/Base.h"
+#include "common/cpp/helpers.h"
+
+namespace nebula {
+namespace graph {
+
+// Bump allocator of the memory living as long as a call of an executor, e.g. the nodes
+// of the hash sets built by it.
+//
+// The memory is carved from the chunks in turn and never freed one by one,
+// all the chunks are released at once when the arena is reset or destroyed.
+// So the many small allocations neither contend on the global allocator with
+// the other queries nor take time to free one by one.
+//
+// Not thread safe, so each thread allocates from an arena of its own without locking.
+class Arena final : public cpp::NonCopyable, public cpp::NonMovable {
+public:
+    Arena() = default;
+
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    // The bytes of the chunks held
+    size_t size() const {
+        return size_;
+    }
+
+    // Release all the chunks, the memory allocated must not be used any more
+    void reset();
+
+private:
+    static constexpr size_t kMinChunkSize = 64 * 1024;
+    static constexpr size_t kMaxChunkSize = 16 * 1024 * 1024;
+
+    // Start a new chunk for `size' bytes aligned by `align'
+    void* allocateInNewChunk(size_t size, size_t align);
+
+    std::vector<std::unique_ptr<char[]>>    chunks_;
+    char*                                   ptr_{nullptr};
+    char*                                   end_{nullptr};
+    // The chunks grow along with the arena, up to kMaxChunkSize
+    size_t                                  nextChunkSize_{kMinChunkSize};
+    size_t                                  size_{0};
+};
+
+// The STL allocator on an arena, deallocating is a no-op
+template <typename T>
+class ArenaAllocator final {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena* arena) : arena_(DCHECK_NOTNULL(arena)) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}   // NOLINT
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    Arena* arena() const {
+        return arena_;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena_ == other.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return arena_ != other.arena();
+    }
+
+private:
+    Arena*      arena_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_ARENA_H_
@@ -0,0 +1,151 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_FLATHASHMAP_H_
+#define UTIL_FLATHASHMAP_H_
+
+#include <folly/hash/Hash.h>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace graph {
+
+// Open addressing hash map with linear probing.
+//
+// The hash of the key is computed once by the caller and kept in both the slot
+// and the entry, so probing skips the key comparisons of the mismatched slots,
+// and neither growing the table nor moving the entries to another map hashes
+// the keys again. The entries are kept densely in insertion order.
+//
+// The pointers to the values are invalidated by the following insertion.
+template <typename K,
+          typename V,
+          typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class FlatHashMap final {
+public:
+    struct Entry {
+        size_t  hash;
+        K       key;
+        V       value;
+    };
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(size_t expected) {
+        reserve(expected);
+    }
+
+    static size_t hash(const K& key) {
+        return Hash()(key);
+    }
+
+    size_t size() const {
+        return entries_.size();
+    }
+
+    bool empty() const {
+        return entries_.empty();
+    }
+
+    void reserve(size_t expected) {
+        entries_.reserve(expected);
+        size_t capacity = kMinCapacity;
+        while (capacity < expected * 2) {
+            capacity <<= 1;
+        }
+        if (capacity > slots_.size()) {
+            rehash(capacity);
+        }
+    }
+
+    // Return nullptr if `key' whose hash is `h' does not exist
+    V* find(const K& key, size_t h) {
+        if (slots_.empty()) {
+            return nullptr;
+        }
+        for (auto pos = position(h);; pos = (pos + 1) & mask_) {
+            const auto& slot = slots_[pos];
+            if (slot.index == kEmptySlot) {
+                return nullptr;
+            }
+            if (slot.hash == h && KeyEqual()(entries_[slot.index].key, key)) {
+                return &entries_[slot.index].value;
+            }
+        }
+    }
+
+    const V* find(const K& key, size_t h) const {
+        return const_cast<FlatHashMap*>(this)->find(key, h);
+    }
+
+    // Insert the default value if `key' whose hash is `h' does not exist.
+    // Return the value of the key and whether it is inserted.
+    template <typename Key>
+    std::pair<V*, bool> tryEmplace(Key&& key, size_t h) {
+        if ((entries_.size() + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+        }
+        auto pos = position(h);
+        for (;; pos = (pos + 1) & mask_) {
+            const auto& slot = slots_[pos];
+            if (slot.index == kEmptySlot) {
+                break;
+            }
+            if (slot.hash == h && KeyEqual()(entries_[slot.index].key, key)) {
+                return std::make_pair(&entries_[slot.index].value, false);
+            }
+        }
+        slots_[pos] = Slot{h, entries_.size()};
+        entries_.emplace_back(Entry{h, std::forward<Key>(key), V()});
+        return std::make_pair(&entries_.back().value, true);
+    }
+
+    std::vector<Entry>& entries() {
+        return entries_;
+    }
+
+    const std::vector<Entry>& entries() const {
+        return entries_;
+    }
+
+private:
+    static constexpr size_t kMinCapacity = 16;
+    static constexpr size_t kEmptySlot = std::numeric_limits<size_t>::max();
+
+    struct Slot {
+        size_t  hash;
+        size_t  index;
+    };
+
+    size_t position(size_t h) const {
+        // Mix the bits since the hash of integers is the identity
+        return folly::hash::twang_mix64(h) & mask_;
+    }
+
+    void rehash(size_t capacity) {
+        DCHECK_EQ(capacity & (capacity - 1), 0);
+        slots_.assign(capacity, Slot{0, kEmptySlot});
+        mask_ = capacity - 1;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            auto pos = position(entries_[i].hash);
+            while (slots_[pos].index != kEmptySlot) {
+                pos = (pos + 1) & mask_;
+            }
+            slots_[pos] = Slot{entries_[i].hash, i};
+        }
+    }
+
+    std::vector<Slot>       slots_;
+    std::vector<Entry>      entries_;
+    size_t                  mask_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_FLATHASHMAP_H_
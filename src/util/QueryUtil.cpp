@@ -73,6 +73,7 @@ PlanNode* QueryUtil::extractDstFromGN(QueryContext* qctx, PlanNode* gn, const st
     auto* project = Project::make(qctx, gn, columns);
 
     auto* dedup = Dedup::make(qctx, project);
+    dedup->setVidFrontier();
     dedup->setOutputVar(output);
     return dedup;
 }
@@ -0,0 +1,154 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/SortKey.h"
+
+#include <folly/lang/Bits.h>
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+enum Tag : uint8_t {
+    kEmpty = 0x01,
+    kBool = 0x02,
+    kInt = 0x03,
+    kString = 0x04,
+    kNull = 0x05,
+};
+
+void appendUint64(uint64_t val, std::string* key) {
+    auto be = folly::Endian::big(val);
+    key->append(reinterpret_cast<const char*>(&be), sizeof(be));
+}
+
+}   // namespace
+
+// static
+bool SortKey::encodable(std::vector<Row>::const_iterator begin,
+                        std::vector<Row>::const_iterator end,
+                        const OrderFactors& factors) {
+    std::vector<const Row*> rows;
+    rows.reserve(end - begin);
+    for (auto it = begin; it != end; ++it) {
+        rows.emplace_back(&*it);
+    }
+    return encodable(rows, factors);
+}
+
+// static
+bool SortKey::encodable(const std::vector<const Row*>& rows, const OrderFactors& factors) {
+    for (auto& factor : factors) {
+        for (auto* row : rows) {
+            switch ((*row)[factor.first].type()) {
+                case Value::Type::__EMPTY__:
+                case Value::Type::NULLVALUE:
+                case Value::Type::BOOL:
+                case Value::Type::INT:
+                case Value::Type::STRING:
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+// static
+void SortKey::encode(const Row& row, const OrderFactors& factors, std::string* key) {
+    key->clear();
+    for (auto& factor : factors) {
+        encodeValue(row[factor.first], factor.second == OrderFactor::OrderType::DESCEND, key);
+    }
+}
+
+// static
+void SortKey::encodeValue(const Value& val, bool desc, std::string* key) {
+    auto start = key->size();
+    switch (val.type()) {
+        case Value::Type::__EMPTY__:
+            key->push_back(kEmpty);
+            break;
+        case Value::Type::NULLVALUE:
+            // All kinds of null are ordered equally
+            key->push_back(kNull);
+            break;
+        case Value::Type::BOOL:
+            key->push_back(kBool);
+            key->push_back(val.getBool() ? 1 : 0);
+            break;
+        case Value::Type::INT:
+            key->push_back(kInt);
+            appendUint64(static_cast<uint64_t>(val.getInt()) ^ (1ULL << 63), key);
+            break;
+        case Value::Type::STRING: {
+            key->push_back(kString);
+            for (auto c : val.getStr()) {
+                key->push_back(c);
+                if (c == '\0') {
+                    key->push_back('\xFF');
+                }
+            }
+            key->push_back('\0');
+            key->push_back('\0');
+            break;
+        }
+        default:
+            LOG(FATAL) << "Unencodable sort key type: " << val.type();
+    }
+    if (desc) {
+        // The encoding of the values is prefix free, so inverting the bytes reverses the order
+        for (auto i = start; i < key->size(); ++i) {
+            (*key)[i] = ~(*key)[i];
+        }
+    }
+}
+
+RowIndexComparator::RowIndexComparator(const std::vector<Row>& rows,
+                                       const std::vector<size_t>* sel,
+                                       const OrderFactors& factors)
+    : factors_(factors) {
+    auto size = sel != nullptr ? sel->size() : rows.size();
+    rows_.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        rows_.emplace_back(&rows[sel != nullptr ? (*sel)[i] : i]);
+    }
+    encoded_ = SortKey::encodable(rows_, factors);
+    if (encoded_) {
+        keys_.resize(size);
+    }
+}
+
+void RowIndexComparator::prepare(size_t begin, size_t end) {
+    if (!encoded_) {
+        return;
+    }
+    for (auto i = begin; i < end; ++i) {
+        SortKey::encode(*rows_[i], factors_, &keys_[i]);
+    }
+}
+
+bool RowIndexComparator::less(const Row& lhs, const Row& rhs) const {
+    for (auto& item : factors_) {
+        auto index = item.first;
+        auto orderType = item.second;
+        if (lhs[index] == rhs[index]) {
+            continue;
+        }
+
+        if (orderType == OrderFactor::OrderType::ASCEND) {
+            return lhs[index] < rhs[index];
+        } else if (orderType == OrderFactor::OrderType::DESCEND) {
+            return lhs[index] > rhs[index];
+        }
+    }
+    return false;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_SORTKEY_H_
+#define UTIL_SORTKEY_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
+#include "parser/TraverseSentences.h"
+
+namespace nebula {
+namespace graph {
+
+using OrderFactors = std::vector<std::pair<size_t, OrderFactor::OrderType>>;
+
+// Encode the order factors of a row to a byte string, whose byte-wise order is the
+// order of `Value' on the factors, so the rows are compared by a single memcmp.
+//
+// Each value is a type tag followed by the payload:
+//   EMPTY < BOOL < INT < STRING < NULL, which is the order of the types in `Value'
+//   integers are in big endian with the sign bit flipped
+//   strings have the zero bytes escaped to 0x00 0xFF and end with 0x00 0x00
+// All bytes of a descending factor are inverted.
+class SortKey final {
+public:
+    SortKey() = delete;
+
+    // Whether the rows could be ordered by the encoded keys, i.e. every factor column
+    // holds only the null, empty, bool, int and string values. The floats are not, since
+    // `Value' takes the floats within an epsilon as equal, which no byte order could keep.
+    static bool encodable(std::vector<Row>::const_iterator begin,
+                          std::vector<Row>::const_iterator end,
+                          const OrderFactors& factors);
+
+    static bool encodable(const std::vector<const Row*>& rows, const OrderFactors& factors);
+
+    static void encode(const Row& row, const OrderFactors& factors, std::string* key);
+
+    static void encodeValue(const Value& val, bool desc, std::string* key);
+};
+
+// Compare the rows by their indices on the order factors, by the encoded keys if the
+// factors are encodable, or by the values of factors otherwise.
+//
+// The i-th row is `rows[i]', or `rows[(*sel)[i]]' if the selection is given, so the rows
+// selected by a view are ordered without being copied or moved.
+class RowIndexComparator final {
+public:
+    RowIndexComparator(const std::vector<Row>& rows,
+                       const std::vector<size_t>* sel,
+                       const OrderFactors& factors);
+
+    // Encode the keys of the rows in [begin, end). It is safe to prepare the disjoint
+    // ranges concurrently.
+    void prepare(size_t begin, size_t end);
+
+    bool operator()(size_t lhs, size_t rhs) const {
+        if (encoded_) {
+            return keys_[lhs] < keys_[rhs];
+        }
+        return less(*rows_[lhs], *rows_[rhs]);
+    }
+
+    bool encoded() const {
+        return encoded_;
+    }
+
+private:
+    bool less(const Row& lhs, const Row& rhs) const;
+
+    std::vector<const Row*>                 rows_;
+    const OrderFactors&                     factors_;
+    bool                                    encoded_{false};
+    std::vector<std::string>                keys_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_SORTKEY_H_
@@ -0,0 +1,232 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/Statistics.h"
+
+#include <folly/Synchronized.h>
+
+#include "common/clients/meta/MetaClient.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/ContainerExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "common/time/WallClock.h"
+#include "context/QueryContext.h"
+#include "service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// The statistics of a space not read for so many refresh intervals are dropped,
+// e.g. those of the dropped spaces
+constexpr int64_t kEvictIntervals = 3;
+
+struct CachedStats {
+    std::shared_ptr<const SpaceStats>   stats;
+    int64_t                             updateTime{0};
+    int64_t                             readTime{0};
+    bool                                fetching{false};
+};
+
+using StatsCache = std::unordered_map<GraphSpaceID, CachedStats>;
+
+folly::Synchronized<StatsCache>& statsCache() {
+    static folly::Synchronized<StatsCache> cache;
+    return cache;
+}
+
+void evictStats(StatsCache* cache, int64_t now) {
+    auto expiry = kEvictIntervals * FLAGS_space_stats_refresh_interval_secs;
+    for (auto iter = cache->begin(); iter != cache->end();) {
+        if (!iter->second.fetching && now - iter->second.readTime >= expiry) {
+            iter = cache->erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void fetchSpaceStats(meta::MetaClient* metaClient, GraphSpaceID space) {
+    metaClient->getStatis(space).thenValue([space](StatusOr<meta::cpp2::StatisItem> resp) {
+        auto now = time::WallClock::fastNowInSec();
+        if (!resp.ok()) {
+            // Keep the stale statistics, and retry after the interval
+            VLOG(1) << "Fetch the statistics of space " << space << " failed: " << resp.status();
+            auto cache = statsCache().wlock();
+            auto& cached = (*cache)[space];
+            cached.updateTime = now;
+            cached.fetching = false;
+            return;
+        }
+        auto item = std::move(resp).value();
+        auto stats = std::make_shared<SpaceStats>();
+        stats->vertices = *item.space_vertices_ref();
+        stats->edges = *item.space_edges_ref();
+        for (auto& tag : item.get_tag_vertices()) {
+            stats->tagVertices.emplace(tag.first, tag.second);
+        }
+        for (auto& edge : item.get_edges()) {
+            stats->edgeCounts.emplace(edge.first, edge.second);
+        }
+        auto cache = statsCache().wlock();
+        auto& cached = (*cache)[space];
+        cached.stats = std::move(stats);
+        cached.updateTime = now;
+        cached.fetching = false;
+    });
+}
+
+double inListSize(const Expression* expr) {
+    if (expr->kind() == Expression::Kind::kList) {
+        return static_cast<const ListExpression*>(expr)->size();
+    }
+    if (expr->kind() == Expression::Kind::kConstant) {
+        const auto& val = static_cast<const ConstantExpression*>(expr)->value();
+        if (val.isList()) {
+            return val.getList().size();
+        }
+        if (val.isSet()) {
+            return val.getSet().values.size();
+        }
+    }
+    // Unknown size, assume the default selectivity of the membership
+    return Statistics::kDefaultSelectivity / Statistics::kEqualSelectivity;
+}
+
+}   // namespace
+
+int64_t SpaceStats::numVertices(const std::string& tag) const {
+    auto iter = tagVertices.find(tag);
+    return iter == tagVertices.end() ? -1 : iter->second;
+}
+
+int64_t SpaceStats::numEdges(const std::string& edge) const {
+    auto iter = edgeCounts.find(edge);
+    return iter == edgeCounts.end() ? -1 : iter->second;
+}
+
+// static
+std::shared_ptr<const SpaceStats> Statistics::spaceStats(QueryContext* qctx, GraphSpaceID space) {
+    if (space < 0) {
+        return nullptr;
+    }
+    auto metaClient = qctx == nullptr ? nullptr : qctx->getMetaClient();
+    auto now = time::WallClock::fastNowInSec();
+    std::shared_ptr<const SpaceStats> stats;
+    bool fetch = false;
+    {
+        auto cache = statsCache().wlock();
+        if (metaClient == nullptr) {
+            // Nothing would be fetched, so only the statistics set before are read
+            auto iter = cache->find(space);
+            if (iter == cache->end()) {
+                return nullptr;
+            }
+            iter->second.readTime = now;
+            return iter->second.stats;
+        }
+        auto& cached = (*cache)[space];
+        cached.readTime = now;
+        stats = cached.stats;
+        if (!cached.fetching &&
+            (cached.updateTime == 0 ||
+             now - cached.updateTime >= FLAGS_space_stats_refresh_interval_secs)) {
+            cached.fetching = true;
+            fetch = true;
+            // Sweep the other spaces as rarely as the fetches
+            evictStats(&*cache, now);
+        }
+    }
+    if (fetch) {
+        fetchSpaceStats(metaClient, space);
+    }
+    return stats;
+}
+
+// static
+void Statistics::setSpaceStats(GraphSpaceID space, std::shared_ptr<const SpaceStats> stats) {
+    auto cache = statsCache().wlock();
+    auto& cached = (*cache)[space];
+    cached.stats = std::move(stats);
+    cached.updateTime = time::WallClock::fastNowInSec();
+    cached.readTime = cached.updateTime;
+    cached.fetching = false;
+}
+
+// static
+double Statistics::selectivity(const Expression* filter) {
+    if (filter == nullptr) {
+        return 1.0;
+    }
+    switch (filter->kind()) {
+        case Expression::Kind::kConstant: {
+            const auto& val = static_cast<const ConstantExpression*>(filter)->value();
+            return val.isBool() && val.getBool() ? 1.0 : 0.0;
+        }
+        case Expression::Kind::kRelEQ:
+            return kEqualSelectivity;
+        case Expression::Kind::kRelNE:
+            return 1.0 - kEqualSelectivity;
+        case Expression::Kind::kRelLT:
+        case Expression::Kind::kRelLE:
+        case Expression::Kind::kRelGT:
+        case Expression::Kind::kRelGE:
+        case Expression::Kind::kStartsWith:
+        case Expression::Kind::kEndsWith:
+        case Expression::Kind::kContains:
+            return kRangeSelectivity;
+        case Expression::Kind::kRelIn:
+        case Expression::Kind::kRelNotIn: {
+            auto right = static_cast<const RelationalExpression*>(filter)->right();
+            auto sel = std::min(1.0, inListSize(right) * kEqualSelectivity);
+            return filter->kind() == Expression::Kind::kRelIn ? sel : 1.0 - sel;
+        }
+        case Expression::Kind::kIsNull:
+        case Expression::Kind::kIsEmpty:
+            return kEqualSelectivity;
+        case Expression::Kind::kIsNotNull:
+        case Expression::Kind::kIsNotEmpty:
+            return 1.0 - kEqualSelectivity;
+        case Expression::Kind::kUnaryNot:
+            return 1.0 - selectivity(static_cast<const UnaryExpression*>(filter)->operand());
+        case Expression::Kind::kLogicalAnd: {
+            // Assume the operands are independent
+            double sel = 1.0;
+            for (auto operand : static_cast<const LogicalExpression*>(filter)->operands()) {
+                sel *= selectivity(operand);
+            }
+            return sel;
+        }
+        case Expression::Kind::kLogicalOr: {
+            double sel = 0.0;
+            for (auto operand : static_cast<const LogicalExpression*>(filter)->operands()) {
+                auto s = selectivity(operand);
+                sel = sel + s - sel * s;
+            }
+            return sel;
+        }
+        default:
+            return kDefaultSelectivity;
+    }
+}
+
+// static
+double Statistics::degree(const SpaceStats* stats, const std::string& edge) {
+    if (stats == nullptr || stats->vertices <= 0) {
+        return kDefaultDegree;
+    }
+    auto edges = edge.empty() ? stats->edges : stats->numEdges(edge);
+    if (edges < 0) {
+        return kDefaultDegree;
+    }
+    return static_cast<double>(edges) / stats->vertices;
+}
+
+}   // namespace graph
+}   // namespace nebula
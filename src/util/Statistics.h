@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_STATISTICS_H_
+#define UTIL_STATISTICS_H_
+
+#include "common/base/Base.h"
+#include "common/expression/Expression.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+namespace graph {
+
+class QueryContext;
+
+// The vertex and edge counts of a space collected by the STATS job
+struct SpaceStats {
+    int64_t                                     vertices{0};
+    int64_t                                     edges{0};
+    std::unordered_map<std::string, int64_t>    tagVertices;
+    std::unordered_map<std::string, int64_t>    edgeCounts;
+
+    // Return -1 if the tag or edge is unknown
+    int64_t numVertices(const std::string& tag) const;
+    int64_t numEdges(const std::string& edge) const;
+};
+
+// The statistics to estimate the cardinality of plans.
+//
+// Without the statistics of the space, the defaults below are used, and the
+// choices of plans are left to the order of the planners and rules.
+class Statistics final {
+public:
+    static constexpr double kDefaultVertices = 100000.0;
+    static constexpr double kDefaultDegree = 10.0;
+
+    // The textbook selectivities of the predicates whose distributions are unknown
+    static constexpr double kEqualSelectivity = 0.1;
+    static constexpr double kRangeSelectivity = 1.0 / 3;
+    static constexpr double kDefaultSelectivity = 0.5;
+
+    // Return the cached statistics of the space, nullptr before they are fetched
+    // from meta. Fetch them asynchronously if absent or expired, so that planning
+    // never waits for meta. The statistics not read for a few refresh intervals are
+    // dropped.
+    static std::shared_ptr<const SpaceStats> spaceStats(QueryContext* qctx, GraphSpaceID space);
+
+    // Replace the cached statistics of the space, for test
+    static void setSpaceStats(GraphSpaceID space, std::shared_ptr<const SpaceStats> stats);
+
+    // The fraction of the rows passing `filter'
+    static double selectivity(const Expression* filter);
+
+    // The average out degree of the edges
+    static double degree(const SpaceStats* stats, const std::string& edge);
+
+private:
+    Statistics() = delete;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_STATISTICS_H_
@@ -0,0 +1,175 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/VidBitmap.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+size_t popcount(const std::vector<uint64_t>& bitmap) {
+    size_t count = 0;
+    for (auto word : bitmap) {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+}   // namespace
+
+bool VidBitmap::Chunk::add(uint16_t low) {
+    if (dense) {
+        auto& word = bitmap[low >> 6];
+        auto mask = uint64_t(1) << (low & 63);
+        if (word & mask) {
+            return false;
+        }
+        word |= mask;
+        ++count;
+        return true;
+    }
+    auto pos = std::lower_bound(array.begin(), array.end(), low);
+    if (pos != array.end() && *pos == low) {
+        return false;
+    }
+    array.insert(pos, low);
+    ++count;
+    if (array.size() > kMaxArraySize) {
+        toBitmap();
+    }
+    return true;
+}
+
+bool VidBitmap::Chunk::contains(uint16_t low) const {
+    if (dense) {
+        return bitmap[low >> 6] & (uint64_t(1) << (low & 63));
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+void VidBitmap::Chunk::toBitmap() {
+    if (dense) {
+        return;
+    }
+    bitmap.assign(kBitmapWords, 0);
+    for (auto low : array) {
+        bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    array.clear();
+    array.shrink_to_fit();
+    dense = true;
+}
+
+void VidBitmap::Chunk::shrink() {
+    if (!dense || count > kMaxArraySize) {
+        return;
+    }
+    array.reserve(count);
+    for (size_t i = 0; i < bitmap.size(); ++i) {
+        for (auto word = bitmap[i]; word != 0; word &= word - 1) {
+            array.emplace_back(static_cast<uint16_t>(i * 64 + __builtin_ctzll(word)));
+        }
+    }
+    bitmap.clear();
+    bitmap.shrink_to_fit();
+    dense = false;
+}
+
+VidBitmap::Chunk* VidBitmap::chunkOf(uint32_t id) {
+    auto high = id >> kChunkBits;
+    if (chunks_.size() <= high) {
+        chunks_.resize(high + 1);
+    }
+    return &chunks_[high];
+}
+
+bool VidBitmap::add(uint32_t id) {
+    if (!chunkOf(id)->add(static_cast<uint16_t>(id & kLowMask))) {
+        return false;
+    }
+    ++size_;
+    return true;
+}
+
+bool VidBitmap::contains(uint32_t id) const {
+    auto high = id >> kChunkBits;
+    return high < chunks_.size() && chunks_[high].contains(static_cast<uint16_t>(id & kLowMask));
+}
+
+void VidBitmap::unionWith(const VidBitmap& other) {
+    if (chunks_.size() < other.chunks_.size()) {
+        chunks_.resize(other.chunks_.size());
+    }
+    size_ = 0;
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+        auto& chunk = chunks_[i];
+        if (i < other.chunks_.size() && other.chunks_[i].count > 0) {
+            const auto& from = other.chunks_[i];
+            if (from.dense) {
+                chunk.toBitmap();
+                for (size_t w = 0; w < kBitmapWords; ++w) {
+                    chunk.bitmap[w] |= from.bitmap[w];
+                }
+                chunk.count = popcount(chunk.bitmap);
+            } else if (chunk.dense) {
+                for (auto low : from.array) {
+                    chunk.add(low);
+                }
+            } else {
+                std::vector<uint16_t> merged;
+                merged.reserve(chunk.array.size() + from.array.size());
+                std::set_union(chunk.array.begin(),
+                               chunk.array.end(),
+                               from.array.begin(),
+                               from.array.end(),
+                               std::back_inserter(merged));
+                chunk.array = std::move(merged);
+                chunk.count = chunk.array.size();
+                if (chunk.count > kMaxArraySize) {
+                    chunk.toBitmap();
+                }
+            }
+        }
+        size_ += chunk.count;
+    }
+}
+
+void VidBitmap::subtract(const VidBitmap& other) {
+    size_ = 0;
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+        auto& chunk = chunks_[i];
+        if (i < other.chunks_.size() && other.chunks_[i].count > 0 && chunk.count > 0) {
+            const auto& from = other.chunks_[i];
+            if (chunk.dense && from.dense) {
+                for (size_t w = 0; w < kBitmapWords; ++w) {
+                    chunk.bitmap[w] &= ~from.bitmap[w];
+                }
+                chunk.count = popcount(chunk.bitmap);
+            } else if (chunk.dense) {
+                for (auto low : from.array) {
+                    auto& word = chunk.bitmap[low >> 6];
+                    auto mask = uint64_t(1) << (low & 63);
+                    if (word & mask) {
+                        word &= ~mask;
+                        --chunk.count;
+                    }
+                }
+            } else {
+                auto end = std::remove_if(chunk.array.begin(),
+                                          chunk.array.end(),
+                                          [&from](uint16_t low) { return from.contains(low); });
+                chunk.array.erase(end, chunk.array.end());
+                chunk.count = chunk.array.size();
+            }
+            chunk.shrink();
+        }
+        size_ += chunk.count;
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
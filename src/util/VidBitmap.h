@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_VIDBITMAP_H_
+#define UTIL_VIDBITMAP_H_
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace graph {
+
+// A set of the ids of the vids interned by VidDict, laid out as the roaring
+// bitmap. The ids are split into the chunks of 2^16 by the high bits, and a
+// chunk keeps the low bits as a sorted array while sparse, or as a bitmap of
+// 8KB once the array would be larger.
+class VidBitmap final {
+public:
+    VidBitmap() = default;
+
+    // Return whether `id' is added just now
+    bool add(uint32_t id);
+
+    bool contains(uint32_t id) const;
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    void clear() {
+        chunks_.clear();
+        size_ = 0;
+    }
+
+    // Add all the ids of `other'
+    void unionWith(const VidBitmap& other);
+
+    // Remove all the ids of `other'
+    void subtract(const VidBitmap& other);
+
+    // Call `fn' with each id in the ascending order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t high = 0; high < chunks_.size(); ++high) {
+            auto base = static_cast<uint32_t>(high << kChunkBits);
+            const auto& chunk = chunks_[high];
+            if (!chunk.dense) {
+                for (auto low : chunk.array) {
+                    fn(base | low);
+                }
+                continue;
+            }
+            for (size_t i = 0; i < chunk.bitmap.size(); ++i) {
+                auto word = chunk.bitmap[i];
+                while (word != 0) {
+                    auto bit = __builtin_ctzll(word);
+                    fn(base | static_cast<uint32_t>(i * 64 + bit));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kChunkBits = 16;
+    static constexpr uint32_t kLowMask = (1u << kChunkBits) - 1;
+    static constexpr size_t kBitmapWords = (1u << kChunkBits) / 64;
+    // The array of more low bits is larger than the bitmap
+    static constexpr size_t kMaxArraySize = 4096;
+
+    struct Chunk {
+        // The sorted low bits if not dense
+        std::vector<uint16_t>   array;
+        std::vector<uint64_t>   bitmap;
+        bool                    dense{false};
+        size_t                  count{0};
+
+        bool add(uint16_t low);
+
+        bool contains(uint16_t low) const;
+
+        void toBitmap();
+
+        // Back to the array if it gets sparse
+        void shrink();
+    };
+
+    Chunk* chunkOf(uint32_t id);
+
+    std::vector<Chunk>      chunks_;
+    size_t                  size_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_VIDBITMAP_H_
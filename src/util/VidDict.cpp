@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/VidDict.h"
+
+#include <folly/hash/Hash.h>
+
+namespace nebula {
+namespace graph {
+
+// static
+size_t VidDict::hash(const Value& vid) {
+    if (vid.isInt()) {
+        return folly::hash::twang_mix64(vid.getInt());
+    }
+    if (vid.isStr()) {
+        return folly::hash::twang_mix64(std::hash<std::string>()(vid.getStr()));
+    }
+    return folly::hash::twang_mix64(std::hash<Value>()(vid));
+}
+
+std::pair<uint32_t, bool> VidDict::intern(const Value& vid) {
+    if ((vids_.size() + 1) * 2 > slots_.size()) {
+        rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+    }
+    auto h = hash(vid);
+    auto pos = position(vid, h);
+    if (slots_[pos] != kNone) {
+        return std::make_pair(slots_[pos], false);
+    }
+    DCHECK_LT(vids_.size(), kNone);
+    auto id = static_cast<uint32_t>(vids_.size());
+    slots_[pos] = id;
+    vids_.emplace_back(vid);
+    hashes_.emplace_back(h);
+    return std::make_pair(id, true);
+}
+
+uint32_t VidDict::find(const Value& vid) const {
+    if (slots_.empty()) {
+        return kNone;
+    }
+    return slots_[position(vid, hash(vid))];
+}
+
+void VidDict::reserve(size_t expected) {
+    vids_.reserve(expected);
+    hashes_.reserve(expected);
+    size_t capacity = kMinCapacity;
+    while (capacity < expected * 2) {
+        capacity <<= 1;
+    }
+    if (capacity > slots_.size()) {
+        rehash(capacity);
+    }
+}
+
+size_t VidDict::position(const Value& vid, size_t h) const {
+    for (auto pos = h & mask_;; pos = (pos + 1) & mask_) {
+        auto id = slots_[pos];
+        if (id == kNone || (hashes_[id] == h && equal(vids_[id], vid))) {
+            return pos;
+        }
+    }
+}
+
+void VidDict::rehash(size_t capacity) {
+    DCHECK_EQ(capacity & (capacity - 1), 0);
+    slots_.assign(capacity, kNone);
+    mask_ = capacity - 1;
+    for (uint32_t id = 0; id < vids_.size(); ++id) {
+        auto pos = hashes_[id] & mask_;
+        while (slots_[pos] != kNone) {
+            pos = (pos + 1) & mask_;
+        }
+        slots_[pos] = id;
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_VIDDICT_H_
+#define UTIL_VIDDICT_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// Interns the vids into the dense ids from 0 in the order of interning, so
+// that the states of a traversal are kept in the arrays indexed by the ids
+// instead of the hash containers of the vids.
+//
+// Each vid is kept once. The vids of a space are either all int64 or all
+// fixed-length strings, which are hashed and compared directly instead of
+// through Value.
+//
+// Not thread safe. The ids are only meaningful to the dictionary, so each
+// executor of a query interns the vids it keeps into its own.
+class VidDict final {
+public:
+    static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+    VidDict() = default;
+
+    // Return the id of `vid', and whether it is interned just now
+    std::pair<uint32_t, bool> intern(const Value& vid);
+
+    // Return kNone if `vid' is not interned
+    uint32_t find(const Value& vid) const;
+
+    const Value& vid(uint32_t id) const {
+        DCHECK_LT(id, vids_.size());
+        return vids_[id];
+    }
+
+    size_t size() const {
+        return vids_.size();
+    }
+
+    bool empty() const {
+        return vids_.empty();
+    }
+
+    void reserve(size_t expected);
+
+    static size_t hash(const Value& vid);
+
+private:
+    static constexpr size_t kMinCapacity = 16;
+
+    // The slot of `vid' whose hash is `h', which is either empty or the id
+    size_t position(const Value& vid, size_t h) const;
+
+    void rehash(size_t capacity);
+
+    static bool equal(const Value& lhs, const Value& rhs) {
+        if (lhs.isInt() && rhs.isInt()) {
+            return lhs.getInt() == rhs.getInt();
+        }
+        if (lhs.isStr() && rhs.isStr()) {
+            return lhs.getStr() == rhs.getStr();
+        }
+        return lhs == rhs;
+    }
+
+    // The ids, kNone for the empty slots
+    std::vector<uint32_t>   slots_;
+    std::vector<Value>      vids_;
+    std::vector<size_t>     hashes_;
+    size_t                  mask_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_VIDDICT_H_
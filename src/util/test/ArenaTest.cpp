@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/Arena.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace nebula {
+namespace graph {
+
+TEST(ArenaTest, Allocate) {
+    Arena arena;
+    EXPECT_EQ(0u, arena.size());
+    std::vector<int64_t*> ptrs;
+    for (int64_t i = 0; i < 100000; ++i) {
+        auto* ptr = static_cast<int64_t*>(arena.allocate(sizeof(int64_t), alignof(int64_t)));
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % alignof(int64_t));
+        *ptr = i;
+        ptrs.emplace_back(ptr);
+    }
+    for (int64_t i = 0; i < 100000; ++i) {
+        EXPECT_EQ(i, *ptrs[i]);
+    }
+    EXPECT_GE(arena.size(), 100000 * sizeof(int64_t));
+
+    // Larger than a chunk
+    auto* big = static_cast<char*>(arena.allocate(64 * 1024 * 1024, 64));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(big) % 64);
+    big[64 * 1024 * 1024 - 1] = 'x';
+    // The chunk before is still carved
+    auto size = arena.size();
+    arena.allocate(8);
+    EXPECT_EQ(size, arena.size());
+
+    arena.reset();
+    EXPECT_EQ(0u, arena.size());
+}
+
+TEST(ArenaTest, Allocator) {
+    Arena arena;
+    std::unordered_set<int64_t, std::hash<int64_t>, std::equal_to<int64_t>,
+                       ArenaAllocator<int64_t>>
+        set(16, std::hash<int64_t>(), std::equal_to<int64_t>(), ArenaAllocator<int64_t>(&arena));
+    for (int64_t i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(set.emplace(i).second);
+    }
+    for (int64_t i = 0; i < 1000; ++i) {
+        EXPECT_FALSE(set.emplace(i).second);
+    }
+    EXPECT_EQ(1000u, set.size());
+    EXPECT_GT(arena.size(), 0u);
+}
+
+TEST(ArenaTest, ArenaPerThread) {
+    constexpr int64_t kNumThreads = 8;
+    constexpr int64_t kNumValues = 100000;
+    std::vector<std::thread> threads;
+    std::vector<size_t> sizes(kNumThreads, 0);
+    for (int64_t t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([t, &sizes]() {
+            // Each thread builds its set on an arena of its own, and so allocates
+            // without locking while the others do as well
+            Arena arena;
+            std::unordered_set<int64_t, std::hash<int64_t>, std::equal_to<int64_t>,
+                               ArenaAllocator<int64_t>>
+                set(0, std::hash<int64_t>(), std::equal_to<int64_t>(),
+                    ArenaAllocator<int64_t>(&arena));
+            std::vector<int64_t*> ptrs;
+            for (int64_t i = 0; i < kNumValues; ++i) {
+                set.emplace(t * kNumValues + i % 1000);
+                auto* ptr = static_cast<int64_t*>(arena.allocate(sizeof(int64_t)));
+                *ptr = t * kNumValues + i;
+                ptrs.emplace_back(ptr);
+            }
+            for (int64_t i = 0; i < kNumValues; ++i) {
+                ASSERT_EQ(t * kNumValues + i, *ptrs[i]);
+            }
+            ASSERT_EQ(1000u, set.size());
+            sizes[t] = arena.size();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto size : sizes) {
+        EXPECT_GE(size, kNumValues * sizeof(int64_t));
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
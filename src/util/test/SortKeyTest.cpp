@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/SortKey.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+std::string encode(const Value& val, bool desc = false) {
+    std::string key;
+    SortKey::encodeValue(val, desc, &key);
+    return key;
+}
+
+}   // namespace
+
+TEST(SortKeyTest, Order) {
+    std::vector<std::vector<Value>> columns = {
+        {Value::kEmpty, false, true, Value::kNullValue},
+        {std::numeric_limits<int64_t>::min(), -100, -1, 0, 1, 255, 256,
+         std::numeric_limits<int64_t>::max(), Value::kNullValue},
+        {"", std::string("\0", 1), std::string("\0\0", 2), std::string("a\0", 2), "a", "ab",
+         "b", "\xFF", 1, Value::kNullValue},
+    };
+    for (auto& values : columns) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            for (size_t j = 0; j < values.size(); ++j) {
+                auto expected = values[i] < values[j];
+                EXPECT_EQ(encode(values[i]) < encode(values[j]), expected)
+                    << values[i] << " vs " << values[j];
+                EXPECT_EQ(encode(values[j], true) < encode(values[i], true), expected)
+                    << values[i] << " vs " << values[j];
+            }
+        }
+    }
+}
+
+TEST(SortKeyTest, MultiFactors) {
+    OrderFactors factors = {{1, OrderFactor::OrderType::ASCEND},
+                            {0, OrderFactor::OrderType::DESCEND}};
+    std::vector<Row> rows = {
+        Row({1, "a"}),
+        Row({2, "a"}),
+        Row({1, std::string("a\0", 2)}),
+        Row({Value::kNullValue, "ab"}),
+        Row({3, Value::kNullValue}),
+    };
+    ASSERT_TRUE(SortKey::encodable(rows.begin(), rows.end(), factors));
+
+    RowIndexComparator comparator(rows, nullptr, factors);
+    ASSERT_TRUE(comparator.encoded());
+    comparator.prepare(0, rows.size());
+    std::vector<size_t> indices = {0, 1, 2, 3, 4};
+    std::sort(indices.begin(), indices.end(), [&comparator](size_t lhs, size_t rhs) {
+        return comparator(lhs, rhs);
+    });
+    EXPECT_EQ(indices, std::vector<size_t>({1, 0, 2, 3, 4}));
+
+    // Compare the selected rows only
+    std::vector<size_t> sel = {4, 2, 1};
+    RowIndexComparator selected(rows, &sel, factors);
+    ASSERT_TRUE(selected.encoded());
+    selected.prepare(0, sel.size());
+    EXPECT_TRUE(selected(2, 1));
+    EXPECT_TRUE(selected(1, 0));
+    EXPECT_FALSE(selected(0, 2));
+}
+
+TEST(SortKeyTest, Unencodable) {
+    OrderFactors factors = {{0, OrderFactor::OrderType::ASCEND}};
+    std::vector<Row> numbers = {Row({1}), Row({1.5}), Row({2})};
+    EXPECT_FALSE(SortKey::encodable(numbers.begin(), numbers.end(), factors));
+    std::vector<Row> lists = {Row({List({1, 2})}), Row({List({1})})};
+    EXPECT_FALSE(SortKey::encodable(lists.begin(), lists.end(), factors));
+    std::vector<Row> floats = {Row({1.5}), Row({0.5})};
+    EXPECT_FALSE(SortKey::encodable(floats.begin(), floats.end(), factors));
+
+    // Fallback to compare the values
+    RowIndexComparator comparator(numbers, nullptr, factors);
+    ASSERT_FALSE(comparator.encoded());
+    comparator.prepare(0, numbers.size());
+    EXPECT_TRUE(comparator(0, 1));
+    EXPECT_TRUE(comparator(1, 2));
+    EXPECT_FALSE(comparator(2, 0));
+}
+
+TEST(SortKeyTest, Floats) {
+    // The floats equal within the epsilon are ordered by the next factor
+    OrderFactors factors = {{0, OrderFactor::OrderType::ASCEND},
+                            {1, OrderFactor::OrderType::ASCEND}};
+    std::vector<Row> rows = {Row({0.1 + 0.2, "a"}), Row({0.3, "b"}), Row({0.25, "c"})};
+    ASSERT_EQ(rows[0][0], rows[1][0]);
+    RowIndexComparator comparator(rows, nullptr, factors);
+    ASSERT_FALSE(comparator.encoded());
+    comparator.prepare(0, rows.size());
+    EXPECT_TRUE(comparator(0, 1));
+    EXPECT_FALSE(comparator(1, 0));
+    EXPECT_TRUE(comparator(2, 0));
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,99 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/VidBitmap.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+std::vector<uint32_t> toVector(const VidBitmap& bitmap) {
+    std::vector<uint32_t> ids;
+    bitmap.forEach([&ids](uint32_t id) { ids.emplace_back(id); });
+    return ids;
+}
+
+// Both the sparse and the dense chunks
+VidBitmap build(const std::set<uint32_t>& ids) {
+    VidBitmap bitmap;
+    for (auto id : ids) {
+        bitmap.add(id);
+    }
+    return bitmap;
+}
+
+}   // namespace
+
+TEST(VidBitmapTest, Add) {
+    VidBitmap bitmap;
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_TRUE(bitmap.add(3));
+    EXPECT_FALSE(bitmap.add(3));
+    EXPECT_TRUE(bitmap.add(70000));
+    EXPECT_TRUE(bitmap.contains(3));
+    EXPECT_TRUE(bitmap.contains(70000));
+    EXPECT_FALSE(bitmap.contains(4));
+    EXPECT_FALSE(bitmap.contains(1u << 30));
+    EXPECT_EQ(2u, bitmap.size());
+
+    // Over the max size of the array
+    for (uint32_t id = 0; id < 10000; id += 2) {
+        bitmap.add(id);
+    }
+    EXPECT_EQ(5002u, bitmap.size());
+    EXPECT_TRUE(bitmap.contains(9998));
+    EXPECT_FALSE(bitmap.contains(9999));
+    auto ids = toVector(bitmap);
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+    EXPECT_EQ(5002u, ids.size());
+
+    bitmap.clear();
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_FALSE(bitmap.contains(3));
+}
+
+TEST(VidBitmapTest, SetOperations) {
+    std::mt19937 gen(0);
+    for (auto range : {1000u, 100000u, 300000u}) {
+        for (auto count : {10u, 3000u, 20000u}) {
+            std::set<uint32_t> lhs;
+            std::set<uint32_t> rhs;
+            std::uniform_int_distribution<uint32_t> dist(0, range);
+            for (size_t i = 0; i < count; ++i) {
+                lhs.emplace(dist(gen));
+                rhs.emplace(dist(gen) / 2);
+            }
+
+            auto unioned = build(lhs);
+            unioned.unionWith(build(rhs));
+            std::vector<uint32_t> expected;
+            std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                           std::back_inserter(expected));
+            EXPECT_EQ(expected, toVector(unioned));
+            EXPECT_EQ(expected.size(), unioned.size());
+
+            auto subtracted = build(lhs);
+            subtracted.subtract(build(rhs));
+            expected.clear();
+            std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                std::back_inserter(expected));
+            EXPECT_EQ(expected, toVector(subtracted));
+            EXPECT_EQ(expected.size(), subtracted.size());
+            for (auto id : rhs) {
+                EXPECT_FALSE(subtracted.contains(id));
+            }
+        }
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/VidDict.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+TEST(VidDictTest, IntVids) {
+    VidDict dict;
+    EXPECT_EQ(VidDict::kNone, dict.find(1));
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto result = dict.intern(i * 7);
+        EXPECT_EQ(i, result.first);
+        EXPECT_TRUE(result.second);
+    }
+    EXPECT_EQ(1000u, dict.size());
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto result = dict.intern(i * 7);
+        EXPECT_EQ(i, result.first);
+        EXPECT_FALSE(result.second);
+        EXPECT_EQ(i, dict.find(i * 7));
+        EXPECT_EQ(Value(i * 7), dict.vid(i));
+    }
+    EXPECT_EQ(VidDict::kNone, dict.find(1));
+    EXPECT_EQ(1000u, dict.size());
+}
+
+TEST(VidDictTest, StrVids) {
+    VidDict dict;
+    dict.reserve(100);
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, dict.intern(folly::to<std::string>(i)).first);
+    }
+    for (uint32_t i = 0; i < 100; ++i) {
+        auto vid = folly::to<std::string>(i);
+        EXPECT_EQ(i, dict.find(vid));
+        EXPECT_EQ(Value(vid), dict.vid(i));
+    }
+    EXPECT_EQ(VidDict::kNone, dict.find("100"));
+    // The int vid is not the string one
+    EXPECT_EQ(VidDict::kNone, dict.find(1));
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -532,6 +532,7 @@ Status ShowQueriesValidator::validateImpl() {
     outputs_.emplace_back("Host", Value::Type::STRING);
     outputs_.emplace_back("StartTime", Value::Type::DATETIME);
     outputs_.emplace_back("DurationInUSec", Value::Type::INT);
+    outputs_.emplace_back("PeakMemoryInBytes", Value::Type::INT);
     outputs_.emplace_back("Status", Value::Type::STRING);
     outputs_.emplace_back("Query", Value::Type::STRING);
     return Status::OK();
@@ -25,6 +25,7 @@ Status FindPathValidator::validateImpl() {
     NG_RETURN_IF_ERROR(validateOver(fpSentence->over(), pathCtx_->over));
     NG_RETURN_IF_ERROR(validateWhere(fpSentence->where()));
     NG_RETURN_IF_ERROR(validateStep(fpSentence->step(), pathCtx_->steps));
+    NG_RETURN_IF_ERROR(validateWeight(fpSentence->weight()));
 
     outputs_.emplace_back("path", Value::Type::PATH);
     return Status::OK();
@@ -64,5 +65,43 @@ Status FindPathValidator::validateWhere(WhereClause* where) {
     return Status::OK();
 }
 
+Status FindPathValidator::validateWeight(const std::string* weight) {
+    if (weight == nullptr) {
+        return Status::OK();
+    }
+    pathCtx_->isWeight = true;
+    pathCtx_->weightProp = *weight;
+    auto schemaMng = qctx_->schemaMng();
+    for (auto edgeType : pathCtx_->over.edgeTypes) {
+        auto schema = schemaMng->getEdgeSchema(space_.id, edgeType);
+        if (schema == nullptr) {
+            return Status::SemanticError("No schema found for edge type `%d'", edgeType);
+        }
+        auto edgeName = schemaMng->toEdgeName(space_.id, edgeType);
+        if (!edgeName.ok()) {
+            return edgeName.status();
+        }
+        switch (schema->getFieldType(pathCtx_->weightProp)) {
+            case meta::cpp2::PropertyType::INT8:
+            case meta::cpp2::PropertyType::INT16:
+            case meta::cpp2::PropertyType::INT32:
+            case meta::cpp2::PropertyType::INT64:
+            case meta::cpp2::PropertyType::FLOAT:
+            case meta::cpp2::PropertyType::DOUBLE:
+                break;
+            case meta::cpp2::PropertyType::UNKNOWN:
+                return Status::SemanticError("Edge `%s' has no property `%s'",
+                                             edgeName.value().c_str(),
+                                             pathCtx_->weightProp.c_str());
+            default:
+                return Status::SemanticError("The weight `%s.%s' should be numeric",
+                                             edgeName.value().c_str(),
+                                             pathCtx_->weightProp.c_str());
+        }
+        pathCtx_->exprProps.insertEdgeProp(edgeType, pathCtx_->weightProp);
+    }
+    return Status::OK();
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -28,6 +28,8 @@ private:
 
     Status validateWhere(WhereClause* where);
 
+    Status validateWeight(const std::string* weight);
+
 private:
     std::unique_ptr<PathContext> pathCtx_;
 };
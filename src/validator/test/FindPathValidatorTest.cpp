@@ -385,6 +385,52 @@ TEST_F(FindPathValidatorTest, PathWithFilter) {
     }
 }
 
+TEST_F(FindPathValidatorTest, WeightedPath) {
+    {
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\", \"3\" OVER like "
+                            "UPTO 5 STEPS WEIGHT BY likeness";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kDataCollect,
+            PK::kLoop,
+            PK::kStart,
+            PK::kDijkstraShortestPath,
+            PK::kGetNeighbors,
+            PK::kPassThrough,
+            PK::kStart,
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like WHERE "
+                            "like.likeness > 30 UPTO 5 STEPS WEIGHT BY likeness";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kDataCollect,
+            PK::kLoop,
+            PK::kStart,
+            PK::kDijkstraShortestPath,
+            PK::kFilter,
+            PK::kGetNeighbors,
+            PK::kPassThrough,
+            PK::kStart,
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        std::string query =
+            "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like UPTO 5 STEPS WEIGHT BY start";
+        auto result = checkResult(query);
+        EXPECT_EQ(std::string(result.message()),
+                  "SemanticError: The weight `like.start' should be numeric");
+    }
+    {
+        std::string query =
+            "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like UPTO 5 STEPS WEIGHT BY cost";
+        auto result = checkResult(query);
+        EXPECT_EQ(std::string(result.message()),
+                  "SemanticError: Edge `like' has no property `cost'");
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
 
@@ -121,6 +121,13 @@ public:
         return Status::Error("Unimplemented");
     }
 
+    // Replace the schema of the tag, e.g. to mock ALTER TAG
+    void setTagSchema(GraphSpaceID space,
+                      TagID tag,
+                      std::shared_ptr<const meta::NebulaSchemaProvider> schema) {
+        tagSchemas_[space][tag] = std::move(schema);
+    }
+
 private:
     std::unordered_map<std::string, GraphSpaceID>        spaceNameIds_;
     std::unordered_map<std::string, TagID>               tagNameIds_;
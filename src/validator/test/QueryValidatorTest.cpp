@@ -5,6 +5,7 @@
  */
 
 #include "common/base/Base.h"
+#include "service/GraphFlags.h"
 #include "validator/test/ValidatorTestBase.h"
 
 DECLARE_uint32(max_allowed_statements);
@@ -82,6 +83,19 @@ TEST_F(QueryValidatorTest, GoZeroStep) {
 
 TEST_F(QueryValidatorTest, GoNSteps) {
     {
+        std::string query = "GO 2 STEPS FROM \"1\" OVER like";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kProject,
+            PK::kGetNeighbors,
+            PK::kExpand,
+            PK::kStart
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        // The steps before the last run in a Loop without the pipelined expansion
+        gflags::FlagSaver saver;
+        FLAGS_enable_pipelined_expand = false;
         std::string query = "GO 2 STEPS FROM \"1\" OVER like";
         std::vector<PlanNode::Kind> expected = {
             PK::kProject,
@@ -96,6 +110,20 @@ TEST_F(QueryValidatorTest, GoNSteps) {
         EXPECT_TRUE(checkResult(query, expected));
     }
     {
+        std::string query = "GO 3 STEPS FROM \"1\",\"2\",\"3\" OVER like WHERE like.likeness > 90";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kProject,
+            PK::kFilter,
+            PK::kGetNeighbors,
+            PK::kExpand,
+            PK::kStart,
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        // The steps before the last run in a Loop without the pipelined expansion
+        gflags::FlagSaver saver;
+        FLAGS_enable_pipelined_expand = false;
         std::string query = "GO 3 STEPS FROM \"1\",\"2\",\"3\" OVER like WHERE like.likeness > 90";
         std::vector<PlanNode::Kind> expected = {
             PK::kProject,
@@ -111,6 +139,24 @@ TEST_F(QueryValidatorTest, GoNSteps) {
         EXPECT_TRUE(checkResult(query, expected));
     }
     {
+        std::string query =
+            "GO 3 steps FROM \"1\",\"2\",\"3\" OVER like WHERE $^.person.age > 20"
+            "YIELD distinct $^.person.name";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kDataCollect,
+            PK::kDedup,
+            PK::kProject,
+            PK::kFilter,
+            PK::kGetNeighbors,
+            PK::kExpand,
+            PK::kStart,
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        // The steps before the last run in a Loop without the pipelined expansion
+        gflags::FlagSaver saver;
+        FLAGS_enable_pipelined_expand = false;
         std::string query =
             "GO 3 steps FROM \"1\",\"2\",\"3\" OVER like WHERE $^.person.age > 20"
             "YIELD distinct $^.person.name";
@@ -130,6 +176,23 @@ TEST_F(QueryValidatorTest, GoNSteps) {
         EXPECT_TRUE(checkResult(query, expected));
     }
     {
+        std::string query = "GO 2 STEPS FROM \"1\",\"2\",\"3\" OVER like WHERE $^.person.age > 20"
+                            "YIELD distinct $^.person.name ";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kDataCollect,
+            PK::kDedup,
+            PK::kProject,
+            PK::kFilter,
+            PK::kGetNeighbors,
+            PK::kExpand,
+            PK::kStart
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        // The steps before the last run in a Loop without the pipelined expansion
+        gflags::FlagSaver saver;
+        FLAGS_enable_pipelined_expand = false;
         std::string query = "GO 2 STEPS FROM \"1\",\"2\",\"3\" OVER like WHERE $^.person.age > 20"
                             "YIELD distinct $^.person.name ";
         std::vector<PlanNode::Kind> expected = {
@@ -180,6 +243,26 @@ TEST_F(QueryValidatorTest, GoWithPipe) {
         EXPECT_TRUE(checkResult(query, expected));
     }
     {
+        std::string query = "GO 2 STEPS FROM \"1\" OVER like YIELD like._dst AS id"
+                            "| GO 1 STEPS FROM $-.id OVER like";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kProject,
+            PK::kInnerJoin,
+            PK::kProject,
+            PK::kGetNeighbors,
+            PK::kDedup,
+            PK::kProject,
+            PK::kProject,
+            PK::kGetNeighbors,
+            PK::kExpand,
+            PK::kStart
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        // The steps before the last run in a Loop without the pipelined expansion
+        gflags::FlagSaver saver;
+        FLAGS_enable_pipelined_expand = false;
         std::string query = "GO 2 STEPS FROM \"1\" OVER like YIELD like._dst AS id"
                             "| GO 1 STEPS FROM $-.id OVER like";
         std::vector<PlanNode::Kind> expected = {
@@ -566,6 +649,24 @@ TEST_F(QueryValidatorTest, GoReversely) {
         EXPECT_TRUE(checkResult(query, expected));
     }
     {
+        std::string query = "GO 2 STEPS FROM \"1\" OVER like REVERSELY "
+                            "YIELD $$.person.name";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kProject,
+            PK::kLeftJoin,
+            PK::kProject,
+            PK::kGetVertices,
+            PK::kProject,
+            PK::kGetNeighbors,
+            PK::kExpand,
+            PK::kStart,
+        };
+        EXPECT_TRUE(checkResult(query, expected));
+    }
+    {
+        // The steps before the last run in a Loop without the pipelined expansion
+        gflags::FlagSaver saver;
+        FLAGS_enable_pipelined_expand = false;
         std::string query = "GO 2 STEPS FROM \"1\" OVER like REVERSELY "
                             "YIELD $$.person.name";
         std::vector<PlanNode::Kind> expected = {
@@ -74,6 +74,7 @@ class NebulaService(object):
             params.append('--enable_authorize=true')
             params.append('--system_memory_high_watermark_ratio=0.95')
             params.append('--session_reclaim_interval_secs=2')
+            params.append('--enable_plan_cache=true')
         if name == 'storaged':
             params.append('--local_config=false')
             params.append('--raft_heartbeat_interval_secs=30')
@@ -0,0 +1,119 @@
+# Copyright (c) 2021 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License,
+# attached with Common Clause Condition 1.0, found in the LICENSES directory.
+Feature: Plan cache
+
+  Scenario: reuse the plans with other literals
+    Given a graph with space named "nba"
+    When executing query:
+      """
+      FETCH PROP ON player 'Tim Duncan' YIELD player.name, player.age
+      """
+    Then the result should be, in any order:
+      | VertexID     | player.name  | player.age |
+      | "Tim Duncan" | "Tim Duncan" | 42         |
+    When executing query:
+      """
+      FETCH PROP ON player 'Tony Parker' YIELD player.name, player.age
+      """
+    Then the result should be, in any order:
+      | VertexID      | player.name   | player.age |
+      | "Tony Parker" | "Tony Parker" | 36         |
+    When executing query:
+      """
+      FETCH PROP ON player 'Tim Duncan' YIELD player.name, player.age
+      """
+    Then the result should be, in any order:
+      | VertexID     | player.name  | player.age |
+      | "Tim Duncan" | "Tim Duncan" | 42         |
+    When executing query:
+      """
+      GO FROM "Tim Duncan" OVER like YIELD $^.player.name as name, $^.player.age as age
+      """
+    Then the result should be, in any order, with relax comparison:
+      | name         | age |
+      | "Tim Duncan" | 42  |
+      | "Tim Duncan" | 42  |
+    When executing query:
+      """
+      GO FROM "Tony Parker" OVER like YIELD $^.player.name as name, $^.player.age as age
+      """
+    Then the result should be, in any order, with relax comparison:
+      | name          | age |
+      | "Tony Parker" | 36  |
+      | "Tony Parker" | 36  |
+      | "Tony Parker" | 36  |
+    # The literals baked into the plan are not replaced
+    When executing query:
+      """
+      GO FROM "Tim Duncan" OVER like WHERE $$.player.age > 40 YIELD $$.player.name as name
+      """
+    Then the result should be, in any order:
+      | name            |
+      | "Manu Ginobili" |
+    When executing query:
+      """
+      GO FROM "Tim Duncan" OVER like WHERE $$.player.age > 30 YIELD $$.player.name as name
+      """
+    Then the result should be, in any order:
+      | name            |
+      | "Manu Ginobili" |
+      | "Tony Parker"   |
+
+  Scenario: drop the plans once the schemas change
+    Given an empty graph
+    And create a space with following options:
+      | partition_num  | 1                |
+      | replica_factor | 1                |
+      | vid_type       | FIXED_STRING(20) |
+    And having executed:
+      """
+      CREATE TAG person(name string);
+      CREATE EDGE like(likeness int);
+      """
+    And wait 3 seconds
+    When executing query:
+      """
+      INSERT VERTEX person(name) VALUES "a":("a"), "b":("b"), "c":("c");
+      INSERT EDGE like(likeness) VALUES "a"->"b":(90);
+      """
+    Then the execution should be successful
+    When executing query:
+      """
+      GO FROM "a" OVER like YIELD like._dst AS dst, like.likeness AS likeness
+      """
+    Then the result should be, in any order:
+      | dst | likeness |
+      | "b" | 90       |
+    When executing query:
+      """
+      GO FROM "b" OVER like YIELD like._dst AS dst, like.likeness AS likeness
+      """
+    Then the result should be, in any order:
+      | dst | likeness |
+    # The edge type changes, which the cached plans refer to
+    When executing query:
+      """
+      DROP EDGE like
+      """
+    Then the execution should be successful
+    When executing query:
+      """
+      CREATE EDGE like(likeness int)
+      """
+    Then the execution should be successful
+    And wait 3 seconds
+    When executing query:
+      """
+      INSERT EDGE like(likeness) VALUES "a"->"c":(80);
+      """
+    Then the execution should be successful
+    When executing query:
+      """
+      GO FROM "a" OVER like YIELD like._dst AS dst, like.likeness AS likeness
+      """
+    Then the result should be, in any order:
+      | dst | likeness |
+      | "c" | 80       |
+    Then drop the used space
@@ -233,6 +233,41 @@ Feature: With clause
       | exists(m.abc) | exists(NULL.abc) |
       | NULL          | NULL             |
 
+  Scenario: filter the ordered rows
+    When executing query:
+      """
+      MATCH (v:player)
+      WITH v.age AS age, v.name AS name
+         ORDER BY age DESCENDING, name ASCENDING
+         WHERE age > 38 AND age % 2 == 0
+      RETURN name, age
+      """
+    Then the result should be, in order:
+      | name            | age |
+      | "Grant Hill"    | 46  |
+      | "Tim Duncan"    | 42  |
+      | "Vince Carter"  | 42  |
+      | "Dirk Nowitzki" | 40  |
+      | "Kobe Bryant"   | 40  |
+    When executing query:
+      """
+      MATCH (v:player)
+      WITH v.age AS age, v.name AS name
+         ORDER BY name
+         WHERE age > 40
+      RETURN name
+      """
+    Then the result should be, in order:
+      | name              |
+      | "Grant Hill"      |
+      | "Jason Kidd"      |
+      | "Manu Ginobili"   |
+      | "Ray Allen"       |
+      | "Shaquile O'Neal" |
+      | "Steve Nash"      |
+      | "Tim Duncan"      |
+      | "Vince Carter"    |
+
   Scenario: error check
     When executing query:
       """
@@ -0,0 +1,40 @@
+# Copyright (c) 2021 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License,
+# attached with Common Clause Condition 1.0, found in the LICENSES directory.
+Feature: Push Limit down GetVertices rule
+
+  Background:
+    Given a graph with space named "nba"
+
+  Scenario: push limit down to GetVertices
+    When profiling query:
+      """
+      FETCH PROP ON player "Tim Duncan", "Tony Parker", "Not Exist" YIELD player.name AS name |
+      LIMIT 2
+      """
+    Then the result should be, in any order:
+      | VertexID      | name          |
+      | "Tim Duncan"  | "Tim Duncan"  |
+      | "Tony Parker" | "Tony Parker" |
+    And the execution plan should be:
+      | id | name        | dependencies | operator info  |
+      | 3  | Limit       | 2            |                |
+      | 2  | Project     | 1            |                |
+      | 1  | GetVertices | 0            | {"limit": "2"} |
+      | 0  | Start       |              |                |
+
+  Scenario: push limit down to GetVertices with offset
+    When profiling query:
+      """
+      FETCH PROP ON player "Tim Duncan", "Tony Parker", "Not Exist" YIELD player.name AS name |
+      LIMIT 2, 3
+      """
+    Then the result should be, in any order:
+      | VertexID | name |
+    And the execution plan should be:
+      | id | name        | dependencies | operator info  |
+      | 3  | Limit       | 2            |                |
+      | 2  | Project     | 1            |                |
+      | 1  | GetVertices | 0            | {"limit": "5"} |
+      | 0  | Start       |              |                |
@@ -0,0 +1,116 @@
+# Copyright (c) 2021 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License,
+# attached with Common Clause Condition 1.0, found in the LICENSES directory.
+Feature: Weighted Shortest Path
+
+  Background:
+    Given an empty graph
+    And create a space with following options:
+      | partition_num  | 1                |
+      | replica_factor | 1                |
+      | vid_type       | FIXED_STRING(20) |
+    And having executed:
+      """
+      CREATE EDGE road(cost double, name string);
+      """
+    And wait 3 seconds
+    # The negative weight is in the component of "h" only
+    And having executed:
+      """
+      INSERT EDGE road(cost, name) VALUES
+        "a"->"b":(1.0, "ab"),
+        "b"->"c":(1.0, "bc"),
+        "c"->"d":(1.0, "cd"),
+        "a"->"d":(10.0, "ad"),
+        "a"->"e":(2.0, "ae"),
+        "e"->"d":(1.0, "ed"),
+        "e"->"f":(1.0, "ef"),
+        "b"->"f":(2.0, "bf"),
+        "h"->"i":(-1.0, "hi");
+      """
+
+  Scenario: [1] SinglePair Weighted Shortest Path
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "d" OVER road
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path                   |
+      | <("a")-[:road]->("d")> |
+    # The paths of the same weight and the fewest hops
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "d" OVER road WEIGHT BY cost
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path                                  |
+      | <("a")-[:road]->("e")-[:road]->("d")> |
+    Then drop the used space
+
+  Scenario: [2] Weighted Shortest Path Within Steps
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "d" OVER road UPTO 2 STEPS WEIGHT BY cost
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path                                  |
+      | <("a")-[:road]->("e")-[:road]->("d")> |
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "d" OVER road UPTO 1 STEPS WEIGHT BY cost
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path                   |
+      | <("a")-[:road]->("d")> |
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "c" OVER road UPTO 1 STEPS WEIGHT BY cost
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path |
+    Then drop the used space
+
+  Scenario: [3] MultiPair Weighted Shortest Path
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "c", "f" OVER road WEIGHT BY cost
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path                                  |
+      | <("a")-[:road]->("b")-[:road]->("c")> |
+      | <("a")-[:road]->("b")-[:road]->("f")> |
+      | <("a")-[:road]->("e")-[:road]->("f")> |
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a", "b" TO "d" OVER road WEIGHT BY cost
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path                                  |
+      | <("a")-[:road]->("e")-[:road]->("d")> |
+      | <("b")-[:road]->("c")-[:road]->("d")> |
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "d" TO "a" OVER road WEIGHT BY cost
+      """
+    Then the result should be, in any order, with relax comparison:
+      | path |
+    Then drop the used space
+
+  Scenario: [4] Weighted Shortest Path Errors
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "h" TO "i" OVER road WEIGHT BY cost
+      """
+    Then an ExecutionError should be raised at runtime: The weight `cost' of the edge from
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "d" OVER road WEIGHT BY name
+      """
+    Then a SemanticError should be raised at runtime: The weight `road.name' should be numeric
+    When executing query:
+      """
+      FIND SHORTEST PATH FROM "a" TO "d" OVER road WEIGHT BY price
+      """
+    Then a SemanticError should be raised at runtime: Edge `road' has no property `price'
+    Then drop the used space